@@ -16,11 +16,19 @@
 
 // UnderBudget include(s)
 #include "accounting/ConversionRates.hpp"
+#include "accounting/Currency.hpp"
 
 namespace ub {
 
 //------------------------------------------------------------------------------
 //ConversionRates::~ConversionRates() { }
 
+//------------------------------------------------------------------------------
+double ConversionRates::lookup(const Currency& source,
+	const Currency& target) const
+{
+	return get(source.code(), target.code());
+}
+
 }
 
@@ -17,8 +17,14 @@
 #ifndef CONVERSIONRATES_HPP
 #define CONVERSIONRATES_HPP
 
+// Qt include(s)
+#include <QString>
+
 namespace ub {
 
+// Forward declaration(s)
+class Currency;
+
 /**
  * Currency conversion rate lookup service.
  *
@@ -26,7 +32,8 @@ namespace ub {
  * etc. Although clients may use this service directly, it is not recommended.
  * This rate lookup service is used internally by the `Currency` class to
  * provide automatic conversion when performing arithmetic operations on
- * `Money` objects.
+ * `Money` objects. Rates may be retrieved from several threads at once, so
+ * implementations must be safe to read concurrently.
  *
  * @ingroup accounting
  */
@@ -48,6 +55,20 @@ public:
 	 *         1.0 if no rate is found (no conversion)
 	 */
 	virtual double get(const QString& source, const QString& target) const = 0;
+
+	/**
+	 * Retrieves the conversion rate from the source currency to the target
+	 * currency. This is used for every arithmetic operation on `Money`
+	 * objects of different currencies, so implementations should override
+	 * it to look up rates by interned currency ID. By default, the rate is
+	 * retrieved by ISO 4217 code with `get()`.
+	 *
+	 * @param[in] source source currency
+	 * @param[in] target target currency
+	 * @return conversion rate from source currency to target currency, or
+	 *         1.0 if no rate is found (no conversion)
+	 */
+	virtual double lookup(const Currency& source, const Currency& target) const;
 };
 
 }
@@ -21,18 +21,24 @@
 namespace ub {
 
 //------------------------------------------------------------------------------
-QSharedPointer<ConversionRates> ConversionRatesSource::current =
-	QSharedPointer<ConversionRates>();
+QSharedPointer<ConversionRates>& ConversionRatesSource::current()
+{
+	// Initialization of a local static is synchronized by the compiler,
+	// so the default instance is never created or assigned twice
+	static QSharedPointer<ConversionRates> rates(new NoConversionRates);
+	return rates;
+}
 
 //------------------------------------------------------------------------------
 QSharedPointer<ConversionRates> ConversionRatesSource::factory()
 {
-	if (current.isNull())
-	{
-		set(QSharedPointer<ConversionRates>(new NoConversionRates));
-	}
+	return current();
+}
 
-	return current;
+//------------------------------------------------------------------------------
+const ConversionRates& ConversionRatesSource::instance()
+{
+	return *current();
 }
 
 //------------------------------------------------------------------------------
@@ -44,7 +50,9 @@ void ConversionRatesSource::set(ConversionRates* service)
 //------------------------------------------------------------------------------
 void ConversionRatesSource::set(const QSharedPointer<ConversionRates>& service)
 {
-	current = service;
+	// Without a service, no conversion is performed
+	current() = service.isNull()
+		? QSharedPointer<ConversionRates>(new NoConversionRates) : service;
 }
 
 }
@@ -40,16 +40,28 @@ public:
 	 */
 	static QSharedPointer<ConversionRates> factory();
 
+	/**
+	 * Returns the current conversion rates lookup service, without
+	 * sharing ownership of it. The returned reference is only valid until
+	 * the lookup service is next specified.
+	 *
+	 * @return active `ConversionRates` instance
+	 */
+	static const ConversionRates& instance();
+
 	/**
 	 * Specifies the conversion rates lookup service. Ownership of the
-	 * pointer is transfered to the `ConversionRatesSource` class.
+	 * pointer is transfered to the `ConversionRatesSource` class. This
+	 * must not be called while conversion rates may be retrieved by
+	 * another thread.
 	 *
 	 * @param[in] service active `ConversionRates` instance
 	 */
 	static void set(ConversionRates* service);
 
 	/**
-	 * Specifies the conversion rates lookup service.
+	 * Specifies the conversion rates lookup service. This must not be
+	 * called while conversion rates may be retrieved by another thread.
 	 *
 	 * @param[in] service active `ConversionRates` instance
 	 */
@@ -57,9 +69,13 @@ public:
 
 private:
 	/**
-	 * The current `ConversionRates` instance
+	 * Returns the current `ConversionRates` instance. It is created on
+	 * first use, which is safe even when that first use happens on
+	 * several threads at once.
+	 *
+	 * @return reference to the current instance
 	 */
-	static QSharedPointer<ConversionRates> current;
+	static QSharedPointer<ConversionRates>& current();
 };
 
 }
@@ -24,25 +24,69 @@
 
 namespace ub {
 
+//------------------------------------------------------------------------------
+const quint16 Currency::INVALID_ID = 0xffff;
+
+//------------------------------------------------------------------------------
+// Interned currency codes are stored in fixed-size chunks that are never
+// moved or freed, so that codes can be read by ID without locking
+static const int CHUNK_BITS = 8;
+static const int CHUNK_SIZE = 1 << CHUNK_BITS;
+static const int CHUNK_COUNT = 65536 / CHUNK_SIZE;
+static QAtomicPointer<QString> internedCodes[CHUNK_COUNT];
+static QHash<QString, quint16> internedIds;
+static QReadWriteLock internLock;
+
 //------------------------------------------------------------------------------
 Currency::Currency()
-	: iso4217(byLocale().iso4217)
+	: index(byLocale().index)
 { }
 
 //------------------------------------------------------------------------------
 Currency::Currency(const QString& code)
-	: iso4217(code)
+	: index(intern(code))
 { }
 
 //------------------------------------------------------------------------------
 Currency::Currency(const char* code)
-	: iso4217(code)
+	: index(intern(QString(code)))
 { }
 
 //------------------------------------------------------------------------------
-Currency::Currency(const Currency& orig)
-	: iso4217(orig.iso4217)
-{ }
+quint16 Currency::intern(const QString& code)
+{
+	{
+		QReadLocker lock(&internLock);
+		QHash<QString, quint16>::const_iterator iter = internedIds.find(code);
+		if (iter != internedIds.end())
+			return iter.value();
+	}
+
+	QWriteLocker lock(&internLock);
+	// Check again, in case it was interned while unlocked
+	QHash<QString, quint16>::const_iterator iter = internedIds.find(code);
+	if (iter != internedIds.end())
+		return iter.value();
+
+	// The last ID is reserved to mark currencies that could not be interned
+	int id = internedIds.size();
+	if (id >= INVALID_ID)
+	{
+		qWarning() << "Too many currencies, unable to intern" << code;
+		return INVALID_ID;
+	}
+
+	QString* chunk = internedCodes[id >> CHUNK_BITS].load();
+	if ( ! chunk)
+	{
+		chunk = new QString[CHUNK_SIZE];
+		internedCodes[id >> CHUNK_BITS].storeRelease(chunk);
+	}
+	chunk[id & (CHUNK_SIZE - 1)] = code;
+
+	internedIds.insert(code, id);
+	return id;
+}
 
 //------------------------------------------------------------------------------
 Currency Currency::byLocale(const QLocale& locale)
@@ -51,15 +95,31 @@ Currency Currency::byLocale(const QLocale& locale)
 }
 
 //------------------------------------------------------------------------------
-const QString& Currency::code() const
+bool Currency::isValid() const
+{
+	return (index != INVALID_ID);
+}
+
+//------------------------------------------------------------------------------
+QString Currency::code() const
+{
+	if (index == INVALID_ID)
+		return QString();
+
+	const QString* chunk = internedCodes[index >> CHUNK_BITS].loadAcquire();
+	return chunk[index & (CHUNK_SIZE - 1)];
+}
+
+//------------------------------------------------------------------------------
+quint16 Currency::id() const
 {
-	return iso4217;
+	return index;
 }
 
 //------------------------------------------------------------------------------
 QString Currency::symbol() const
 {
-	return currencySymbol(iso4217);
+	return currencySymbol(code());
 }
 
 //------------------------------------------------------------------------------
@@ -85,8 +145,7 @@ double Currency::conversionRate(const Currency& target) const
 	}
 	else
 	{
-		QSharedPointer<ConversionRates> rates = ConversionRatesSource::factory();
-		return conversionRate(target, *rates);
+		return ConversionRatesSource::instance().lookup(*this, target);
 	}
 }
 
@@ -94,19 +153,19 @@ double Currency::conversionRate(const Currency& target) const
 double Currency::conversionRate(const Currency& target,
 	ConversionRates& rates) const
 {
-	return rates.get(iso4217, target.iso4217);
+	return rates.lookup(*this, target);
 }
 
 //------------------------------------------------------------------------------
 bool Currency::operator==(const Currency& that) const
 {
-	return (iso4217 == that.iso4217);
+	return (index == that.index) && (index != INVALID_ID);
 }
 
 //------------------------------------------------------------------------------
 bool Currency::operator!=(const Currency& that) const
 {
-	return (iso4217 != that.iso4217);
+	return ! (*this == that);
 }
 
 }
@@ -29,11 +29,20 @@ namespace ub {
 /**
  * Model of a single monetary currency.
  *
+ * Currency codes are interned, so that a currency is represented by a small
+ * integer ID. Currencies are trivially copyable and are compared by ID.
+ *
  * @ingroup accounting
  */
 class Currency
 {
 public:
+	/**
+	 * ID of a currency that could not be interned. Such a currency has
+	 * no code and is not equal to any currency, including itself.
+	 */
+	static const quint16 INVALID_ID;
+
 	/**
 	 * Constructs a new currency instance for the default
 	 * currency, based on locale.
@@ -58,13 +67,6 @@ public:
 	 */
 	Currency(const char* code);
 
-	/**
-	 * Constructs a copy of the given currency.
-	 *
-	 * @param[in] orig original currency to be copied
-	 */
-	Currency(const Currency& orig);
-
 	/**
 	 * Retrieves the currency associated with the given locale, or
 	 * the default locale if none is specified.
@@ -74,9 +76,23 @@ public:
 	static Currency byLocale(const QLocale& locale = QLocale());
 
 	/**
-	 * Returns the ISO 4217 code for this currency.
+	 * Checks if this currency was successfully interned.
+	 *
+	 * @return `true` if this currency has a valid ID
 	 */
-	const QString& code() const;
+	bool isValid() const;
+
+	/**
+	 * Returns the ISO 4217 code for this currency, or an empty
+	 * string if this currency is invalid.
+	 */
+	QString code() const;
+
+	/**
+	 * Returns the interned ID of this currency. IDs are only valid
+	 * for the lifetime of the application and are not to be persisted.
+	 */
+	quint16 id() const;
 
 	/**
 	 * Returns the UTF symbol for this currency.
@@ -128,13 +144,26 @@ public:
 
 private:
 	/**
-	 * ISO 4217 currency code
+	 * Interned ID of the ISO 4217 currency code
+	 */
+	quint16 index;
+
+	/**
+	 * Returns the interned ID of the given currency code, assigning
+	 * a new ID if the code has not yet been interned.
+	 *
+	 * @param[in] code ISO 4217 currency code
+	 * @return interned ID of the currency code, or `INVALID_ID` if
+	 *         no more currencies can be interned
 	 */
-	QString iso4217;
+	static quint16 intern(const QString& code);
 };
 
 }
 
+// Currency can be moved in memory with memcpy
+Q_DECLARE_TYPEINFO(ub::Currency, Q_MOVABLE_TYPE);
+
 // Make Currency known to QMetaType
 Q_DECLARE_METATYPE(ub::Currency)
 
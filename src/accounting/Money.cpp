@@ -16,6 +16,11 @@
 
 // std include(s)
 #include <cmath>
+#include <cstring>
+#include <limits>
+
+// Qt include(s)
+#include <QtCore>
 
 // UnderBudget include(s)
 #include "Money.hpp"
@@ -23,21 +28,372 @@
 namespace ub {
 
 //------------------------------------------------------------------------------
-Money::Money(double amount, const Currency& currency)
-	: scaledAmount(scale(amount)), currencyUnit(currency)
-{ }
+/**
+ * Unsigned 128-bit integer, used for exact intermediate results.
+ */
+struct Wide
+{
+	/** Most significant 64 bits */
+	quint64 high;
+	/** Least significant 64 bits */
+	quint64 low;
+};
+
+//------------------------------------------------------------------------------
+static Wide multiplyWide(quint64 a, quint64 b)
+{
+	Wide product;
+
+	// Common case, when both operands fit within 32 bits
+	if (((a | b) >> 32) == 0)
+	{
+		product.high = 0;
+		product.low = a * b;
+		return product;
+	}
+
+#ifdef __SIZEOF_INT128__
+	unsigned __int128 wide = (unsigned __int128) a * b;
+	product.high = (quint64) (wide >> 64);
+	product.low = (quint64) wide;
+#else
+	quint64 aLow = a & 0xffffffffULL;
+	quint64 aHigh = a >> 32;
+	quint64 bLow = b & 0xffffffffULL;
+	quint64 bHigh = b >> 32;
+
+	quint64 lowLow = aLow * bLow;
+	quint64 lowHigh = aLow * bHigh;
+	quint64 highLow = aHigh * bLow;
+	quint64 highHigh = aHigh * bHigh;
+
+	quint64 middle = (lowLow >> 32) + (lowHigh & 0xffffffffULL)
+		+ (highLow & 0xffffffffULL);
+
+	product.low = (middle << 32) | (lowLow & 0xffffffffULL);
+	product.high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+#endif
+	return product;
+}
+
+//------------------------------------------------------------------------------
+static Wide divideWide(const Wide& dividend, quint64 divisor,
+	quint64& remainder)
+{
+	Wide quotient = { 0, 0 };
+
+	// Integer factors need no division at all
+	if (divisor == 1)
+	{
+		remainder = 0;
+		return dividend;
+	}
+
+	// Common case, when the intermediate result fits within 64 bits
+	if (dividend.high == 0)
+	{
+		quotient.low = dividend.low / divisor;
+		remainder = dividend.low % divisor;
+		return quotient;
+	}
+
+#ifdef __SIZEOF_INT128__
+	unsigned __int128 wide = ((unsigned __int128) dividend.high << 64)
+		| dividend.low;
+	unsigned __int128 result = wide / divisor;
+	remainder = (quint64) (wide % divisor);
+	quotient.high = (quint64) (result >> 64);
+	quotient.low = (quint64) result;
+#else
+	// Binary long division, the divisor is always less than 2^63
+	// so the remainder can be shifted without overflow
+	remainder = 0;
+	for (int i=127; i>=0; --i)
+	{
+		quint64 bit = (i >= 64) ? (dividend.high >> (i - 64)) & 1
+			: (dividend.low >> i) & 1;
+		remainder = (remainder << 1) | bit;
+
+		if (remainder >= divisor)
+		{
+			remainder -= divisor;
+			if (i >= 64)
+				quotient.high |= (1ULL << (i - 64));
+			else
+				quotient.low |= (1ULL << i);
+		}
+	}
+#endif
+
+	return quotient;
+}
+
+//------------------------------------------------------------------------------
+static bool toDecimal(double value, quint64& numerator, quint64& denominator)
+{
+	// Largest magnitude for which every integer is exactly representable
+	static const double EXACT_LIMIT = 9007199254740992.0; // 2^53
+	static const double MAXIMUM = 9223372036854775808.0; // 2^63
+
+	// Reject NaN and infinity
+	if ( ! (value >= 0.0) || (value > MAXIMUM))
+		return false;
+
+	// Integers, which includes most scalar factors and divisors, need
+	// no search for their decimal places
+	if (value < EXACT_LIMIT)
+	{
+		numerator = (quint64) value;
+		if ((double) numerator == value)
+		{
+			denominator = 1;
+			return true;
+		}
+	}
+
+	// Conversions tend to repeat the same rate, so each thread remembers
+	// the decimal places of the most recent value it had to search for
+	static thread_local double lastValue = -1.0;
+	static thread_local quint64 lastNumerator = 0;
+	static thread_local quint64 lastDenominator = 1;
+	if (value == lastValue)
+	{
+		numerator = lastNumerator;
+		denominator = lastDenominator;
+		return true;
+	}
+
+	bool found = false;
+	double power = 1.0;
+	quint64 scale = 1;
+
+	// Find the fewest decimal places with which the value can be written,
+	// so that a rate of 0.3 is treated as 3/10 rather than as the nearest
+	// binary fraction
+	for (int places=0; places<=15; ++places)
+	{
+		double scaled = value * power;
+		if (scaled >= EXACT_LIMIT)
+			break;
+
+		numerator = (quint64) (scaled + 0.5);
+		double nearest = (double) numerator;
+		denominator = scale;
+		found = true;
+
+		if (std::fabs(scaled - nearest)
+			<= scaled * 4 * std::numeric_limits<double>::epsilon())
+			break;
+
+		power *= 10.0;
+		scale *= 10;
+	}
+
+	if ( ! found)
+	{
+		// Too large to have any fractional digits
+		if (value >= MAXIMUM)
+			return false;
+
+		numerator = (quint64) value;
+		denominator = 1;
+	}
+
+	lastValue = value;
+	lastNumerator = numerator;
+	lastDenominator = denominator;
+	return true;
+}
+
+//------------------------------------------------------------------------------
+static qint64 saturate(bool negative)
+{
+	qWarning() << "Money amount overflow";
+	return negative ? -std::numeric_limits<qint64>::max()
+		: std::numeric_limits<qint64>::max();
+}
+
+//------------------------------------------------------------------------------
+static qint64 scaleBy(qint64 value, quint64 numerator, quint64 denominator,
+	bool negativeFactor, Money::Rounding rounding)
+{
+	bool negative = (value < 0) != negativeFactor;
+	quint64 magnitude = (value < 0) ? 0 - (quint64) value : (quint64) value;
+
+	quint64 remainder;
+	Wide quotient = divideWide(multiplyWide(magnitude, numerator),
+		denominator, remainder);
+
+	if (remainder != 0)
+	{
+		bool up = false;
+		quint64 rest = denominator - remainder;
+		switch (rounding)
+		{
+		case Money::Floor:
+			up = negative;
+			break;
+		case Money::Ceiling:
+			up = ! negative;
+			break;
+		case Money::HalfAwayFromZero:
+			up = (remainder >= rest);
+			break;
+		case Money::HalfEven:
+			up = (remainder > rest) || ((remainder == rest) && (quotient.low & 1));
+			break;
+		case Money::TowardZero:
+		default:
+			break;
+		}
+
+		if (up && (++quotient.low == 0))
+		{
+			++quotient.high;
+		}
+	}
+
+	if (quotient.high != 0
+		|| quotient.low > (quint64) std::numeric_limits<qint64>::max())
+		return saturate(negative);
+
+	qint64 result = (qint64) quotient.low;
+	return negative ? -result : result;
+}
 
 //------------------------------------------------------------------------------
-Money::Money(const Money& orig)
-	: scaledAmount(orig.scaledAmount), currencyUnit(orig.currencyUnit)
+static bool roundNearest(double value, double error, Money::Rounding rounding,
+	qint64& result)
+{
+	qint64 whole = (qint64) value;
+	double fraction = std::fabs(value - (double) whole);
+	qint64 step = (value < 0) ? -1 : 1;
+
+	// A value within the error of a rounding boundary could round either
+	// way, unless it is known to be exact
+	if ((rounding == Money::HalfAwayFromZero) || (rounding == Money::HalfEven))
+	{
+		double tie = fraction - 0.5;
+		if (std::fabs(tie) <= error)
+		{
+			if ((error > 0.0) || (tie != 0.0))
+				return false;
+			bool away = (rounding == Money::HalfAwayFromZero) || (whole & 1);
+			result = away ? whole + step : whole;
+			return true;
+		}
+		result = whole + step * (tie > 0.0);
+		return true;
+	}
+
+	if ((fraction <= error) || (1.0 - fraction <= error))
+	{
+		if ((error > 0.0) || (fraction != 0.0))
+			return false;
+		result = whole;
+		return true;
+	}
+
+	if (rounding == Money::Floor)
+		result = whole - (value < 0);
+	else if (rounding == Money::Ceiling)
+		result = whole + (value > 0);
+	else
+		result = whole;
+	return true;
+}
+
+//------------------------------------------------------------------------------
+static bool scaleQuickly(qint64 value, double factor, bool divide,
+	Money::Rounding rounding, qint64& result)
+{
+	static const double EXACT_LIMIT = 9007199254740992.0; // 2^53
+	static const double EPSILON = std::numeric_limits<double>::epsilon();
+
+	// Zero and invalid factors are left to the exact path and its warnings
+	if (value == 0)
+		return false;
+
+	// Powers of two and integers are exactly the decimal that toDecimal()
+	// finds, so only the rounding of the result itself can be in error
+	double magnitude = std::fabs(factor);
+	quint64 bits;
+	memcpy(&bits, &magnitude, sizeof(bits));
+	int exponent = int(bits >> 52) - 1023;
+	bool powerOfTwo = ((bits & ((1ULL << 52) - 1)) == 0)
+		&& (exponent >= -15) && (exponent < 53);
+	bool exact = powerOfTwo || ((magnitude >= 1.0)
+		&& (magnitude < EXACT_LIMIT)
+		&& (magnitude == (double) (qint64) magnitude));
+
+	// Otherwise the error bound also covers the difference between the
+	// factor and that decimal
+	double amount = (double) value;
+	double scaled;
+	double error;
+	if (divide)
+	{
+		if (exact)
+		{
+			scaled = amount / factor;
+			error = powerOfTwo ? 0.0 : std::fabs(scaled) * EPSILON;
+		}
+		else
+		{
+			double inverse = 1.0 / factor;
+			scaled = amount * inverse;
+			error = std::fabs(scaled)
+				* (10 * EPSILON + 1e-15 * std::fabs(inverse));
+		}
+	}
+	else
+	{
+		scaled = amount * factor;
+		error = exact ? 0.0
+			: std::fabs(scaled) * 10 * EPSILON + std::fabs(amount) * 1e-15;
+	}
+
+	if ( ! (std::fabs(scaled) < EXACT_LIMIT / 2) || ! (error < 0.25)
+		|| ! (std::fabs(amount) <= EXACT_LIMIT))
+		return false;
+	return roundNearest(scaled, error, rounding, result);
+}
+
+//------------------------------------------------------------------------------
+static qint64 addScaled(qint64 lhs, qint64 rhs)
+{
+	static const qint64 MAXIMUM = std::numeric_limits<qint64>::max();
+
+	if ((rhs > 0) && (lhs > MAXIMUM - rhs))
+		return saturate(false);
+	if ((rhs < 0) && (lhs < -MAXIMUM - rhs))
+		return saturate(true);
+	return lhs + rhs;
+}
+
+//------------------------------------------------------------------------------
+static qint64 subtractScaled(qint64 lhs, qint64 rhs)
+{
+	static const qint64 MAXIMUM = std::numeric_limits<qint64>::max();
+
+	if ((rhs < 0) && (lhs > MAXIMUM + rhs))
+		return saturate(false);
+	if ((rhs > 0) && (lhs < -MAXIMUM + rhs))
+		return saturate(true);
+	return lhs - rhs;
+}
+
+//------------------------------------------------------------------------------
+Money::Money(double amount, const Currency& currency)
+	: scaledAmount(scale(amount)), currencyUnit(currency)
 { }
 
 //------------------------------------------------------------------------------
-Money& Money::operator=(const Money& other)
+Money Money::fromScaled(qint64 scaled, const Currency& currency)
 {
-	scaledAmount = other.scaledAmount;
-	currencyUnit = other.currencyUnit;
-	return *this;
+	Money money(0.0, currency);
+	money.scaledAmount = scaled;
+	return money;
 }
 
 //------------------------------------------------------------------------------
@@ -52,6 +408,12 @@ double Money::amount() const
 	return humanize(scaledAmount);
 }
 
+//------------------------------------------------------------------------------
+qint64 Money::scaled() const
+{
+	return scaledAmount;
+}
+
 //------------------------------------------------------------------------------
 const Currency& Money::currency() const
 {
@@ -59,19 +421,33 @@ const Currency& Money::currency() const
 }
 
 //------------------------------------------------------------------------------
-Money Money::to(const Currency& target) const
+Money Money::to(const Currency& target, Rounding rounding) const
 {
-	double rate = currencyUnit.conversionRate(target);
-	Money converted;
-	converted.scaledAmount = scaledAmount * rate;
-	converted.currencyUnit = target;
+	Money converted(0.0, target);
+	converted.scaledAmount = converted.convert(*this, rounding);
 	return converted;
 }
 
 //------------------------------------------------------------------------------
-Money Money::toLocal() const
+Money Money::toLocal(Rounding rounding) const
 {
-	return to(Currency());
+	return to(Currency(), rounding);
+}
+
+//------------------------------------------------------------------------------
+Money Money::multipliedBy(double factor, Rounding rounding) const
+{
+	Money product(0.0, currencyUnit);
+	product.scaledAmount = multiply(scaledAmount, factor, rounding);
+	return product;
+}
+
+//------------------------------------------------------------------------------
+Money Money::dividedBy(double divisor, Rounding rounding) const
+{
+	Money quotient(0.0, currencyUnit);
+	quotient.scaledAmount = divide(scaledAmount, divisor, rounding);
+	return quotient;
 }
 
 //------------------------------------------------------------------------------
@@ -89,33 +465,29 @@ bool Money::isNegative() const
 //------------------------------------------------------------------------------
 const Money Money::operator-() const
 {
-	Money negated;
+	Money negated(0.0, currencyUnit);
 	negated.scaledAmount = - scaledAmount;
-	negated.currencyUnit = currencyUnit;
 	return negated;
 }
 
 //------------------------------------------------------------------------------
 const Money& Money::operator+=(const Money& addend)
 {
-	scaledAmount += convert(addend);
+	scaledAmount = addScaled(scaledAmount, convert(addend));
 	return *this;
 }
 
 //------------------------------------------------------------------------------
 const Money& Money::operator-=(const Money& subtrahend)
 {
-	scaledAmount -= convert(subtrahend);
+	scaledAmount = subtractScaled(scaledAmount, convert(subtrahend));
 	return *this;
 }
 
 //------------------------------------------------------------------------------
 const Money Money::operator*(double factor) const
 {
-	Money product;
-	product.scaledAmount = scaledAmount * factor;
-	product.currencyUnit = currencyUnit;
-	return product;
+	return multipliedBy(factor, TowardZero);
 }
 
 //------------------------------------------------------------------------------
@@ -127,27 +499,79 @@ const double Money::operator/(const Money& divisor) const
 //------------------------------------------------------------------------------
 const Money Money::operator/(double divisor) const
 {
-	Money quotient;
-	quotient.scaledAmount = (double) scaledAmount / divisor;
-	quotient.currencyUnit = currencyUnit;
-	return quotient;
+	return dividedBy(divisor, TowardZero);
 }
 
 //------------------------------------------------------------------------------
-int Money::convert(const Money& other) const
+qint64 Money::convert(const Money& other, Rounding rounding) const
 {
+	// No conversion necessary
+	if (other.currencyUnit == currencyUnit)
+		return other.scaledAmount;
+
 	double rate = other.currencyUnit.conversionRate(currencyUnit);
-	return other.scaledAmount * rate;
+	return multiply(other.scaledAmount, rate, rounding);
+}
+
+//------------------------------------------------------------------------------
+qint64 Money::multiply(qint64 value, double factor, Rounding rounding)
+{
+	// Most products are far enough from a rounding boundary that double
+	// arithmetic gives the exact result
+	qint64 result;
+	if (scaleQuickly(value, factor, false, rounding, result))
+		return result;
+
+	quint64 numerator;
+	quint64 denominator;
+	if ( ! toDecimal(std::fabs(factor), numerator, denominator))
+	{
+		qWarning() << "Invalid money factor" << factor;
+		return 0;
+	}
+
+	return scaleBy(value, numerator, denominator, (factor < 0), rounding);
+}
+
+//------------------------------------------------------------------------------
+qint64 Money::divide(qint64 value, double divisor, Rounding rounding)
+{
+	qint64 result;
+	if (scaleQuickly(value, divisor, true, rounding, result))
+		return result;
+
+	quint64 numerator;
+	quint64 denominator;
+	if ( ! toDecimal(std::fabs(divisor), numerator, denominator)
+		|| (numerator == 0))
+	{
+		qWarning() << "Invalid money divisor" << divisor;
+		return 0;
+	}
+
+	// Dividing by n/d is multiplying by d/n
+	return scaleBy(value, denominator, numerator, (divisor < 0), rounding);
 }
 
 //------------------------------------------------------------------------------
-int Money::scale(double value)
+qint64 Money::scale(double value)
 {
-	return round(value * 10000);
+	// Smallest magnitude that llround() cannot return
+	static const double LIMIT = 9223372036854775808.0; // 2^63
+
+	double scaled = value * 10000;
+	if (scaled != scaled)
+	{
+		qWarning() << "Invalid money amount" << value;
+		return 0;
+	}
+	if ((scaled >= LIMIT) || (scaled <= -LIMIT))
+		return saturate(scaled < 0);
+	return llround(scaled);
 }
 
 //------------------------------------------------------------------------------
-double Money::humanize(int value)
+double Money::humanize(qint64 value)
 {
 	return (double) value / 10000;
 }
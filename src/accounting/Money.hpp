@@ -18,7 +18,8 @@
 #define MONEY_HPP
 
 // Qt include(s)
-#include <QObject>
+#include <QDataStream>
+#include <QMetaType>
 
 // UnderBudget include(s)
 #include "accounting/Currency.hpp"
@@ -66,13 +67,42 @@ namespace ub {
  * operation is used within UnderBudget as a fuzzy percentage calculation,
  * rather than an exact, accurate mathematical operation.
  *
+ * Amounts are stored as 64-bit fixed-point values with 4 decimal digits.
+ * Multiplication, division by a scalar, and currency conversion interpret
+ * the scalar (or conversion rate) as the decimal value it was written as,
+ * and compute the exact product with a 128-bit intermediate before rounding
+ * it according to an explicit rounding mode. The arithmetic operators
+ * discard excess digits (i.e., round toward zero). Any result that does
+ * not fit within 64 bits, including sums and differences, saturates at the
+ * largest representable magnitude.
+ *
+ * Money is a plain value type, consisting of only a scaled amount and an
+ * interned currency ID. It is trivially copyable, so it can be stored in
+ * containers and copied without any heap allocation.
+ *
  * @ingroup accounting
  */
-class Money : public QObject
+class Money
 {
-	Q_OBJECT
-
 public:
+	/**
+	 * Rounding modes, used when the exact result of an operation has more
+	 * decimal digits than can be stored in a money value.
+	 */
+	enum Rounding
+	{
+		/** Discards the excess digits */
+		TowardZero,
+		/** Rounds toward negative infinity */
+		Floor,
+		/** Rounds toward positive infinity */
+		Ceiling,
+		/** Rounds to the nearest value, with halves rounded away from zero */
+		HalfAwayFromZero,
+		/** Rounds to the nearest value, with halves rounded to the even value */
+		HalfEven
+	};
+
 	/**
 	 * Constructs a money value of the given amount in the
 	 * given currency.
@@ -83,18 +113,15 @@ public:
 	Money(double amount = 0.0, const Currency& currency = Currency());
 
 	/**
-	 * Constructs a money value as a copy of the given money value.
-	 *
-	 * @param[in] orig money value to be copied
-	 */
-	Money(const Money& orig);
-
-	/**
-	 * Assigns the given money value to this money value.
+	 * Creates a money value from the given scaled amount, as returned
+	 * by `scaled()`, in the given currency. No precision is lost, so
+	 * this is suitable for restoring stored money values.
 	 *
-	 * @param[in] other new money value
+	 * @param[in] scaled   scaled monetary amount
+	 * @param[in] currency monetary currency
+	 * @return money value of the scaled amount
 	 */
-	Money& operator=(const Money& other);
+	static Money fromScaled(qint64 scaled, const Currency& currency = Currency());
 
 	/**
 	 * Creates a string representation of this money value.
@@ -110,6 +137,15 @@ public:
 	 */
 	double amount() const;
 
+	/**
+	 * Returns the exact amount of this money value as a fixed-point
+	 * integer with 4 decimal digits (e.g., 12.34 is returned as 123400).
+	 * Unlike `amount()`, no precision is lost for large amounts.
+	 *
+	 * @return scaled amount of this money value
+	 */
+	qint64 scaled() const;
+
 	/**
 	 * Returns the currency of this money value.
 	 *
@@ -121,18 +157,40 @@ public:
 	 * Returns a money value representing this money value
 	 * in the given currency.
 	 *
-	 * @param[in] target target currency
+	 * @param[in] target   target currency
+	 * @param[in] rounding rounding mode for the converted amount
 	 * @return this money value converted to the target currency
 	 */
-	Money to(const Currency& target) const;
+	Money to(const Currency& target, Rounding rounding = TowardZero) const;
 
 	/**
 	 * Returns a money value representing this money value
 	 * in the current locale's currency.
 	 *
+	 * @param[in] rounding rounding mode for the converted amount
 	 * @return this money value converted to the locale's currency
 	 */
-	Money toLocal() const;
+	Money toLocal(Rounding rounding = TowardZero) const;
+
+	/**
+	 * Creates a money value representing the product of this
+	 * money value and the given scalar factor.
+	 *
+	 * @param[in] factor   scalar factor
+	 * @param[in] rounding rounding mode for the product
+	 * @return product of this money value and the scalar value
+	 */
+	Money multipliedBy(double factor, Rounding rounding) const;
+
+	/**
+	 * Creates a money value representing a portion of this money value
+	 * as a result of dividing by the given scalar divisor.
+	 *
+	 * @param[in] divisor  scalar value to divide into this money value
+	 * @param[in] rounding rounding mode for the quotient
+	 * @return result of this money value divided by the given scalar
+	 */
+	Money dividedBy(double divisor, Rounding rounding) const;
 
 	/**
 	 * Checks if this money value is equal in value to zero.
@@ -267,7 +325,7 @@ public:
 
 private:
 	/** Scaled amount of money represented by this value */
-	int scaledAmount;
+	qint64 scaledAmount;
 	/** Currency of this money value */
 	Currency currencyUnit;
 
@@ -275,21 +333,43 @@ private:
 	 * Converts the scaled amount of the given money value
 	 * to a scaled amount in this money value's currency.
 	 *
-	 * @param[in] other other money value to be converted
+	 * @param[in] other    other money value to be converted
+	 * @param[in] rounding rounding mode for the converted amount
 	 * @return scaled amount of other money value in this value's currency
 	 */
-	int convert(const Money& other) const;
+	qint64 convert(const Money& other, Rounding rounding = TowardZero) const;
+
+	/**
+	 * Multiplies the given scaled amount by the given scalar factor.
+	 *
+	 * @param[in] value    scaled monetary amount
+	 * @param[in] factor   scalar factor
+	 * @param[in] rounding rounding mode for the product
+	 * @return scaled product
+	 */
+	static qint64 multiply(qint64 value, double factor, Rounding rounding);
+
+	/**
+	 * Divides the given scaled amount by the given scalar divisor.
+	 *
+	 * @param[in] value    scaled monetary amount
+	 * @param[in] divisor  scalar divisor
+	 * @param[in] rounding rounding mode for the quotient
+	 * @return scaled quotient
+	 */
+	static qint64 divide(qint64 value, double divisor, Rounding rounding);
 
 	/**
 	 * Scales the given value by a constant factor to ensure that
 	 * precision is not lost. Additionally, excess digits are
 	 * stripped away. A total of 4 decimal digits are preserved.
-	 * For example, the value 12.34 is stored as 123400.
+	 * For example, the value 12.34 is stored as 123400. Values too
+	 * large to be represented are clamped, and NaN is treated as 0.
 	 *
 	 * @param[in] value original, unscaled monetary amount
 	 * @return scaled monetary amount
 	 */
-	static int scale(double value);
+	static qint64 scale(double value);
 
 	/**
 	 * De-scales the given value by a constant factor back to
@@ -298,7 +378,7 @@ private:
 	 * @param[in] value scaled monetary amount
 	 * @return unscaled monetary amount
 	 */
-	static double humanize(int value);
+	static double humanize(qint64 value);
 };
 
 /**
@@ -339,6 +419,9 @@ QDataStream& operator<<(QDataStream& os, const Money& money);
 
 }
 
+// Money can be moved in memory with memcpy
+Q_DECLARE_TYPEINFO(ub::Money, Q_MOVABLE_TYPE);
+
 // Make Money known to QMetaType
 Q_DECLARE_METATYPE(ub::Money)
 
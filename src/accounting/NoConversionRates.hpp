@@ -46,6 +46,18 @@ public:
 	{
 		return 1.0;
 	}
+
+	/**
+	 * Returns 1.0 regardless of given parameters.
+	 *
+	 * @param[in] source source currency
+	 * @param[in] target target currency
+	 * @return 1.0 for all given parameters
+	 */
+	double lookup(const Currency& source, const Currency& target) const
+	{
+		return 1.0;
+	}
 };
 
 }
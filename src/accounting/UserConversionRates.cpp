@@ -36,8 +36,23 @@ const QString UserConversionRates::insertConversionQuery =
 	"VALUES(:source, :target, :rate);";
 const QString UserConversionRates::removeConversionQuery =
 	"DELETE FROM rates WHERE source=:source AND target=:target;";
-const QString UserConversionRates::retrieveConversionQuery =
-	"SELECT rate FROM rates WHERE source=:source AND target=:target;";
+const QString UserConversionRates::retrieveAllConversionsQuery =
+	"SELECT source, target, rate FROM rates;";
+QAtomicPointer<const UserConversionRates::RateTable>
+	UserConversionRates::table(0);
+QList<const UserConversionRates::RateTable*> UserConversionRates::retired;
+
+//------------------------------------------------------------------------------
+struct UserConversionRates::RateTable
+{
+	/** One more than the highest interned ID of any known currency */
+	int size;
+	/** Conversion rates, by source ID * size + target ID */
+	QVector<double> rates;
+};
+
+//------------------------------------------------------------------------------
+static QMutex reloadMutex;
 
 //------------------------------------------------------------------------------
 void UserConversionRates::open(const QString& filename)
@@ -85,6 +100,62 @@ void UserConversionRates::open(const QString& filename)
 			}
 		}
 	}
+
+	reload();
+}
+
+//------------------------------------------------------------------------------
+void UserConversionRates::reload()
+{
+	QMutexLocker lock(&reloadMutex);
+
+	RateTable* loaded = new RateTable;
+	loaded->size = 0;
+	QList<int> sources;
+	QList<int> targets;
+	QList<double> values;
+
+	QSqlDatabase db = QSqlDatabase::database(connection, false);
+	if (db.isOpen())
+	{
+		QSqlQuery retrieveQuery(retrieveAllConversionsQuery, db);
+		retrieveQuery.exec();
+
+		if (retrieveQuery.lastError().isValid())
+		{
+			qWarning() << retrieveQuery.lastError();
+		}
+
+		while (retrieveQuery.next())
+		{
+			Currency sourceCurrency(retrieveQuery.value(0).toString());
+			Currency targetCurrency(retrieveQuery.value(1).toString());
+			if ( ! sourceCurrency.isValid() || ! targetCurrency.isValid())
+				continue;
+
+			int source = sourceCurrency.id();
+			int target = targetCurrency.id();
+			loaded->size = qMax(loaded->size, qMax(source, target) + 1);
+
+			sources.append(source);
+			targets.append(target);
+			values.append(retrieveQuery.value(2).toDouble());
+		}
+	}
+
+	// Pairs without a rate are marked as NaN
+	loaded->rates.fill(qQNaN(), loaded->size * loaded->size);
+	for (int i=0; i<values.size(); ++i)
+	{
+		loaded->rates[sources.at(i) * loaded->size + targets.at(i)] =
+			values.at(i);
+	}
+
+	const RateTable* previous = table.fetchAndStoreOrdered(loaded);
+	if (previous)
+	{
+		retired.append(previous);
+	}
 }
 
 //------------------------------------------------------------------------------
@@ -102,6 +173,10 @@ void UserConversionRates::add(const QString& source, const QString& target,
 	{
 		qWarning() << insertQuery.lastError();
 	}
+	else
+	{
+		reload();
+	}
 }
 
 //------------------------------------------------------------------------------
@@ -117,6 +192,10 @@ void UserConversionRates::remove(const QString& source, const QString& target)
 	{
 		qWarning() << removeQuery.lastError();
 	}
+	else
+	{
+		reload();
+	}
 }
 
 //------------------------------------------------------------------------------
@@ -128,20 +207,35 @@ double UserConversionRates::get(const QString& source, const QString& target) co
 		return 1.0;
 	}
 
-	QSqlQuery retrieveQuery(QSqlDatabase::database(connection));
-	retrieveQuery.prepare(retrieveConversionQuery);
-	retrieveQuery.bindValue(":source", source);
-	retrieveQuery.bindValue(":target", target);
-	retrieveQuery.exec();
+	return lookup(Currency(source), Currency(target));
+}
 
-	if (retrieveQuery.next())
+//------------------------------------------------------------------------------
+double UserConversionRates::lookup(const Currency& source,
+	const Currency& target) const
+{
+	// If no conversion necessary
+	if (source == target)
 	{
-		return retrieveQuery.value(0).toDouble();
+		return 1.0;
 	}
-	else
+
+	const RateTable* current = table.loadAcquire();
+	if ( ! current)
 	{
 		return 1.0;
 	}
+
+	// Currencies interned since the table was loaded have no rates
+	int from = source.id();
+	int to = target.id();
+	if (from >= current->size || to >= current->size)
+	{
+		return 1.0;
+	}
+
+	double rate = current->rates.at(from * current->size + to);
+	return qIsNaN(rate) ? 1.0 : rate;
 }
 
 }
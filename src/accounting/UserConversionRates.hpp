@@ -18,11 +18,14 @@
 #define USERCONVERSIONRATES_HPP
 
 // Qt include(s)
+#include <QAtomicPointer>
+#include <QList>
 #include <QSqlDatabase>
 #include <QSqlQuery>
 
 // UnderBudget include(s)
 #include "accounting/ConversionRates.hpp"
+#include "accounting/Currency.hpp"
 
 namespace ub {
 
@@ -32,6 +35,15 @@ namespace ub {
  * database must have already been opened by a call to `open(QString)` in
  * order to be effective.
  *
+ * Since conversion rates are retrieved for every arithmetic operation on
+ * `Money` objects of different currencies, the database is not queried
+ * when retrieving rates. Instead, all rates are loaded into an in-memory
+ * table whenever the database is opened or modified. Rates are stored in a
+ * matrix indexed by the interned IDs of the source and target currencies,
+ * so no currency codes are compared when retrieving rates. The table is
+ * never modified once published, so it can be read from any thread without
+ * locking.
+ *
  * @ingroup accounting
  */
 class UserConversionRates : public ConversionRates
@@ -77,7 +89,39 @@ public:
 	 */
 	double get(const QString& source, const QString& target) const;
 
+	/**
+	 * Retrieves the conversion rate for the specified source and target
+	 * currencies. If no rate is found, a conversion rate of 1 (no change)
+	 * is returned.
+	 *
+	 * @param[in] source source currency
+	 * @param[in] target target currency
+	 * @return conversion rate from source currency to target currency, or
+	 *         1.0 if no rate is found (no conversion)
+	 */
+	double lookup(const Currency& source, const Currency& target) const;
+
 private:
+	// Forward declaration(s)
+	struct RateTable;
+
+	/**
+	 * Current in-memory table of conversion rates
+	 */
+	static QAtomicPointer<const RateTable> table;
+
+	/**
+	 * Tables that have been replaced. They may still be in use by other
+	 * threads, so they are retained rather than deleted. Tables are only
+	 * replaced when the conversion rates are modified, so few are retired.
+	 */
+	static QList<const RateTable*> retired;
+
+	/**
+	 * Re-loads the in-memory table of conversion rates from the database.
+	 */
+	static void reload();
+
 	/**
 	 * Database connection name
 	 */
@@ -104,9 +148,9 @@ private:
 	static const QString removeConversionQuery;
 
 	/**
-	 * SQL query to retrieve a conversion rate pair
+	 * SQL query to retrieve all conversion rate pairs
 	 */
-	static const QString retrieveConversionQuery;
+	static const QString retrieveAllConversionsQuery;
 };
 
 }
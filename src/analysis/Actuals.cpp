@@ -24,11 +24,38 @@ Actuals::Actuals(QObject* parent)
 	: QObject(parent)
 { }
 
+//------------------------------------------------------------------------------
+void Actuals::beginBatch()
+{
+	batch.begin();
+}
+
+//------------------------------------------------------------------------------
+void Actuals::endBatch()
+{
+	if (batch.end())
+	{
+		emit estimatesChanged(batch.takeIds());
+		emit actualsChanged();
+	}
+}
+
+//------------------------------------------------------------------------------
+void Actuals::changed(const QSet<uint>& estimateIds)
+{
+	if ( ! batch.defer(estimateIds))
+	{
+		emit estimatesChanged(estimateIds.toList());
+		emit actualsChanged();
+	}
+}
+
 //------------------------------------------------------------------------------
 void Actuals::clear()
 {
+	QSet<uint> estimateIds = actuals.keys().toSet();
 	actuals.clear();
-	emit actualsChanged();
+	changed(estimateIds);
 }
 
 //------------------------------------------------------------------------------
@@ -46,7 +73,36 @@ void Actuals::record(uint estId, const Money& amount)
 		actuals[estId] = amount;
 	}
 
-	emit actualsChanged();
+	changed(QSet<uint>() << estId);
+}
+
+//------------------------------------------------------------------------------
+void Actuals::replace(const QHash<uint, Money>& amounts)
+{
+	QSet<uint> estimateIds = actuals.keys().toSet();
+	estimateIds.unite(amounts.keys().toSet());
+	actuals = amounts;
+	changed(estimateIds);
+}
+
+//------------------------------------------------------------------------------
+void Actuals::adjust(const QHash<uint, Money>& deltas)
+{
+	QHashIterator<uint, Money> iter(deltas);
+	while (iter.hasNext())
+	{
+		iter.next();
+		if (actuals.contains(iter.key()))
+		{
+			actuals[iter.key()] += iter.value();
+		}
+		else
+		{
+			actuals[iter.key()] = iter.value();
+		}
+	}
+
+	changed(deltas.keys().toSet());
 }
 
 //------------------------------------------------------------------------------
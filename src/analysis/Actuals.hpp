@@ -19,10 +19,13 @@
 
 // Qt include(s)
 #include <QHash>
+#include <QList>
 #include <QObject>
+#include <QSet>
 
 // UnderBudget include(s)
 #include "accounting/Money.hpp"
+#include "analysis/BatchedChanges.hpp"
 
 namespace ub {
 
@@ -43,6 +46,21 @@ public:
 	 */
 	Actuals(QObject* parent = 0);
 
+	/**
+	 * Opens a batch of modifications. Until the batch is closed, no
+	 * change notifications are emitted for individual modifications.
+	 *
+	 * @sa ChangeBatch
+	 */
+	void beginBatch();
+
+	/**
+	 * Closes a batch of modifications. If anything was modified during
+	 * the outermost batch, a single aggregated change notification is
+	 * emitted.
+	 */
+	void endBatch();
+
 	/**
 	 * Clears all previous recordings.
 	 */
@@ -57,6 +75,22 @@ public:
 	 */
 	void record(uint estId, const Money& amount);
 
+	/**
+	 * Replaces all previous recordings with the given actual amounts,
+	 * with a single change notification.
+	 *
+	 * @param[in] amounts actual amounts, by estimate ID
+	 */
+	void replace(const QHash<uint, Money>& amounts);
+
+	/**
+	 * Adjusts the actual amounts of the specified estimates by the given
+	 * differences, with a single change notification.
+	 *
+	 * @param[in] deltas differences to be applied, by estimate ID
+	 */
+	void adjust(const QHash<uint, Money>& deltas);
+
 	/**
 	 * Returns the actual amount for the given estimate ID.
 	 *
@@ -80,9 +114,28 @@ signals:
 	 */
 	void actualsChanged();
 
+	/**
+	 * Emitted whenever the actuals have changed, along with
+	 * `actualsChanged()`, identifying the affected estimates.
+	 *
+	 * @param[in] estimateIds unique IDs of all estimates whose actual
+	 *                        amounts have changed
+	 */
+	void estimatesChanged(const QList<uint>& estimateIds);
+
 private:
 	/** Map of estimate ID to actual amount */
 	QHash<uint, Money> actuals;
+	/** Notifications deferred during the current batch */
+	BatchedChanges batch;
+
+	/**
+	 * Emits change notifications for the given estimates, or defers them
+	 * until the end of the current batch.
+	 *
+	 * @param[in] estimateIds unique IDs of the changed estimates
+	 */
+	void changed(const QSet<uint>& estimateIds);
 };
 
 }
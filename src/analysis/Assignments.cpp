@@ -24,12 +24,39 @@ Assignments::Assignments(QObject* parent)
 	: QObject(parent)
 { }
 
+//------------------------------------------------------------------------------
+void Assignments::beginBatch()
+{
+	batch.begin();
+}
+
+//------------------------------------------------------------------------------
+void Assignments::endBatch()
+{
+	if (batch.end())
+	{
+		emit transactionsChanged(batch.takeIds());
+		emit assignmentsChanged();
+	}
+}
+
+//------------------------------------------------------------------------------
+void Assignments::changed(const QSet<uint>& transactionIds)
+{
+	if ( ! batch.defer(transactionIds))
+	{
+		emit transactionsChanged(transactionIds.toList());
+		emit assignmentsChanged();
+	}
+}
+
 //------------------------------------------------------------------------------
 void Assignments::clear()
 {
+	QSet<uint> transactionIds = transactionToEstimate.keys().toSet();
 	transactionToEstimate.clear();
 	transactionToRule.clear();
-	emit assignmentsChanged();
+	changed(transactionIds);
 }
 
 //------------------------------------------------------------------------------
@@ -37,7 +64,41 @@ void Assignments::record(uint trnId, uint estId, uint ruleId)
 {
 	transactionToEstimate[trnId] = estId;
 	transactionToRule[trnId] = ruleId;
-	emit assignmentsChanged();
+	changed(QSet<uint>() << trnId);
+}
+
+//------------------------------------------------------------------------------
+void Assignments::replace(const QHash<uint, uint>& estimates,
+	const QHash<uint, uint>& rules)
+{
+	QSet<uint> transactionIds = transactionToEstimate.keys().toSet();
+	transactionIds.unite(estimates.keys().toSet());
+	transactionToEstimate = estimates;
+	transactionToRule = rules;
+	changed(transactionIds);
+}
+
+//------------------------------------------------------------------------------
+void Assignments::reassign(const QHash<uint, uint>& estimates,
+	const QHash<uint, uint>& rules)
+{
+	QHashIterator<uint, uint> iter(estimates);
+	while (iter.hasNext())
+	{
+		iter.next();
+		if (iter.value() == 0)
+		{
+			transactionToEstimate.remove(iter.key());
+			transactionToRule.remove(iter.key());
+		}
+		else
+		{
+			transactionToEstimate[iter.key()] = iter.value();
+			transactionToRule[iter.key()] = rules.value(iter.key(), 0);
+		}
+	}
+
+	changed(estimates.keys().toSet());
 }
 
 //------------------------------------------------------------------------------
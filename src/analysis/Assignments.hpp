@@ -19,7 +19,12 @@
 
 // Qt include(s)
 #include <QHash>
+#include <QList>
 #include <QObject>
+#include <QSet>
+
+// UnderBudget include(s)
+#include "analysis/BatchedChanges.hpp"
 
 namespace ub {
 
@@ -41,6 +46,21 @@ public:
 	 */
 	Assignments(QObject* parent = 0);
 
+	/**
+	 * Opens a batch of modifications. Until the batch is closed, no
+	 * change notifications are emitted for individual modifications.
+	 *
+	 * @sa ChangeBatch
+	 */
+	void beginBatch();
+
+	/**
+	 * Closes a batch of modifications. If anything was modified during
+	 * the outermost batch, a single aggregated change notification
+	 * is emitted.
+	 */
+	void endBatch();
+
 	/**
 	 * Clears all previous assignments.
 	 */
@@ -58,6 +78,27 @@ public:
 	 */
 	void record(uint trnId, uint estId, uint ruleId);
 
+	/**
+	 * Replaces all previous assignments with the given assignments,
+	 * with a single change notification.
+	 *
+	 * @param[in] estimates estimate IDs, by transaction ID
+	 * @param[in] rules     assignment rule IDs, by transaction ID
+	 */
+	void replace(const QHash<uint, uint>& estimates,
+		const QHash<uint, uint>& rules);
+
+	/**
+	 * Updates the assignments of the given transactions, with a single
+	 * change notification. Transactions given an estimate ID of 0 are
+	 * no longer considered assigned.
+	 *
+	 * @param[in] estimates estimate IDs, by transaction ID
+	 * @param[in] rules     assignment rule IDs, by transaction ID
+	 */
+	void reassign(const QHash<uint, uint>& estimates,
+		const QHash<uint, uint>& rules);
+
 	/**
 	 * Returns the number of assigned transactions statistic.
 	 *
@@ -93,11 +134,30 @@ signals:
 	 */
 	void assignmentsChanged();
 
+	/**
+	 * Emitted whenever the assignments have changed, along with
+	 * `assignmentsChanged()`, identifying the affected transactions.
+	 *
+	 * @param[in] transactionIds unique IDs of all transactions whose
+	 *                           assignments have changed
+	 */
+	void transactionsChanged(const QList<uint>& transactionIds);
+
 private:
 	/** Map of transaction ID to assigned estimate ID */
 	QHash<uint, uint> transactionToEstimate;
 	/** Map of transaction ID to assigning rule */
 	QHash<uint, uint> transactionToRule;
+	/** Notifications deferred during the current batch */
+	BatchedChanges batch;
+
+	/**
+	 * Emits change notifications for the given transactions, or defers
+	 * them until the end of the current batch.
+	 *
+	 * @param[in] transactionIds unique IDs of the changed transactions
+	 */
+	void changed(const QSet<uint>& transactionIds);
 };
 
 }
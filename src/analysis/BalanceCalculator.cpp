@@ -20,6 +20,7 @@
 // UnderBudget include(s)
 #include "analysis/Actuals.hpp"
 #include "analysis/BalanceCalculator.hpp"
+#include "analysis/ChangeBatch.hpp"
 #include "analysis/ProjectedBalance.hpp"
 #include "analysis/SortedDifferences.hpp"
 #include "budget/Estimate.hpp"
@@ -51,15 +52,28 @@ void BalanceCalculator::calculateBalances()
 		isCalculating = true;
 		emit started();
 
-		clear();
-
-		// Grab cache/map of actuals
-		actualsCache = actuals->map();
-		add(estimates.data());
-
-		// Sort differences
-		overBudget->sort();
-		underBudget->sort();
+		{
+			// Notify of all results at once, when they are complete
+			ChangeBatch<ProjectedBalance> estimatedBatch(estimated);
+			ChangeBatch<ProjectedBalance> actualBatch(actual);
+			ChangeBatch<ProjectedBalance> expectedBatch(expected);
+			ChangeBatch<SortedDifferences> overBatch(overBudget);
+			ChangeBatch<SortedDifferences> underBatch(underBudget);
+
+			clear();
+
+			// Roll up all estimate totals in a single pass, then
+			// add each estimate in tree order
+			rollup.calculate(estimates.data(), actuals->map());
+			for (int i=0; i<rollup.size(); ++i)
+			{
+				add(i);
+			}
+
+			// Sort differences
+			overBudget->sort();
+			underBudget->sort();
+		}
 
 		isCalculating = false;
 		emit finished();
@@ -77,10 +91,11 @@ void BalanceCalculator::clear()
 }
 
 //------------------------------------------------------------------------------
-void BalanceCalculator::add(const Estimate* estimate)
+void BalanceCalculator::add(int position)
 {
-	Estimate::Progress progress = estimate->progress(actualsCache);
-	Estimate::Impact impact = estimate->impact(actualsCache);
+	const Estimate* estimate = rollup.estimateAt(position);
+	Estimate::Progress progress = rollup.progress(position);
+	Estimate::Impact impact = rollup.impact(position);
 
 	// Add to projected balances
 	estimated->add(impact.estimated);
@@ -118,11 +133,6 @@ void BalanceCalculator::add(const Estimate* estimate)
 			overBudget->record(estimate->estimateId(), diff);
 		}
 	}
-
-	for (int i=0; i<estimate->childCount(); ++i)
-	{
-		add(estimate->childAt(i));
-	}
 }
 
 }
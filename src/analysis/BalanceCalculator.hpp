@@ -21,6 +21,9 @@
 #include <QObject>
 #include <QSharedPointer>
 
+// UnderBudget include(s)
+#include "analysis/EstimateRollup.hpp"
+
 namespace ub {
 
 // Forward declaration(s)
@@ -100,8 +103,8 @@ private:
 	SortedDifferences* underBudget;
 	/** Whether the calculator is currencly calculating */
 	bool isCalculating;
-	/** Actuals cache */
-	QHash<uint,Money> actualsCache;
+	/** Rolled-up estimate totals */
+	EstimateRollup rollup;
 
 	/**
 	 * Clears all results from a previous calculation.
@@ -109,13 +112,12 @@ private:
 	void clear();
 
 	/**
-	 * Adds the given estimate's impact values to the
-	 * projected balances. This function is recursive, descending
-	 * to all child estimates of the estimate.
+	 * Adds the impact values of the estimate at the given rollup
+	 * position to the projected balances.
 	 *
-	 * @param[in] estimate estimate whose impact is to be added
+	 * @param[in] position rollup position of the estimate to be added
 	 */
-	void add(const Estimate* estimate);
+	void add(int position);
 };
 
 }
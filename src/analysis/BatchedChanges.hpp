@@ -0,0 +1,111 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATCHEDCHANGES_HPP
+#define BATCHEDCHANGES_HPP
+
+// Qt include(s)
+#include <QList>
+#include <QSet>
+
+namespace ub {
+
+/**
+ * Bookkeeping of the change notifications deferred by an analysis container
+ * while a batch is open. The container forwards its `beginBatch()` and
+ * `endBatch()` calls here, and asks to defer each change notification. Once
+ * the outermost batch is closed, the container emits a single aggregated
+ * notification if anything was modified.
+ *
+ * @sa ChangeBatch
+ * @ingroup analysis
+ */
+class BatchedChanges
+{
+public:
+	/**
+	 * Constructs the bookkeeping with no open batch.
+	 */
+	BatchedChanges()
+		: depth(0), modified(false)
+	{ }
+
+	/**
+	 * Opens a batch, which may be nested within another batch.
+	 */
+	void begin()
+	{
+		++depth;
+	}
+
+	/**
+	 * Closes a batch.
+	 *
+	 * @return `true` if the outermost batch was closed and anything was
+	 *         modified during it, so a notification is to be emitted
+	 */
+	bool end()
+	{
+		if (depth > 0 && --depth == 0 && modified)
+		{
+			modified = false;
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 * Records a modification of the given IDs, if a batch is open.
+	 *
+	 * @param[in] ids unique IDs of the modified items
+	 * @return `true` if the notification is deferred until the end of
+	 *         the batch, or `false` if it is to be emitted immediately
+	 */
+	bool defer(const QSet<uint>& ids = QSet<uint>())
+	{
+		if (depth > 0)
+		{
+			pending.unite(ids);
+			modified = true;
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 * Returns the IDs modified during the last batch, and forgets them.
+	 *
+	 * @return unique IDs of the items modified during the batch
+	 */
+	QList<uint> takeIds()
+	{
+		QList<uint> ids = pending.toList();
+		pending.clear();
+		return ids;
+	}
+
+private:
+	/** Number of currently open batches */
+	int depth;
+	/** IDs modified during the current batch */
+	QSet<uint> pending;
+	/** Whether anything has been modified during the current batch */
+	bool modified;
+};
+
+}
+
+#endif //BATCHEDCHANGES_HPP
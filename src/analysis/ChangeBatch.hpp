@@ -0,0 +1,69 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHANGEBATCH_HPP
+#define CHANGEBATCH_HPP
+
+// Qt include(s)
+#include <QtGlobal>
+
+namespace ub {
+
+/**
+ * Scoped guard for coalescing the change notifications of an analysis
+ * container. A batch is opened on the container when the guard is created,
+ * and closed when the guard is destroyed, at which point a single aggregated
+ * change notification is emitted if anything was modified.
+ *
+ * The container type must provide `beginBatch()` and `endBatch()`. Batches
+ * may be nested, in which case notifications are emitted once the outermost
+ * batch is closed.
+ *
+ * @ingroup analysis
+ */
+template <typename T>
+class ChangeBatch
+{
+public:
+	/**
+	 * Opens a batch on the given container.
+	 *
+	 * @param[in] container container whose notifications are to be coalesced
+	 */
+	explicit ChangeBatch(T* container)
+		: container(container)
+	{
+		container->beginBatch();
+	}
+
+	/**
+	 * Closes the batch on the container.
+	 */
+	~ChangeBatch()
+	{
+		container->endBatch();
+	}
+
+private:
+	Q_DISABLE_COPY(ChangeBatch)
+
+	/** Container whose notifications are being coalesced */
+	T* container;
+};
+
+}
+
+#endif //CHANGEBATCH_HPP
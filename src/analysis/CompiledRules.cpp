@@ -0,0 +1,598 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Qt include(s)
+#include <QtCore>
+
+// UnderBudget include(s)
+#include "analysis/CompiledRules.hpp"
+#include "budget/AssignmentRules.hpp"
+#include "ledger/ImportedTransaction.hpp"
+#include "ledger/TransactionStore.hpp"
+
+namespace ub {
+
+//------------------------------------------------------------------------------
+static const int PAYEE_SLOT = 0;
+static const int MEMO_SLOT = 1;
+static const int DEPOSIT_SLOT = 2;
+static const int WITHDRAWAL_SLOT = 3;
+
+//------------------------------------------------------------------------------
+static int slotFor(AssignmentRule::Field field)
+{
+	switch (field)
+	{
+	case AssignmentRule::Payee:
+		return PAYEE_SLOT;
+	case AssignmentRule::Memo:
+		return MEMO_SLOT;
+	case AssignmentRule::DepositAccount:
+		return DEPOSIT_SLOT;
+	case AssignmentRule::WithdrawalAccount:
+		return WITHDRAWAL_SLOT;
+	default:
+		return -1;
+	}
+}
+
+//------------------------------------------------------------------------------
+CompiledRules::Fields::Fields(const ImportedTransaction& transaction)
+	: date(transaction.date()), amount(transaction.amount())
+{
+	strings[PAYEE_SLOT] = transaction.payee();
+	strings[MEMO_SLOT] = transaction.memo();
+	strings[DEPOSIT_SLOT] = transaction.depositAccount();
+	strings[WITHDRAWAL_SLOT] = transaction.withdrawalAccount();
+
+	folded[PAYEE_SLOT] = strings[PAYEE_SLOT].toCaseFolded();
+	folded[MEMO_SLOT] = strings[MEMO_SLOT].toCaseFolded();
+
+	// Account names are case-folded once per account, not per transaction
+	folded[DEPOSIT_SLOT] = transaction.foldedDepositAccount();
+	folded[WITHDRAWAL_SLOT] = transaction.foldedWithdrawalAccount();
+}
+
+//------------------------------------------------------------------------------
+CompiledRules::Fields::Fields(const TransactionStore& transactions, int index)
+	: date(transactions.date(index)), amount(transactions.amount(index))
+{
+	int ids[4];
+	ids[PAYEE_SLOT] = transactions.payeeId(index);
+	ids[MEMO_SLOT] = transactions.memoId(index);
+	ids[DEPOSIT_SLOT] = transactions.depositAccountId(index);
+	ids[WITHDRAWAL_SLOT] = transactions.withdrawalAccountId(index);
+
+	for (int i=0; i<4; ++i)
+	{
+		strings[i] = transactions.string(ids[i]);
+		folded[i] = transactions.foldedString(ids[i]);
+	}
+}
+
+//------------------------------------------------------------------------------
+CompiledRules::CompiledRules(QSharedPointer<AssignmentRules> rules,
+		QObject* parent)
+	: QObject(parent), source(rules)
+{
+	connect(rules.data(), &AssignmentRules::ruleAdded,
+		this, &CompiledRules::ruleAdded);
+	connect(rules.data(), &AssignmentRules::ruleRemoved,
+		this, &CompiledRules::ruleRemoved);
+	connect(rules.data(), &AssignmentRules::ruleMoved,
+		this, &CompiledRules::ruleMoved);
+
+	compile();
+}
+
+//------------------------------------------------------------------------------
+void CompiledRules::compile()
+{
+	rules.clear();
+	predicates.clear();
+
+	for (int i=0; i<source->size(); ++i)
+	{
+		insert(source->at(i), i);
+		listen(source->at(i));
+	}
+
+	reindex();
+}
+
+//------------------------------------------------------------------------------
+void CompiledRules::listen(AssignmentRule* rule)
+{
+	connect(rule, &AssignmentRule::conditionAdded,
+		this, &CompiledRules::conditionAdded);
+	connect(rule, &AssignmentRule::conditionRemoved,
+		this, &CompiledRules::conditionRemoved);
+	connect(rule, &AssignmentRule::conditionUpdated,
+		this, &CompiledRules::conditionUpdated);
+}
+
+//------------------------------------------------------------------------------
+void CompiledRules::reindex()
+{
+	keys.clear();
+	unkeyed.clear();
+	for (int m=0; m<8; ++m)
+	{
+		matchers[m].clear();
+	}
+
+	for (int i=0; i<rules.size(); ++i)
+	{
+		const Rule& rule = rules.at(i);
+
+		// Since all conditions must be satisfied, any string predicate
+		// can serve as the key; the longest one is the most selective
+		const Predicate* key = 0;
+		for (int k=rule.first; k<rule.first + rule.count; ++k)
+		{
+			const Predicate& predicate = predicates.at(k);
+			if (predicate.valid && slotFor(predicate.field) >= 0
+				&& ! predicate.string.isEmpty()
+				&& (predicate.op == AssignmentRule::BeginsWith
+					|| predicate.op == AssignmentRule::EndsWith
+					|| predicate.op == AssignmentRule::Contains
+					|| predicate.op == AssignmentRule::StringEquals)
+				&& ( ! key || predicate.string.size() > key->string.size()))
+			{
+				key = &predicate;
+			}
+		}
+
+		if ( ! key)
+		{
+			unkeyed.append(i);
+			continue;
+		}
+
+		Key compiled;
+		compiled.rule = i;
+		compiled.op = key->op;
+		compiled.length = key->string.size();
+		keys.append(compiled);
+
+		int matcher = slotFor(key->field) * 2 + (key->sensitive ? 1 : 0);
+		matchers[matcher].add(key->string, keys.size() - 1);
+	}
+
+	for (int m=0; m<8; ++m)
+	{
+		matchers[m].build();
+	}
+}
+
+//------------------------------------------------------------------------------
+int CompiledRules::size() const
+{
+	return rules.size();
+}
+
+//------------------------------------------------------------------------------
+uint CompiledRules::ruleId(int index) const
+{
+	if (index < 0 || index >= rules.size())
+		return 0;
+	return rules.at(index).ruleId;
+}
+
+//------------------------------------------------------------------------------
+uint CompiledRules::estimateId(int index) const
+{
+	if (index < 0 || index >= rules.size())
+		return 0;
+	return rules.at(index).estimateId;
+}
+
+//------------------------------------------------------------------------------
+int CompiledRules::match(const ImportedTransaction& transaction) const
+{
+	return match(Fields(transaction));
+}
+
+//------------------------------------------------------------------------------
+int CompiledRules::match(const Fields& fields, int from) const
+{
+	from = qMax(from, 0);
+
+	QVector<int> candidates;
+	collectCandidates(fields, from, candidates);
+
+	// Merge with the rules that have no key, checking in rule order
+	// so that the first matching rule wins
+	QVector<int>::const_iterator iter = qLowerBound(unkeyed.constBegin(),
+		unkeyed.constEnd(), from);
+	int c = 0;
+	int last = -1;
+	while (c < candidates.size() || iter != unkeyed.constEnd())
+	{
+		int next;
+		if (iter == unkeyed.constEnd()
+			|| (c < candidates.size() && candidates.at(c) < *iter))
+		{
+			next = candidates.at(c++);
+		}
+		else
+		{
+			next = *iter++;
+		}
+
+		if (next != last && matches(fields, next))
+			return next;
+		last = next;
+	}
+
+	return -1;
+}
+
+//------------------------------------------------------------------------------
+void CompiledRules::collectCandidates(const Fields& fields, int from,
+	QVector<int>& candidates) const
+{
+	QVector<PatternMatcher::Hit> hits;
+
+	for (int m=0; m<8; ++m)
+	{
+		if (matchers[m].isEmpty())
+			continue;
+
+		int slot = m / 2;
+		const QString& text = (m % 2)
+			? fields.strings[slot] : fields.folded[slot];
+
+		hits.clear();
+		matchers[m].search(text, hits);
+
+		for (int h=0; h<hits.size(); ++h)
+		{
+			const PatternMatcher::Hit& hit = hits.at(h);
+			const Key& key = keys.at(hit.id);
+			if (key.rule < from)
+				continue;
+
+			bool atStart = (hit.end == key.length);
+			bool atEnd = (hit.end == text.size());
+
+			switch (key.op)
+			{
+			case AssignmentRule::BeginsWith:
+				if ( ! atStart)
+					continue;
+				break;
+			case AssignmentRule::EndsWith:
+				if ( ! atEnd)
+					continue;
+				break;
+			case AssignmentRule::StringEquals:
+				if ( ! atStart || ! atEnd)
+					continue;
+				break;
+			default:
+				break;
+			}
+
+			candidates.append(key.rule);
+		}
+	}
+
+	qSort(candidates);
+}
+
+//------------------------------------------------------------------------------
+bool CompiledRules::matches(const Fields& fields, int index) const
+{
+	const Rule& rule = rules.at(index);
+	const Predicate* predicate = predicates.constData() + rule.first;
+	const Predicate* end = predicate + rule.count;
+
+	// All conditions must be satisfied, a rule without any
+	// conditions matches every transaction
+	for ( ; predicate != end; ++predicate)
+	{
+		if ( ! qualifies(fields, *predicate))
+			return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+void CompiledRules::ruleAdded(AssignmentRule* rule, int index)
+{
+	insert(rule, index);
+	listen(rule);
+	reindex();
+	emit rulesChanged(index);
+}
+
+//------------------------------------------------------------------------------
+void CompiledRules::ruleRemoved(AssignmentRule* rule, int index)
+{
+	disconnect(rule, 0, this, 0);
+	remove(index);
+	reindex();
+	emit rulesChanged(index);
+}
+
+//------------------------------------------------------------------------------
+void CompiledRules::ruleMoved(AssignmentRule* rule, int from, int to)
+{
+	if (from == to)
+		return;
+
+	remove(from);
+	insert(rule, to);
+	reindex();
+	emit rulesChanged(qMin(from, to));
+}
+
+//------------------------------------------------------------------------------
+void CompiledRules::conditionAdded(const AssignmentRule::Condition& condition,
+	int index)
+{
+	int ruleIndex = senderIndex();
+	if (ruleIndex < 0)
+		return;
+
+	Rule& rule = rules[ruleIndex];
+	predicates.insert(rule.first + index, compile(condition));
+	++rule.count;
+	reoffset(ruleIndex + 1);
+	reindex();
+	emit rulesChanged(ruleIndex);
+}
+
+//------------------------------------------------------------------------------
+void CompiledRules::conditionRemoved(const AssignmentRule::Condition& condition,
+	int index)
+{
+	Q_UNUSED(condition);
+
+	int ruleIndex = senderIndex();
+	if (ruleIndex < 0)
+		return;
+
+	Rule& rule = rules[ruleIndex];
+	if (index >= 0 && index < rule.count)
+	{
+		predicates.remove(rule.first + index);
+		--rule.count;
+		reoffset(ruleIndex + 1);
+		reindex();
+		emit rulesChanged(ruleIndex);
+	}
+}
+
+//------------------------------------------------------------------------------
+void CompiledRules::conditionUpdated(const AssignmentRule::Condition& condition,
+	int index)
+{
+	int ruleIndex = senderIndex();
+	if (ruleIndex < 0)
+		return;
+
+	const Rule& rule = rules.at(ruleIndex);
+	if (index >= 0 && index < rule.count)
+	{
+		predicates[rule.first + index] = compile(condition);
+		reindex();
+		emit rulesChanged(ruleIndex);
+	}
+}
+
+//------------------------------------------------------------------------------
+void CompiledRules::insert(const AssignmentRule* rule, int index)
+{
+	if (index < 0 || index > rules.size())
+		index = rules.size();
+
+	Rule compiled;
+	compiled.ruleId = rule->ruleId();
+	compiled.estimateId = rule->estimateId();
+	compiled.first = (index < rules.size()) ? rules.at(index).first
+		: predicates.size();
+	compiled.count = rule->conditionCount();
+
+	QVector<Predicate> parsed;
+	parsed.reserve(compiled.count);
+	for (int k=0; k<compiled.count; ++k)
+	{
+		parsed.append(compile(rule->conditionAt(k)));
+	}
+
+	predicates.insert(compiled.first, compiled.count, Predicate());
+	for (int k=0; k<compiled.count; ++k)
+	{
+		predicates[compiled.first + k] = parsed.at(k);
+	}
+
+	rules.insert(index, compiled);
+	reoffset(index + 1);
+}
+
+//------------------------------------------------------------------------------
+void CompiledRules::remove(int index)
+{
+	if (index < 0 || index >= rules.size())
+		return;
+
+	const Rule& rule = rules.at(index);
+	predicates.remove(rule.first, rule.count);
+	rules.remove(index);
+	reoffset(index);
+}
+
+//------------------------------------------------------------------------------
+void CompiledRules::reoffset(int index)
+{
+	int first = (index > 0)
+		? rules.at(index - 1).first + rules.at(index - 1).count : 0;
+
+	for (int i=index; i<rules.size(); ++i)
+	{
+		rules[i].first = first;
+		first += rules.at(i).count;
+	}
+}
+
+//------------------------------------------------------------------------------
+int CompiledRules::senderIndex() const
+{
+	AssignmentRule* rule = qobject_cast<AssignmentRule*>(sender());
+	if ( ! rule)
+		return -1;
+
+	// Rule IDs are not guaranteed to be unique, so verify the
+	// indexed rule before falling back to a search by pointer
+	int index = source->indexOf(rule->ruleId());
+	if (source->at(index) != rule)
+	{
+		index = -1;
+		for (int i=0; i<source->size(); ++i)
+		{
+			if (source->at(i) == rule)
+			{
+				index = i;
+				break;
+			}
+		}
+	}
+
+	if (index < 0 || index >= rules.size())
+		return -1;
+	return index;
+}
+
+//------------------------------------------------------------------------------
+CompiledRules::Predicate CompiledRules::compile(
+	const AssignmentRule::Condition& condition)
+{
+	Predicate predicate;
+	predicate.field = condition.field;
+	predicate.op = condition.op;
+	predicate.sensitive = condition.sensitive;
+	predicate.valid = false;
+
+	switch (condition.field)
+	{
+	case AssignmentRule::Date:
+		predicate.date = QVariant(condition.value).toDate();
+		predicate.valid = predicate.date.isValid();
+		break;
+
+	case AssignmentRule::Amount:
+	{
+		QStringList amtParts = condition.value.split(",");
+		if (amtParts.size() == 2)
+		{
+			predicate.amount = Money(QVariant(amtParts[0]).toDouble(), amtParts[1]);
+			predicate.valid = true;
+		}
+		break;
+	}
+
+	case AssignmentRule::Payee:
+	case AssignmentRule::Memo:
+	case AssignmentRule::DepositAccount:
+	case AssignmentRule::WithdrawalAccount:
+		predicate.string = condition.sensitive ? condition.value
+			: condition.value.toCaseFolded();
+		predicate.valid = true;
+		break;
+
+	default:
+		break;
+	}
+
+	return predicate;
+}
+
+//------------------------------------------------------------------------------
+bool CompiledRules::qualifies(const Fields& fields, const Predicate& predicate)
+{
+	if ( ! predicate.valid)
+		return false;
+
+	switch (predicate.field)
+	{
+	case AssignmentRule::Date:
+	{
+		if ( ! fields.date.isValid())
+			return false;
+
+		switch (predicate.op)
+		{
+		case AssignmentRule::Before:
+			return (fields.date < predicate.date);
+		case AssignmentRule::After:
+			return (fields.date > predicate.date);
+		case AssignmentRule::DateEquals:
+			return (fields.date == predicate.date);
+		default:
+			return false;
+		}
+	}
+
+	case AssignmentRule::Amount:
+	{
+		switch (predicate.op)
+		{
+		case AssignmentRule::LessThan:
+			return (fields.amount < predicate.amount);
+		case AssignmentRule::LessThanOrEqual:
+			return (fields.amount <= predicate.amount);
+		case AssignmentRule::GreaterThan:
+			return (fields.amount > predicate.amount);
+		case AssignmentRule::GreaterThanOrEqual:
+			return (fields.amount >= predicate.amount);
+		case AssignmentRule::AmountEquals:
+			return (fields.amount == predicate.amount);
+		default:
+			return false;
+		}
+	}
+
+	default:
+	{
+		int slot = slotFor(predicate.field);
+		if (slot < 0)
+			return false;
+
+		// Both sides are already case-folded for insensitive comparisons
+		const QString& string = predicate.sensitive
+			? fields.strings[slot] : fields.folded[slot];
+
+		switch (predicate.op)
+		{
+		case AssignmentRule::BeginsWith:
+			return string.startsWith(predicate.string);
+		case AssignmentRule::EndsWith:
+			return string.endsWith(predicate.string);
+		case AssignmentRule::Contains:
+			return string.contains(predicate.string);
+		case AssignmentRule::StringEquals:
+			return (string == predicate.string);
+		default:
+			return false;
+		}
+	}
+	}
+}
+
+}
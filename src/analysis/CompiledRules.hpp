@@ -0,0 +1,361 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMPILEDRULES_HPP
+#define COMPILEDRULES_HPP
+
+// Qt include(s)
+#include <QDate>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+// UnderBudget include(s)
+#include "accounting/Money.hpp"
+#include "analysis/PatternMatcher.hpp"
+#include "budget/AssignmentRule.hpp"
+
+namespace ub {
+
+// Forward declaration(s)
+class AssignmentRules;
+class ImportedTransaction;
+class TransactionStore;
+
+/**
+ * Pre-parsed form of an ordered list of assignment rules, optimized for
+ * matching a large number of transactions.
+ *
+ * All rule conditions are parsed once into typed predicates (dates, money
+ * amounts, and case-folded strings) and stored in a single flat array, with
+ * each compiled rule referring to a contiguous range of that array. The
+ * compiled rules are kept in sync with the original rules list by listening
+ * to the rule and condition modification signals, so that only the affected
+ * rule has to be re-compiled when a rule or condition changes.
+ *
+ * To avoid checking every rule against every transaction, one string
+ * condition from each rule is selected as that rule's key, and all keys are
+ * indexed in multi-pattern matchers. A single pass over each string field of
+ * a transaction yields the set of candidate rules whose key is satisfied.
+ * Only the candidates and the rules without a key have to be fully checked,
+ * in ascending order, so the first matching rule is still the one found.
+ *
+ * @ingroup analysis
+ */
+class CompiledRules : public QObject
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * Transaction field values, extracted once per transaction so that
+	 * they can be compared against any number of predicates.
+	 */
+	struct Fields
+	{
+		/** Transaction date */
+		QDate date;
+		/** Transaction amount */
+		Money amount;
+		/** Payee, memo, deposit account, and withdrawal account */
+		QString strings[4];
+		/** Case-folded payee, memo, deposit account, and withdrawal account */
+		QString folded[4];
+
+		/**
+		 * Extracts the field values of the given transaction.
+		 *
+		 * @param[in] transaction transaction whose fields are to be extracted
+		 */
+		Fields(const ImportedTransaction& transaction);
+
+		/**
+		 * Extracts the field values of the transaction at the given index
+		 * of a transaction store. The case-folded values are taken from
+		 * the store's interned strings, rather than being case-folded.
+		 *
+		 * @param[in] transactions transaction store
+		 * @param[in] index        index of the transaction to be extracted
+		 */
+		Fields(const TransactionStore& transactions, int index);
+	};
+
+	/**
+	 * Constructs a compiled form of the given assignment rules.
+	 *
+	 * @param[in] rules  assignment rules
+	 * @param[in] parent parent object
+	 */
+	CompiledRules(QSharedPointer<AssignmentRules> rules, QObject* parent = 0);
+
+	/**
+	 * Returns the number of compiled rules.
+	 *
+	 * @return number of compiled rules
+	 */
+	int size() const;
+
+	/**
+	 * Returns the unique ID of the rule at the given index.
+	 *
+	 * @param[in] index rule index
+	 * @return unique ID of the rule, or 0 if the index is invalid
+	 */
+	uint ruleId(int index) const;
+
+	/**
+	 * Returns the ID of the estimate associated with the rule at the
+	 * given index.
+	 *
+	 * @param[in] index rule index
+	 * @return ID of the associated estimate, or 0 if the index is invalid
+	 */
+	uint estimateId(int index) const;
+
+	/**
+	 * Searches for the first rule for which the given transaction
+	 * qualifies.
+	 *
+	 * @param[in] transaction transaction to be matched
+	 * @return index of the first matching rule, or -1 if no rule matches
+	 */
+	int match(const ImportedTransaction& transaction) const;
+
+	/**
+	 * Searches for the first rule for which the given transaction fields
+	 * qualify, starting at the given rule index.
+	 *
+	 * @param[in] fields transaction fields to be matched
+	 * @param[in] from   index of the first rule to be checked
+	 * @return index of the first matching rule, or -1 if no rule matches
+	 */
+	int match(const Fields& fields, int from = 0) const;
+
+	/**
+	 * Checks if the given transaction fields qualify for the rule at the
+	 * given index.
+	 *
+	 * @param[in] fields transaction fields to be matched
+	 * @param[in] index  rule index
+	 * @return `true` if all conditions of the rule are satisfied
+	 */
+	bool matches(const Fields& fields, int index) const;
+
+signals:
+	/**
+	 * Emitted after the compiled rules have been updated as a result of a
+	 * rule or condition modification. Rules before the given index are
+	 * unaffected by the modification.
+	 *
+	 * @param[in] index index of the first affected rule
+	 */
+	void rulesChanged(int index);
+
+private slots:
+	/**
+	 * Compiles the newly added rule.
+	 *
+	 * @param[in] rule  new rule
+	 * @param[in] index index of the new rule
+	 */
+	void ruleAdded(AssignmentRule* rule, int index);
+
+	/**
+	 * Discards the compiled form of the removed rule.
+	 *
+	 * @param[in] rule  rule that was removed
+	 * @param[in] index old index of the rule
+	 */
+	void ruleRemoved(AssignmentRule* rule, int index);
+
+	/**
+	 * Moves the compiled form of the moved rule.
+	 *
+	 * @param[in] rule rule that was moved
+	 * @param[in] from old index of the rule
+	 * @param[in] to   new index of the rule
+	 */
+	void ruleMoved(AssignmentRule* rule, int from, int to);
+
+	/**
+	 * Compiles the newly added condition.
+	 *
+	 * @param[in] condition new condition
+	 * @param[in] index     index of the new condition
+	 */
+	void conditionAdded(const AssignmentRule::Condition& condition, int index);
+
+	/**
+	 * Discards the compiled form of the removed condition.
+	 *
+	 * @param[in] condition condition that was removed
+	 * @param[in] index     old index of the condition
+	 */
+	void conditionRemoved(const AssignmentRule::Condition& condition, int index);
+
+	/**
+	 * Re-compiles the updated condition.
+	 *
+	 * @param[in] condition new condition parameters
+	 * @param[in] index     index of the updated condition
+	 */
+	void conditionUpdated(const AssignmentRule::Condition& condition, int index);
+
+private:
+	/**
+	 * Pre-parsed assignment rule condition.
+	 */
+	struct Predicate
+	{
+		/** Transaction field */
+		AssignmentRule::Field field;
+		/** Comparison operator */
+		AssignmentRule::Operator op;
+		/** Whether the comparison value could be parsed */
+		bool valid;
+		/** Whether string comparisons are case-sensitive */
+		bool sensitive;
+		/** Date comparison value */
+		QDate date;
+		/** Amount comparison value */
+		Money amount;
+		/** String comparison value (case-folded if insensitive) */
+		QString string;
+	};
+
+	/**
+	 * Compiled assignment rule.
+	 */
+	struct Rule
+	{
+		/** Unique ID of the rule */
+		uint ruleId;
+		/** Associated estimate ID */
+		uint estimateId;
+		/** Index of the first predicate of this rule */
+		int first;
+		/** Number of predicates for this rule */
+		int count;
+	};
+
+	/**
+	 * String predicate used to pre-select a rule as a candidate.
+	 */
+	struct Key
+	{
+		/** Index of the rule */
+		int rule;
+		/** Comparison operator */
+		AssignmentRule::Operator op;
+		/** Length of the comparison value */
+		int length;
+	};
+
+	/** Assignment rules */
+	QSharedPointer<AssignmentRules> source;
+	/** Compiled rules, in rule order */
+	QVector<Rule> rules;
+	/** Predicates for all rules, stored contiguously in rule order */
+	QVector<Predicate> predicates;
+	/** Rule keys, by key ID */
+	QVector<Key> keys;
+	/** Key matchers, by string field slot and case-sensitivity */
+	PatternMatcher matchers[8];
+	/** Indices of rules without a key, in ascending order */
+	QVector<int> unkeyed;
+
+	/**
+	 * Compiles all rules from the source rules list.
+	 */
+	void compile();
+
+	/**
+	 * Connects to the condition modification signals of the given rule.
+	 *
+	 * @param[in] rule rule to be monitored
+	 */
+	void listen(AssignmentRule* rule);
+
+	/**
+	 * Selects the key of every rule and rebuilds the key matchers.
+	 */
+	void reindex();
+
+	/**
+	 * Collects the indices of all rules, at or after the given index,
+	 * for which the given transaction fields satisfy the rule key.
+	 *
+	 * @param[in]  fields     transaction fields
+	 * @param[in]  from       index of the first rule to be considered
+	 * @param[out] candidates list to which rule indices are appended
+	 */
+	void collectCandidates(const Fields& fields, int from,
+		QVector<int>& candidates) const;
+
+	/**
+	 * Compiles the given rule and inserts it at the given index.
+	 *
+	 * @param[in] rule  rule to be compiled
+	 * @param[in] index index at which to insert the compiled rule
+	 */
+	void insert(const AssignmentRule* rule, int index);
+
+	/**
+	 * Removes the compiled rule at the given index, along with all of
+	 * its predicates.
+	 *
+	 * @param[in] index index of the compiled rule to be removed
+	 */
+	void remove(int index);
+
+	/**
+	 * Recalculates the first-predicate index of every rule at or after
+	 * the given index.
+	 *
+	 * @param[in] index index of the first rule to be updated
+	 */
+	void reoffset(int index);
+
+	/**
+	 * Locates the compiled rule index for the rule that emitted the
+	 * current condition signal.
+	 *
+	 * @return compiled rule index, or -1 if the sender is not known
+	 */
+	int senderIndex() const;
+
+	/**
+	 * Parses the given condition into a predicate.
+	 *
+	 * @param[in] condition condition to be parsed
+	 * @return parsed predicate
+	 */
+	static Predicate compile(const AssignmentRule::Condition& condition);
+
+	/**
+	 * Checks if the given transaction fields satisfy the given predicate.
+	 *
+	 * @param[in] fields    transaction fields
+	 * @param[in] predicate predicate to be checked
+	 * @return `true` if the predicate is satisfied
+	 */
+	static bool qualifies(const Fields& fields, const Predicate& predicate);
+};
+
+}
+
+#endif //COMPILEDRULES_HPP
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Qt include(s)
+#include <QtCore>
+
+// UnderBudget include(s)
+#include "analysis/EstimateRollup.hpp"
+
+namespace ub {
+
+//------------------------------------------------------------------------------
+EstimateRollup::EstimateRollup()
+{ }
+
+//------------------------------------------------------------------------------
+void EstimateRollup::calculate(const Estimate* root,
+	const QHash<uint,Money>& actuals)
+{
+	clear();
+	if (root)
+	{
+		roll(root, actuals);
+	}
+}
+
+//------------------------------------------------------------------------------
+void EstimateRollup::clear()
+{
+	entries.clear();
+	positions.clear();
+}
+
+//------------------------------------------------------------------------------
+int EstimateRollup::roll(const Estimate* estimate,
+	const QHash<uint,Money>& actuals)
+{
+	// Reserve the estimate's position before descending, so that
+	// parents are stored before their children
+	int position = entries.size();
+	positions.insert(estimate->estimateId(), position);
+	entries.append(Entry());
+
+	// Sum up in the same order as the recursive estimate totals, so
+	// that any currency conversions produce identical results
+	Money estimated(estimate->estimatedAmount());
+	Money actual;
+	for (int i=0; i<estimate->childCount(); ++i)
+	{
+		int child = roll(estimate->childAt(i), actuals);
+		estimated += entries.at(child).estimated;
+		actual += entries.at(child).actual;
+	}
+
+	Entry& entry = entries[position];
+	entry.estimate = estimate;
+	entry.estimated = estimated;
+	entry.actual = estimate->isCategory() ? actual
+		: actuals.value(estimate->estimateId(), Money());
+	entry.impact = estimate->impact(actuals);
+
+	return position;
+}
+
+//------------------------------------------------------------------------------
+int EstimateRollup::size() const
+{
+	return entries.size();
+}
+
+//------------------------------------------------------------------------------
+const Estimate* EstimateRollup::estimateAt(int position) const
+{
+	if (position < 0 || position >= entries.size())
+		return 0;
+	return entries.at(position).estimate;
+}
+
+//------------------------------------------------------------------------------
+int EstimateRollup::positionOf(uint estimateId) const
+{
+	return positions.value(estimateId, -1);
+}
+
+//------------------------------------------------------------------------------
+Money EstimateRollup::totalEstimated(int position) const
+{
+	if (position < 0 || position >= entries.size())
+		return Money();
+	return entries.at(position).estimated;
+}
+
+//------------------------------------------------------------------------------
+Money EstimateRollup::totalActual(int position) const
+{
+	if (position < 0 || position >= entries.size())
+		return Money();
+	return entries.at(position).actual;
+}
+
+//------------------------------------------------------------------------------
+Estimate::Progress EstimateRollup::progress(int position,
+	const QDate& start) const
+{
+	if (position < 0 || position >= entries.size())
+	{
+		Estimate::Progress progress;
+		progress.isHealthy = true;
+		return progress;
+	}
+
+	const Entry& entry = entries.at(position);
+	return entry.estimate->progress(entry.estimated, entry.actual, start);
+}
+
+//------------------------------------------------------------------------------
+Estimate::Impact EstimateRollup::impact(int position) const
+{
+	if (position < 0 || position >= entries.size())
+		return Estimate::Impact();
+	return entries.at(position).impact;
+}
+
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ESTIMATEROLLUP_HPP
+#define ESTIMATEROLLUP_HPP
+
+// Qt include(s)
+#include <QDate>
+#include <QHash>
+#include <QVector>
+
+// UnderBudget include(s)
+#include "accounting/Money.hpp"
+#include "budget/Estimate.hpp"
+
+namespace ub {
+
+/**
+ * Hierarchical totals of an estimate tree, calculated in a single
+ * traversal of the tree.
+ *
+ * Each estimate's total estimated and actual amounts depend on the totals
+ * of all of its descendants. Rather than having every estimate recurse over
+ * its subtree, the totals are rolled up from the leaves of the tree towards
+ * the root, so that each estimate is visited exactly once. The results are
+ * stored in a flat array in tree order (parents before their children).
+ *
+ * @ingroup analysis
+ */
+class EstimateRollup
+{
+public:
+	/**
+	 * Constructs an empty rollup.
+	 */
+	EstimateRollup();
+
+	/**
+	 * Calculates the totals for every estimate in the given tree.
+	 *
+	 * @param[in] root    root of the estimate tree
+	 * @param[in] actuals map of actual activity amounts
+	 */
+	void calculate(const Estimate* root, const QHash<uint,Money>& actuals);
+
+	/**
+	 * Discards all calculated totals.
+	 */
+	void clear();
+
+	/**
+	 * Returns the number of estimates in the rollup.
+	 *
+	 * @return number of estimates
+	 */
+	int size() const;
+
+	/**
+	 * Returns the estimate at the given position in tree order.
+	 *
+	 * @param[in] position tree order position
+	 * @return estimate at the given position
+	 */
+	const Estimate* estimateAt(int position) const;
+
+	/**
+	 * Returns the tree order position of the given estimate.
+	 *
+	 * @param[in] estimateId estimate unique ID
+	 * @return tree order position, or -1 if the estimate is not in the rollup
+	 */
+	int positionOf(uint estimateId) const;
+
+	/**
+	 * Returns the total estimated amount of the estimate at the given
+	 * position, equivalent to `Estimate::totalEstimatedAmount()`.
+	 *
+	 * @param[in] position tree order position
+	 * @return total estimated amount of the estimate and its descendants
+	 */
+	Money totalEstimated(int position) const;
+
+	/**
+	 * Returns the total actual amount of the estimate at the given
+	 * position, equivalent to `Estimate::totalActualAmount()`.
+	 *
+	 * @param[in] position tree order position
+	 * @return total actual amount of the estimate's descendants
+	 */
+	Money totalActual(int position) const;
+
+	/**
+	 * Returns the progress of the estimate at the given position,
+	 * equivalent to `Estimate::progress()`.
+	 *
+	 * @param[in] position tree order position
+	 * @param[in] start    budgeting period start date
+	 * @return progress of the estimate
+	 */
+	Estimate::Progress progress(int position,
+		const QDate& start = QDate()) const;
+
+	/**
+	 * Returns the impact of the estimate at the given position,
+	 * equivalent to `Estimate::impact()`.
+	 *
+	 * @param[in] position tree order position
+	 * @return impact of the estimate
+	 */
+	Estimate::Impact impact(int position) const;
+
+private:
+	/**
+	 * Calculated totals of a single estimate.
+	 */
+	struct Entry
+	{
+		/** Estimate */
+		const Estimate* estimate;
+		/** Total estimated amount */
+		Money estimated;
+		/** Total actual amount */
+		Money actual;
+		/** Balance impact */
+		Estimate::Impact impact;
+	};
+
+	/** Calculated totals, in tree order */
+	QVector<Entry> entries;
+	/** Tree order positions, by estimate ID */
+	QHash<uint, int> positions;
+
+	/**
+	 * Calculates the totals of the given estimate, after those of all
+	 * of its children.
+	 *
+	 * @param[in] estimate estimate whose totals are to be calculated
+	 * @param[in] actuals  map of actual activity amounts
+	 * @return tree order position of the estimate
+	 */
+	int roll(const Estimate* estimate, const QHash<uint,Money>& actuals);
+};
+
+}
+
+#endif //ESTIMATEROLLUP_HPP
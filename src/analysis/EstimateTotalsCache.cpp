@@ -0,0 +1,236 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Qt include(s)
+#include <QtCore>
+
+// UnderBudget include(s)
+#include "analysis/Actuals.hpp"
+#include "analysis/EstimateTotalsCache.hpp"
+
+namespace ub {
+
+//------------------------------------------------------------------------------
+EstimateTotalsCache::EstimateTotalsCache(QSharedPointer<Estimate> root,
+		Actuals* actuals, QObject* parent)
+	: QObject(parent), root(root), actuals(actuals),
+	  actualsMap(actuals->map())
+{
+	connect(actuals, &Actuals::estimatesChanged,
+		this, &EstimateTotalsCache::actualsChanged);
+	listen(root.data());
+}
+
+//------------------------------------------------------------------------------
+void EstimateTotalsCache::listen(Estimate* estimate)
+{
+	connect(estimate, &Estimate::amountChanged,
+		this, &EstimateTotalsCache::amountChanged);
+	connect(estimate, &Estimate::childAdded,
+		this, &EstimateTotalsCache::childAdded);
+	connect(estimate, &Estimate::childRemoved,
+		this, &EstimateTotalsCache::childRemoved);
+	connect(estimate, &Estimate::childMoved,
+		this, &EstimateTotalsCache::childMoved);
+
+	for (int i=0; i<estimate->childCount(); ++i)
+	{
+		listen(estimate->childAt(i));
+	}
+}
+
+//------------------------------------------------------------------------------
+void EstimateTotalsCache::forget(Estimate* estimate)
+{
+	disconnect(estimate, 0, this, 0);
+	totals.remove(estimate);
+
+	for (int i=0; i<estimate->childCount(); ++i)
+	{
+		forget(estimate->childAt(i));
+	}
+}
+
+//------------------------------------------------------------------------------
+void EstimateTotalsCache::invalidate(const Estimate* estimate,
+	bool estimated, bool actual)
+{
+	// A discarded total implies discarded totals for all ancestors, so
+	// there is no need to continue once an already-discarded total is found
+	while (estimate)
+	{
+		QHash<const Estimate*, Totals>::iterator iter = totals.find(estimate);
+		if (iter == totals.end())
+			break;
+
+		bool changed = false;
+		if (estimated && iter->hasEstimated)
+		{
+			iter->hasEstimated = false;
+			changed = true;
+		}
+		if (actual && iter->hasActual)
+		{
+			iter->hasActual = false;
+			changed = true;
+		}
+
+		if ( ! changed)
+			break;
+
+		estimate = estimate->parentEstimate();
+	}
+}
+
+//------------------------------------------------------------------------------
+Money EstimateTotalsCache::totalEstimated(const Estimate* estimate) const
+{
+	Totals& memo = totals[estimate];
+	if ( ! memo.hasEstimated)
+	{
+		// Sum up in the same order as Estimate::totalEstimatedAmount()
+		Money sum(estimate->estimatedAmount());
+		for (int i=0; i<estimate->childCount(); ++i)
+		{
+			sum += totalEstimated(estimate->childAt(i));
+		}
+
+		// Look up again, since the recursion may have re-allocated
+		Totals& updated = totals[estimate];
+		updated.estimated = sum;
+		updated.hasEstimated = true;
+		return sum;
+	}
+
+	return memo.estimated;
+}
+
+//------------------------------------------------------------------------------
+Money EstimateTotalsCache::totalActual(const Estimate* estimate) const
+{
+	Totals& memo = totals[estimate];
+	if ( ! memo.hasActual)
+	{
+		// Sum up in the same order as Estimate::totalActualAmount()
+		Money sum;
+		if (estimate->isCategory())
+		{
+			for (int i=0; i<estimate->childCount(); ++i)
+			{
+				sum += totalActual(estimate->childAt(i));
+			}
+		}
+		else
+		{
+			sum = actualsMap.value(estimate->estimateId(), Money());
+		}
+
+		// Look up again, since the recursion may have re-allocated
+		Totals& updated = totals[estimate];
+		updated.actual = sum;
+		updated.hasActual = true;
+		return sum;
+	}
+
+	return memo.actual;
+}
+
+//------------------------------------------------------------------------------
+Estimate::Progress EstimateTotalsCache::progress(const Estimate* estimate,
+	const QDate& start) const
+{
+	if (estimate->isRoot())
+		return estimate->progress(Money(), Money(), start);
+	return estimate->progress(totalEstimated(estimate),
+		totalActual(estimate), start);
+}
+
+//------------------------------------------------------------------------------
+Estimate::Impact EstimateTotalsCache::impact(const Estimate* estimate) const
+{
+	return estimate->impact(actualsMap);
+}
+
+//------------------------------------------------------------------------------
+void EstimateTotalsCache::amountChanged()
+{
+	Estimate* estimate = qobject_cast<Estimate*>(sender());
+	if (estimate)
+	{
+		invalidate(estimate, true, false);
+	}
+}
+
+//------------------------------------------------------------------------------
+void EstimateTotalsCache::childAdded(Estimate* child, int index)
+{
+	Q_UNUSED(index);
+
+	listen(child);
+
+	Estimate* parent = qobject_cast<Estimate*>(sender());
+	if (parent)
+	{
+		invalidate(parent, true, true);
+	}
+}
+
+//------------------------------------------------------------------------------
+void EstimateTotalsCache::childRemoved(Estimate* child, int index)
+{
+	Q_UNUSED(index);
+
+	forget(child);
+
+	Estimate* parent = qobject_cast<Estimate*>(sender());
+	if (parent)
+	{
+		invalidate(parent, true, true);
+	}
+}
+
+//------------------------------------------------------------------------------
+void EstimateTotalsCache::childMoved(Estimate* child, int oldIndex,
+	int newIndex)
+{
+	Q_UNUSED(child);
+	Q_UNUSED(oldIndex);
+	Q_UNUSED(newIndex);
+
+	// Sums are order-dependent when currencies are converted
+	Estimate* parent = qobject_cast<Estimate*>(sender());
+	if (parent)
+	{
+		invalidate(parent, true, true);
+	}
+}
+
+//------------------------------------------------------------------------------
+void EstimateTotalsCache::actualsChanged(const QList<uint>& estimateIds)
+{
+	actualsMap = actuals->map();
+
+	for (int i=0; i<estimateIds.size(); ++i)
+	{
+		Estimate* estimate = root->find(estimateIds.at(i));
+		if (estimate)
+		{
+			invalidate(estimate, false, true);
+		}
+	}
+}
+
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ESTIMATETOTALSCACHE_HPP
+#define ESTIMATETOTALSCACHE_HPP
+
+// Qt include(s)
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSharedPointer>
+
+// UnderBudget include(s)
+#include "accounting/Money.hpp"
+#include "budget/Estimate.hpp"
+
+namespace ub {
+
+// Forward declaration(s)
+class Actuals;
+
+/**
+ * Memoized total estimated and actual amounts for every estimate in an
+ * estimate tree.
+ *
+ * Totals are calculated on demand and remembered until they are affected by
+ * a modification. When an estimate's amount changes, or when children are
+ * added to, removed from, or moved within an estimate, only the totals of
+ * that estimate and its ancestors are discarded. Likewise, when the actuals
+ * of specific estimates change, only the actual totals along the ancestor
+ * chains of those estimates are discarded.
+ *
+ * @ingroup analysis
+ */
+class EstimateTotalsCache : public QObject
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * Constructs a totals cache for the given estimate tree.
+	 *
+	 * @param[in] root    root of the estimate tree
+	 * @param[in] actuals estimate actuals
+	 * @param[in] parent  parent object
+	 */
+	EstimateTotalsCache(QSharedPointer<Estimate> root, Actuals* actuals,
+		QObject* parent = 0);
+
+	/**
+	 * Returns the total estimated amount of the given estimate,
+	 * equivalent to `Estimate::totalEstimatedAmount()`.
+	 *
+	 * @param[in] estimate estimate in the tree
+	 * @return total estimated amount of the estimate and its descendants
+	 */
+	Money totalEstimated(const Estimate* estimate) const;
+
+	/**
+	 * Returns the total actual amount of the given estimate,
+	 * equivalent to `Estimate::totalActualAmount()`.
+	 *
+	 * @param[in] estimate estimate in the tree
+	 * @return total actual amount of the estimate's descendants
+	 */
+	Money totalActual(const Estimate* estimate) const;
+
+	/**
+	 * Returns the progress of the given estimate, equivalent to
+	 * `Estimate::progress()`.
+	 *
+	 * @param[in] estimate estimate in the tree
+	 * @param[in] start    budgeting period start date
+	 * @return progress of the estimate
+	 */
+	Estimate::Progress progress(const Estimate* estimate,
+		const QDate& start = QDate()) const;
+
+	/**
+	 * Returns the impact of the given estimate, equivalent to
+	 * `Estimate::impact()`.
+	 *
+	 * @param[in] estimate estimate in the tree
+	 * @return impact of the estimate
+	 */
+	Estimate::Impact impact(const Estimate* estimate) const;
+
+private slots:
+	/**
+	 * Discards the estimated totals of the estimate whose amount
+	 * has changed, and of its ancestors.
+	 */
+	void amountChanged();
+
+	/**
+	 * Starts monitoring the added child estimate, and discards the totals
+	 * of its new parent and ancestors.
+	 *
+	 * @param[in] child new child estimate
+	 * @param[in] index index of the new child estimate
+	 */
+	void childAdded(Estimate* child, int index);
+
+	/**
+	 * Stops monitoring the removed child estimate, and discards the
+	 * totals of its old parent and ancestors.
+	 *
+	 * @param[in] child child estimate that was removed
+	 * @param[in] index old index of the child
+	 */
+	void childRemoved(Estimate* child, int index);
+
+	/**
+	 * Discards the totals of the estimate whose children were
+	 * re-ordered, and of its ancestors.
+	 *
+	 * @param[in] child    child estimate that was moved
+	 * @param[in] oldIndex old index of the child estimate
+	 * @param[in] newIndex new index of the child estimate
+	 */
+	void childMoved(Estimate* child, int oldIndex, int newIndex);
+
+	/**
+	 * Discards the actual totals of the given estimates, and of
+	 * their ancestors.
+	 *
+	 * @param[in] estimateIds unique IDs of estimates whose actuals changed
+	 */
+	void actualsChanged(const QList<uint>& estimateIds);
+
+private:
+	/**
+	 * Memoized totals of a single estimate.
+	 */
+	struct Totals
+	{
+		/** Whether the total estimated amount is up-to-date */
+		bool hasEstimated;
+		/** Total estimated amount */
+		Money estimated;
+		/** Whether the total actual amount is up-to-date */
+		bool hasActual;
+		/** Total actual amount */
+		Money actual;
+
+		/** Default constructor */
+		Totals()
+			: hasEstimated(false), hasActual(false)
+		{ }
+	};
+
+	/** Root of the estimate tree */
+	QSharedPointer<Estimate> root;
+	/** Estimate actuals */
+	Actuals* actuals;
+	/** Copy of the actual amounts, by estimate ID */
+	QHash<uint,Money> actualsMap;
+	/** Memoized totals, by estimate */
+	mutable QHash<const Estimate*, Totals> totals;
+
+	/**
+	 * Connects to the modification signals of the given estimate
+	 * and all of its descendants.
+	 *
+	 * @param[in] estimate estimate to be monitored
+	 */
+	void listen(Estimate* estimate);
+
+	/**
+	 * Disconnects from the modification signals of the given estimate
+	 * and all of its descendants, discarding their totals.
+	 *
+	 * @param[in] estimate estimate to no longer be monitored
+	 */
+	void forget(Estimate* estimate);
+
+	/**
+	 * Discards the memoized totals of the given estimate and all of its
+	 * ancestors.
+	 *
+	 * @param[in] estimate  estimate whose totals are affected
+	 * @param[in] estimated whether to discard the estimated totals
+	 * @param[in] actual    whether to discard the actual totals
+	 */
+	void invalidate(const Estimate* estimate, bool estimated, bool actual);
+};
+
+}
+
+#endif //ESTIMATETOTALSCACHE_HPP
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Qt include(s)
+#include <QQueue>
+
+// UnderBudget include(s)
+#include "analysis/PatternMatcher.hpp"
+
+namespace ub {
+
+//------------------------------------------------------------------------------
+PatternMatcher::PatternMatcher()
+{
+	clear();
+}
+
+//------------------------------------------------------------------------------
+void PatternMatcher::clear()
+{
+	nodes.clear();
+	createNode();
+}
+
+//------------------------------------------------------------------------------
+int PatternMatcher::createNode()
+{
+	Node node;
+	node.fail = 0;
+	node.output = -1;
+	nodes.append(node);
+	return nodes.size() - 1;
+}
+
+//------------------------------------------------------------------------------
+void PatternMatcher::add(const QString& pattern, int id)
+{
+	if (pattern.isEmpty())
+		return;
+
+	int current = 0;
+	for (int i=0; i<pattern.size(); ++i)
+	{
+		ushort ch = pattern.at(i).unicode();
+		int child = nodes.at(current).next.value(ch, -1);
+		if (child < 0)
+		{
+			child = createNode();
+			nodes[current].next.insert(ch, child);
+		}
+		current = child;
+	}
+
+	nodes[current].ids.append(id);
+}
+
+//------------------------------------------------------------------------------
+void PatternMatcher::build()
+{
+	// Breadth-first, so that the failure link of a node's parent is
+	// always known before that of the node itself
+	QQueue<int> queue;
+	QHashIterator<ushort, int> root(nodes.at(0).next);
+	while (root.hasNext())
+	{
+		root.next();
+		nodes[root.value()].fail = 0;
+		nodes[root.value()].output = -1;
+		queue.enqueue(root.value());
+	}
+
+	while ( ! queue.isEmpty())
+	{
+		int current = queue.dequeue();
+		QHashIterator<ushort, int> iter(nodes.at(current).next);
+		while (iter.hasNext())
+		{
+			iter.next();
+			ushort ch = iter.key();
+			int child = iter.value();
+
+			int fail = nodes.at(current).fail;
+			while (fail > 0 && ! nodes.at(fail).next.contains(ch))
+			{
+				fail = nodes.at(fail).fail;
+			}
+			fail = nodes.at(fail).next.value(ch, 0);
+
+			nodes[child].fail = fail;
+			nodes[child].output = nodes.at(fail).ids.isEmpty()
+				? nodes.at(fail).output : fail;
+			queue.enqueue(child);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+bool PatternMatcher::isEmpty() const
+{
+	return nodes.at(0).next.isEmpty();
+}
+
+//------------------------------------------------------------------------------
+void PatternMatcher::search(const QString& text, QVector<Hit>& hits) const
+{
+	if (isEmpty())
+		return;
+
+	int current = 0;
+	for (int i=0; i<text.size(); ++i)
+	{
+		ushort ch = text.at(i).unicode();
+		int child = nodes.at(current).next.value(ch, -1);
+		while (child < 0 && current > 0)
+		{
+			current = nodes.at(current).fail;
+			child = nodes.at(current).next.value(ch, -1);
+		}
+		current = (child < 0) ? 0 : child;
+
+		// Report all patterns ending at this position
+		int out = nodes.at(current).ids.isEmpty()
+			? nodes.at(current).output : current;
+		while (out > 0)
+		{
+			const QVector<int>& ids = nodes.at(out).ids;
+			for (int k=0; k<ids.size(); ++k)
+			{
+				Hit hit;
+				hit.id = ids.at(k);
+				hit.end = i + 1;
+				hits.append(hit);
+			}
+			out = nodes.at(out).output;
+		}
+	}
+}
+
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATTERNMATCHER_HPP
+#define PATTERNMATCHER_HPP
+
+// Qt include(s)
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+namespace ub {
+
+/**
+ * Multi-pattern string matcher, based on the Aho-Corasick algorithm.
+ *
+ * Any number of patterns can be added to the matcher, after which the
+ * matcher must be built before searching. A single pass over a text then
+ * reports every occurrence of every pattern within the text, in time
+ * proportional to the length of the text plus the number of occurrences.
+ *
+ * Each occurrence is reported with the end position of the match, so that
+ * callers can check for anchored (prefix, suffix, or exact) matches by
+ * comparing the position against the pattern length and the text length.
+ *
+ * @ingroup analysis
+ */
+class PatternMatcher
+{
+public:
+	/**
+	 * Occurrence of a pattern within a searched text.
+	 */
+	struct Hit
+	{
+		/** ID of the matched pattern */
+		int id;
+		/** Position in the text immediately after the match */
+		int end;
+	};
+
+	/**
+	 * Constructs an empty matcher.
+	 */
+	PatternMatcher();
+
+	/**
+	 * Removes all patterns from the matcher.
+	 */
+	void clear();
+
+	/**
+	 * Adds a pattern to the matcher. The same pattern may be added more
+	 * than once with different IDs. Empty patterns are ignored.
+	 *
+	 * @param[in] pattern pattern to be added
+	 * @param[in] id      ID to be reported for occurrences of the pattern
+	 */
+	void add(const QString& pattern, int id);
+
+	/**
+	 * Computes the failure links of all patterns. This must be called
+	 * after all patterns have been added and before searching.
+	 */
+	void build();
+
+	/**
+	 * Checks if any patterns have been added to the matcher.
+	 *
+	 * @return `true` if the matcher has no patterns
+	 */
+	bool isEmpty() const;
+
+	/**
+	 * Searches the given text for all occurrences of all patterns. Found
+	 * occurrences are appended to the given list.
+	 *
+	 * @param[in]  text text to be searched
+	 * @param[out] hits list to which found occurrences are appended
+	 */
+	void search(const QString& text, QVector<Hit>& hits) const;
+
+private:
+	/**
+	 * Trie node, representing a prefix of one or more patterns.
+	 */
+	struct Node
+	{
+		/** Child nodes, by character */
+		QHash<ushort, int> next;
+		/** Node of the longest proper suffix of this node's prefix */
+		int fail;
+		/** Nearest node along the failure links that ends a pattern */
+		int output;
+		/** IDs of the patterns ending at this node */
+		QVector<int> ids;
+	};
+
+	/** Trie nodes, with the root at index 0 */
+	QVector<Node> nodes;
+
+	/**
+	 * Creates a new node.
+	 *
+	 * @return index of the new node
+	 */
+	int createNode();
+};
+
+}
+
+#endif //PATTERNMATCHER_HPP
@@ -31,12 +31,36 @@ ProjectedBalance::ProjectedBalance(QSharedPointer<Balance> initial,
 		this, SIGNAL(balanceChanged()));
 }
 
+//------------------------------------------------------------------------------
+void ProjectedBalance::beginBatch()
+{
+	batch.begin();
+}
+
+//------------------------------------------------------------------------------
+void ProjectedBalance::endBatch()
+{
+	if (batch.end())
+	{
+		emit balanceChanged();
+	}
+}
+
+//------------------------------------------------------------------------------
+void ProjectedBalance::changed()
+{
+	if ( ! batch.defer())
+	{
+		emit balanceChanged();
+	}
+}
+
 //------------------------------------------------------------------------------
 void ProjectedBalance::clear()
 {
 	increase = Money();
 	decrease = Money();
-	emit balanceChanged();
+	changed();
 }
 
 //------------------------------------------------------------------------------
@@ -53,7 +77,7 @@ void ProjectedBalance::add(const Money& amount)
 			: increase + amount;
 	}
 
-	emit balanceChanged();
+	changed();
 }
 
 //------------------------------------------------------------------------------
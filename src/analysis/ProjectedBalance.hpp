@@ -23,6 +23,7 @@
 
 // UnderBudget include(s)
 #include "accounting/Money.hpp"
+#include "analysis/BatchedChanges.hpp"
 #include "budget/Balance.hpp"
 
 namespace ub {
@@ -47,6 +48,20 @@ public:
 	ProjectedBalance(QSharedPointer<Balance> initial = Balance::create(),
 		QObject* parent = 0);
 
+	/**
+	 * Opens a batch of modifications. Until the batch is closed, no
+	 * change notifications are emitted for individual modifications.
+	 *
+	 * @sa ChangeBatch
+	 */
+	void beginBatch();
+
+	/**
+	 * Closes a batch of modifications. If anything was modified during
+	 * the outermost batch, a single change notification is emitted.
+	 */
+	void endBatch();
+
 	/**
 	 * Removes all adjustments to the projected balance.
 	 */
@@ -108,6 +123,14 @@ private:
 	Money increase;
 	/** Decrease adjustment */
 	Money decrease;
+	/** Notifications deferred during the current batch */
+	BatchedChanges batch;
+
+	/**
+	 * Emits a change notification, or defers it until the end of the
+	 * current batch.
+	 */
+	void changed();
 };
 
 }
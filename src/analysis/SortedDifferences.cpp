@@ -27,11 +27,35 @@ SortedDifferences::SortedDifferences(QObject* parent)
 	: QObject(parent)
 { }
 
+//------------------------------------------------------------------------------
+void SortedDifferences::beginBatch()
+{
+	batch.begin();
+}
+
+//------------------------------------------------------------------------------
+void SortedDifferences::endBatch()
+{
+	if (batch.end())
+	{
+		emit listChanged();
+	}
+}
+
+//------------------------------------------------------------------------------
+void SortedDifferences::changed()
+{
+	if ( ! batch.defer())
+	{
+		emit listChanged();
+	}
+}
+
 //------------------------------------------------------------------------------
 void SortedDifferences::clear()
 {
 	entries.clear();
-	emit listChanged();
+	changed();
 }
 
 //------------------------------------------------------------------------------
@@ -41,14 +65,14 @@ void SortedDifferences::record(uint estimate, const Money& diff)
 	entry.estimate = estimate;
 	entry.difference = diff;
 	entries.append(entry);
-	emit listChanged();
+	changed();
 }
 
 //------------------------------------------------------------------------------
 void SortedDifferences::sort()
 {
 	qSort(entries);
-	emit listChanged();
+	changed();
 }
 
 //------------------------------------------------------------------------------
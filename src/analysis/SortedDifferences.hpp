@@ -23,6 +23,7 @@
 
 // UnderBudget include(s)
 #include "accounting/Money.hpp"
+#include "analysis/BatchedChanges.hpp"
 
 namespace ub {
 
@@ -44,6 +45,20 @@ public:
 	 */
 	SortedDifferences(QObject* parent = 0);
 
+	/**
+	 * Opens a batch of modifications. Until the batch is closed, no
+	 * change notifications are emitted for individual modifications.
+	 *
+	 * @sa ChangeBatch
+	 */
+	void beginBatch();
+
+	/**
+	 * Closes a batch of modifications. If anything was modified during
+	 * the outermost batch, a single change notification is emitted.
+	 */
+	void endBatch();
+
 	/**
 	 * Clears all recorded differences.
 	 */
@@ -112,6 +127,14 @@ private:
 
 	/** List of difference entries */
 	QList<DiffEntry> entries;
+	/** Notifications deferred during the current batch */
+	BatchedChanges batch;
+
+	/**
+	 * Emits a change notification, or defers it until the end of the
+	 * current batch.
+	 */
+	void changed();
 
 	/**
 	 * Checks if the first entry belongs "before" the second entry.
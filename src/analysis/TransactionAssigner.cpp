@@ -15,25 +15,174 @@
  */
 
 // Qt include(s)
+#include <QtConcurrent>
 #include <QtCore>
 
 // UnderBudget include(s)
 #include "analysis/Actuals.hpp"
 #include "analysis/Assignments.hpp"
+#include "analysis/ChangeBatch.hpp"
+#include "analysis/CompiledRules.hpp"
 #include "analysis/TransactionAssigner.hpp"
-#include "budget/conditions.hpp"
-#include "budget/AssignmentRule.hpp"
 #include "budget/AssignmentRules.hpp"
 #include "ledger/ImportedTransaction.hpp"
 
 namespace ub {
 
+//------------------------------------------------------------------------------
+static const int CHUNK_SIZE = 512;
+
+//------------------------------------------------------------------------------
+struct AssignmentChunk
+{
+	/** Pre-parsed assignment rules */
+	const CompiledRules* rules;
+	/** All transactions being assigned */
+	const TransactionStore* transactions;
+	/** Index of the first transaction in this chunk */
+	int begin;
+	/** Index after the last transaction in this chunk */
+	int end;
+	/** Index of the rule matched by each transaction in this chunk */
+	QVector<int> matches;
+};
+
+//------------------------------------------------------------------------------
+static void matchChunk(AssignmentChunk& chunk)
+{
+	chunk.matches.reserve(chunk.end - chunk.begin);
+	for (int i=chunk.begin; i<chunk.end; ++i)
+	{
+		chunk.matches.append(chunk.rules->match(
+			CompiledRules::Fields(*chunk.transactions, i)));
+	}
+}
+
+//------------------------------------------------------------------------------
+static bool sameFields(const TransactionStore& lhs, int lhsIndex,
+	const TransactionStore& rhs, int rhsIndex)
+{
+	return lhs.date(lhsIndex) == rhs.date(rhsIndex)
+		&& lhs.amount(lhsIndex) == rhs.amount(rhsIndex)
+		&& lhs.payee(lhsIndex) == rhs.payee(rhsIndex)
+		&& lhs.memo(lhsIndex) == rhs.memo(rhsIndex)
+		&& lhs.withdrawalAccount(lhsIndex) == rhs.withdrawalAccount(rhsIndex)
+		&& lhs.depositAccount(lhsIndex) == rhs.depositAccount(rhsIndex);
+}
+
+//------------------------------------------------------------------------------
+static void addTo(QHash<uint, Money>& amounts, uint estimateId,
+	const Money& amount)
+{
+	QHash<uint, Money>::iterator iter = amounts.find(estimateId);
+	if (iter != amounts.end())
+	{
+		*iter += amount;
+	}
+	else
+	{
+		amounts.insert(estimateId, amount);
+	}
+}
+
 //------------------------------------------------------------------------------
 TransactionAssigner::TransactionAssigner(QSharedPointer<AssignmentRules> rules,
 		Assignments* assignments, Actuals* actuals, QObject* parent)
-	: QObject(parent), rules(rules), assignments(assignments),
-	  actuals(actuals), isAssigning(false)
-{ }
+	: QObject(parent), rules(rules),
+	  compiled(new CompiledRules(rules, this)),
+	  assignments(assignments), actuals(actuals), isAssigning(false),
+	  parallel(true)
+{
+	connect(compiled, &CompiledRules::rulesChanged,
+		this, &TransactionAssigner::reassign);
+}
+
+//------------------------------------------------------------------------------
+void TransactionAssigner::setParallel(bool enabled)
+{
+	parallel = enabled;
+}
+
+//------------------------------------------------------------------------------
+bool TransactionAssigner::canParallelize(
+	const TransactionStore& transactions, int begin) const
+{
+	// Conversion rates are looked up without locking, so transactions
+	// of any currency can be matched in parallel
+	return parallel && transactions.size() - begin > CHUNK_SIZE
+		&& QThreadPool::globalInstance()->maxThreadCount() >= 2;
+}
+
+//------------------------------------------------------------------------------
+QVector<int> TransactionAssigner::match(const TransactionStore& transactions,
+	int begin, bool reportProgress)
+{
+	// Split transactions into chunks, each holding its own results
+	QVector<AssignmentChunk> chunks;
+	for (int first=begin; first<transactions.size(); first+=CHUNK_SIZE)
+	{
+		AssignmentChunk chunk;
+		chunk.rules = compiled;
+		chunk.transactions = &transactions;
+		chunk.begin = first;
+		chunk.end = qMin(first + CHUNK_SIZE, transactions.size());
+		chunks.append(chunk);
+	}
+
+	// Match chunks in waves, so progress can be reported in between
+	int wave = canParallelize(transactions, begin)
+		? QThreadPool::globalInstance()->maxThreadCount() * 4 : 1;
+	for (int first=0; first<chunks.size(); first+=wave)
+	{
+		int last = qMin(first + wave, chunks.size());
+		if (last - first > 1)
+		{
+			QtConcurrent::blockingMap(chunks.begin() + first,
+				chunks.begin() + last, matchChunk);
+		}
+		else
+		{
+			matchChunk(chunks[first]);
+		}
+
+		if (reportProgress)
+		{
+			emit progress(qint64(chunks.at(last - 1).end - begin) * 100
+				/ (transactions.size() - begin));
+		}
+	}
+
+	QVector<int> matches;
+	matches.reserve(transactions.size() - begin);
+	for (int c=0; c<chunks.size(); ++c)
+	{
+		matches += chunks.at(c).matches;
+	}
+	return matches;
+}
+
+//------------------------------------------------------------------------------
+void TransactionAssigner::collect(const TransactionStore& transactions,
+	int begin, const QVector<int>& matches, QHash<uint, Money>& amounts,
+	QHash<uint, uint>& estimates, QHash<uint, uint>& ruleIds) const
+{
+	// Reduce the results in transaction order, so that actuals are
+	// accumulated exactly as they would be one transaction at a time
+	for (int i=begin; i<transactions.size(); ++i)
+	{
+		// First matching rule wins
+		int index = matches.at(i - begin);
+		if (index < 0)
+			continue;
+
+		uint trnId = transactions.transactionId(i);
+		uint estimateId = compiled->estimateId(index);
+
+		addTo(amounts, estimateId, transactions.amount(i));
+		estimates.insert(trnId, estimateId);
+		ruleIds.insert(trnId, compiled->ruleId(index));
+	}
+}
 
 //------------------------------------------------------------------------------
 void TransactionAssigner::assign(const QList<ImportedTransaction>& transactions)
@@ -42,16 +191,25 @@ void TransactionAssigner::assign(const QList<ImportedTransaction>& transactions)
 	{
 		isAssigning = true;
 		emit started();
+		emit progress(0);
 
-		// Clear previous results
-		assignments->clear();
-		actuals->clear();
+		TransactionStore store(transactions);
+		QVector<int> matches = match(store, 0, true);
+
+		QHash<uint, Money> amounts;
+		QHash<uint, uint> estimates;
+		QHash<uint, uint> ruleIds;
+		collect(store, 0, matches, amounts, estimates, ruleIds);
 
-		// Iterate over all transactions
-		for (int i=0; i<transactions.size(); ++i)
 		{
-			assign(transactions.at(i));
+			// Only notify once both assignments and actuals are updated
+			ChangeBatch<Assignments> assignmentsBatch(assignments);
+			ChangeBatch<Actuals> actualsBatch(actuals);
+			assignments->replace(estimates, ruleIds);
+			actuals->replace(amounts);
 		}
+		this->transactions = store;
+		matched = matches;
 
 		isAssigning = false;
 		emit finished();
@@ -59,58 +217,237 @@ void TransactionAssigner::assign(const QList<ImportedTransaction>& transactions)
 }
 
 //------------------------------------------------------------------------------
-void TransactionAssigner::assign(const ImportedTransaction& transaction)
+void TransactionAssigner::stage(const QList<ImportedTransaction>& transactions)
+{
+	if (isAssigning || transactions.isEmpty())
+		return;
+
+	int begin = staged.size();
+	staged.append(transactions);
+	stagedMatched += match(staged, begin, false);
+}
+
+//------------------------------------------------------------------------------
+void TransactionAssigner::commitStaged()
 {
-	// Iterate over all rules
-	for (int i=0; i<rules->size(); ++i)
+	if (isAssigning)
+		return;
+
+	isAssigning = true;
+	emit started();
+	emit progress(0);
+
+	QHash<uint, Money> amounts;
+	QHash<uint, uint> estimates;
+	QHash<uint, uint> ruleIds;
+	collect(staged, 0, stagedMatched, amounts, estimates, ruleIds);
+
 	{
-		const AssignmentRule* rule = rules->at(i);
-		if (matches(transaction, rule))
-		{
-			actuals->record(rule->estimateId(), transaction.amount());
-			assignments->record(transaction.transactionId(),
-				rule->estimateId(), rule->ruleId());
-			break;
-		}
+		// Only notify once both assignments and actuals are updated
+		ChangeBatch<Assignments> assignmentsBatch(assignments);
+		ChangeBatch<Actuals> actualsBatch(actuals);
+		assignments->replace(estimates, ruleIds);
+		actuals->replace(amounts);
 	}
+	transactions = staged;
+	matched = stagedMatched;
+	staged.clear();
+	stagedMatched.clear();
+
+	isAssigning = false;
+	emit finished();
 }
 
 //------------------------------------------------------------------------------
-bool TransactionAssigner::matches(const ImportedTransaction& transaction,
-	const AssignmentRule* rule)
+void TransactionAssigner::discardStaged()
 {
-	bool trnMatches(true);
+	staged.clear();
+	stagedMatched.clear();
+}
 
-	// Iterate over all conditions
-	for (int k=0; k<rule->conditionCount(); ++k)
+//------------------------------------------------------------------------------
+void TransactionAssigner::update(const QList<ImportedTransaction>& transactions)
+{
+	if (isAssigning)
+		return;
+
+	if (this->transactions.isEmpty())
+	{
+		assign(transactions);
+		return;
+	}
+
+	isAssigning = true;
+	emit started();
+	emit progress(0);
+
+	const TransactionStore& previous = this->transactions;
+	TransactionStore store(transactions);
+
+	QHash<uint, int> previousIndices;
+	previousIndices.reserve(previous.size());
+	for (int i=0; i<previous.size(); ++i)
 	{
-		trnMatches &= matches(transaction, rule->conditionAt(k));
+		previousIndices.insert(previous.transactionId(i), i);
+	}
+
+	// Unchanged transactions keep their previous match, everything else
+	// is collected to be matched against the rules
+	QVector<int> newMatched(store.size(), -1);
+	QVector<bool> retained(previous.size(), false);
+	QVector<int> changedIndices;
+	TransactionStore changed;
+	for (int i=0; i<store.size(); ++i)
+	{
+		int index = previousIndices.value(store.transactionId(i), -1);
+		if (index >= 0 && ! retained.at(index)
+			&& sameFields(store, i, previous, index))
+		{
+			retained[index] = true;
+			newMatched[i] = matched.at(index);
+		}
+		else
+		{
+			changedIndices.append(i);
+			changed.append(store.at(i));
+		}
+	}
+
+	QHash<uint, Money> deltas;
+	QHash<uint, uint> estimates;
+	QHash<uint, uint> ruleIds;
+
+	// Withdraw the assignments of removed and modified transactions
+	for (int i=0; i<previous.size(); ++i)
+	{
+		if (retained.at(i))
+			continue;
+
+		uint trnId = previous.transactionId(i);
+		uint estimateId = assignments->estimate(trnId);
+		if (estimateId != 0)
+		{
+			addTo(deltas, estimateId, -previous.amount(i));
+			estimates.insert(trnId, 0);
+			ruleIds.insert(trnId, 0);
+		}
+	}
+
+	// Assign added and modified transactions
+	QVector<int> matches = match(changed, 0, true);
+	for (int i=0; i<changed.size(); ++i)
+	{
+		int index = matches.at(i);
+		newMatched[changedIndices.at(i)] = index;
+		if (index < 0)
+			continue;
+
+		uint trnId = changed.transactionId(i);
+		uint estimateId = compiled->estimateId(index);
+		addTo(deltas, estimateId, changed.amount(i));
+		estimates.insert(trnId, estimateId);
+		ruleIds.insert(trnId, compiled->ruleId(index));
 	}
 
-	return trnMatches;
+	if ( ! estimates.isEmpty())
+	{
+		// Only notify once both assignments and actuals are updated
+		ChangeBatch<Assignments> assignmentsBatch(assignments);
+		ChangeBatch<Actuals> actualsBatch(actuals);
+		assignments->reassign(estimates, ruleIds);
+		if ( ! deltas.isEmpty())
+		{
+			actuals->adjust(deltas);
+		}
+	}
+	this->transactions = store;
+	matched = newMatched;
+
+	isAssigning = false;
+	emit finished();
 }
 
 //------------------------------------------------------------------------------
-bool TransactionAssigner::matches(const ImportedTransaction& transaction,
-	const AssignmentRule::Condition& condition)
+void TransactionAssigner::reassign(int from)
 {
-	switch (condition.field)
-	{
-	case AssignmentRule::Date:
-		return qualifies(transaction.date(), condition);
-	case AssignmentRule::Amount:
-		return qualifies(transaction.amount(), condition);
-	case AssignmentRule::Payee:
-		return qualifies(transaction.payee(), condition);
-	case AssignmentRule::Memo:
-		return qualifies(transaction.memo(), condition);
-	case AssignmentRule::DepositAccount:
-		return qualifies(transaction.depositAccount(), condition);
-	case AssignmentRule::WithdrawalAccount:
-		return qualifies(transaction.withdrawalAccount(), condition);
-	default:
-		return false;
+	if (isAssigning)
+		return;
+
+	from = qMax(from, 0);
+
+	// Staged transactions are not assigned yet, so only their matches
+	// need to be brought up to date for when they are committed
+	for (int i=0; i<staged.size(); ++i)
+	{
+		if (stagedMatched.at(i) >= 0 && stagedMatched.at(i) < from)
+			continue;
+
+		stagedMatched[i] = compiled->match(CompiledRules::Fields(staged, i), from);
 	}
-}
+
+	if (transactions.isEmpty())
+		return;
+
+	isAssigning = true;
+	emit started();
+
+	QHash<uint, Money> deltas;
+	QHash<uint, uint> estimates;
+	QHash<uint, uint> ruleIds;
+
+	for (int i=0; i<transactions.size(); ++i)
+	{
+		// Rules before the modified rule are unchanged, so transactions
+		// they matched would still be matched by them. Any other
+		// transaction did not match those rules either, so only the
+		// modified rule and the ones after it need to be checked.
+		if (matched.at(i) >= 0 && matched.at(i) < from)
+			continue;
+
+		int index = compiled->match(CompiledRules::Fields(transactions, i), from);
+		matched[i] = index;
+
+		const Money& amount = transactions.amount(i);
+		uint trnId = transactions.transactionId(i);
+		uint oldEstimate = assignments->estimate(trnId);
+		uint oldRule = assignments->rule(trnId);
+		uint newEstimate = (index < 0) ? 0 : compiled->estimateId(index);
+		uint newRule = (index < 0) ? 0 : compiled->ruleId(index);
+
+		if (newEstimate != oldEstimate)
+		{
+			if (oldEstimate != 0)
+			{
+				addTo(deltas, oldEstimate, -amount);
+			}
+
+			if (newEstimate != 0)
+			{
+				addTo(deltas, newEstimate, amount);
+			}
+		}
+
+		if (newEstimate != oldEstimate || newRule != oldRule)
+		{
+			estimates.insert(trnId, newEstimate);
+			ruleIds.insert(trnId, newRule);
+		}
+	}
+
+	if ( ! estimates.isEmpty())
+	{
+		// Only notify once both assignments and actuals are updated
+		ChangeBatch<Assignments> assignmentsBatch(assignments);
+		ChangeBatch<Actuals> actualsBatch(actuals);
+		assignments->reassign(estimates, ruleIds);
+		if ( ! deltas.isEmpty())
+		{
+			actuals->adjust(deltas);
+		}
+	}
+
+	isAssigning = false;
+	emit finished();
 }
 
+}
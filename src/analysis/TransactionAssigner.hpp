@@ -18,12 +18,16 @@
 #define TRANSACTIONASSIGNER_HPP
 
 // Qt include(s)
+#include <QHash>
 #include <QList>
 #include <QObject>
 #include <QSharedPointer>
+#include <QVector>
 
 // UnderBudget include(s)
-#include "budget/AssignmentRule.hpp"
+#include "accounting/Money.hpp"
+#include "ledger/ImportedTransaction.hpp"
+#include "ledger/TransactionStore.hpp"
 
 namespace ub {
 
@@ -31,7 +35,7 @@ namespace ub {
 class Actuals;
 class Assignments;
 class AssignmentRules;
-class ImportedTransaction;
+class CompiledRules;
 
 /**
  * Assigns transactions to estimates according to the ordered
@@ -55,6 +59,16 @@ public:
 	TransactionAssigner(QSharedPointer<AssignmentRules> rules,
 		Assignments* assignments, Actuals* actuals, QObject* parent = 0);
 
+	/**
+	 * Enables or disables parallel assignment. When enabled, large
+	 * transaction lists are matched in chunks across the global thread
+	 * pool. The results are identical to a serial assignment. Parallel
+	 * assignment is enabled by default.
+	 *
+	 * @param[in] enabled whether to assign transactions in parallel
+	 */
+	void setParallel(bool enabled);
+
 public slots:
 	/**
 	 * Initiates an assignment of the given transactions to
@@ -64,6 +78,61 @@ public slots:
 	 */
 	void assign(const QList<ImportedTransaction>& transactions);
 
+	/**
+	 * Matches the given transactions against the assignment rules and
+	 * stages them, in addition to any previously staged transactions,
+	 * without modifying the current assignments or actuals. This allows
+	 * the transactions of an import to be matched as they are read, in
+	 * batches, while the results of the previous import remain in place
+	 * until the import has completed. No `started` or `finished` signals
+	 * are emitted.
+	 *
+	 * @param[in] transactions transactions to be staged
+	 */
+	void stage(const QList<ImportedTransaction>& transactions);
+
+	/**
+	 * Replaces the most recently assigned transactions, along with all
+	 * assignments and actuals, with the staged transactions. The staged
+	 * transactions are then cleared.
+	 */
+	void commitStaged();
+
+	/**
+	 * Discards the staged transactions, leaving the most recently
+	 * assigned transactions in place.
+	 */
+	void discardStaged();
+
+	/**
+	 * Replaces the most recently assigned transactions with the given
+	 * transactions, such as from a re-import of the same source.
+	 *
+	 * The transactions are compared with the previous transactions by
+	 * transaction ID. Only transactions that were added, or whose fields
+	 * were modified, are matched against the assignment rules. Assignments
+	 * of removed or modified transactions are withdrawn, and the actuals
+	 * are adjusted by the resulting differences rather than being
+	 * recalculated.
+	 *
+	 * @param[in] transactions new set of transactions
+	 */
+	void update(const QList<ImportedTransaction>& transactions);
+
+	/**
+	 * Re-assigns the most recently assigned transactions after a
+	 * modification of the assignment rules. Only transactions that were
+	 * unassigned or assigned by a rule at or after the given index are
+	 * re-evaluated, and the actuals are adjusted by the resulting
+	 * differences rather than being recalculated.
+	 *
+	 * This is performed automatically whenever the assignment rules
+	 * are modified.
+	 *
+	 * @param[in] from index of the first modified rule
+	 */
+	void reassign(int from);
+
 signals:
 	/**
 	 * Emitted when an assignment operation commences.
@@ -86,40 +155,61 @@ signals:
 private:
 	/** Assignment rules */
 	QSharedPointer<AssignmentRules> rules;
+	/** Pre-parsed assignment rules */
+	CompiledRules* compiled;
 	/** Transaction/estimate assignments */
 	Assignments* assignments;
 	/** Estimate actuals */
 	Actuals* actuals;
 	/** Whether the assigner is currently assigning */
 	bool isAssigning;
+	/** Whether parallel assignment is enabled */
+	bool parallel;
+	/** Most recently assigned transactions */
+	TransactionStore transactions;
+	/** Index of the rule matched by each transaction, or -1 */
+	QVector<int> matched;
+	/** Transactions staged to replace the assigned transactions */
+	TransactionStore staged;
+	/** Index of the rule matched by each staged transaction, or -1 */
+	QVector<int> stagedMatched;
 
 	/**
-	 * Assigns the given transaction, iterating over the list of
-	 * assignment rules for a match.
+	 * Checks if the given transactions, starting at the given index, can
+	 * be matched in parallel.
 	 *
-	 * @param[in] transaction transaction to be assigned
+	 * @param[in] transactions transactions to be assigned
+	 * @param[in] begin        index of the first transaction to be assigned
+	 * @return `true` if the transactions can be matched in parallel
 	 */
-	void assign(const ImportedTransaction& transaction);
+	bool canParallelize(const TransactionStore& transactions, int begin) const;
 
 	/**
-	 * Checks if the given transaction matches the given assignment
-	 * rule.
+	 * Searches for the first matching rule of each of the given
+	 * transactions, starting at the given index.
 	 *
-	 * @param[in] transaction transaction to be compared
-	 * @param[in] rule        assignment rule to be checked
+	 * @param[in] transactions   transactions to be matched
+	 * @param[in] begin          index of the first transaction to be matched
+	 * @param[in] reportProgress whether to emit progress signals
+	 * @return index of the rule matched by each transaction, or -1
 	 */
-	bool matches(const ImportedTransaction& transaction,
-		const AssignmentRule* rule);
+	QVector<int> match(const TransactionStore& transactions, int begin,
+		bool reportProgress);
 
 	/**
-	 * Checks if the given transaction qualifies for the given
-	 * assignment condition.
+	 * Accumulates the assignments and actual amounts resulting from the
+	 * given rule matches, in transaction order.
 	 *
-	 * @param[in] transaction transaction to be compared
-	 * @param[in] condition   assignment condition to be checked
+	 * @param[in]  transactions matched transactions
+	 * @param[in]  begin        index of the first matched transaction
+	 * @param[in]  matches      index of the rule matched by each transaction
+	 * @param[out] amounts      actual amounts, by estimate ID
+	 * @param[out] estimates    estimate IDs, by transaction ID
+	 * @param[out] ruleIds      assignment rule IDs, by transaction ID
 	 */
-	bool matches(const ImportedTransaction& transaction,
-		const AssignmentRule::Condition& condition);
+	void collect(const TransactionStore& transactions, int begin,
+		const QVector<int>& matches, QHash<uint, Money>& amounts,
+		QHash<uint, uint>& estimates, QHash<uint, uint>& ruleIds) const;
 };
 
 }
@@ -17,6 +17,12 @@
 #ifndef BALANCE_HPP
 #define BALANCE_HPP
 
+// Qt include(s)
+#include <QList>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+
 // UnderBudget include(s)
 #include "accounting/Money.hpp"
 
@@ -39,7 +39,7 @@ QSharedPointer<Estimate> Estimate::createRoot()
 
 //------------------------------------------------------------------------------
 Estimate::Estimate()
-	: paths(new QHash<uint, QList<int> >),
+	: estimatesById(new QHash<uint, Estimate*>),
 	  parent(0), id(0), name(tr("Root")), type(Root),
 	  dueDateOffset(-1), finished(false)
 { }
@@ -48,6 +48,12 @@ Estimate::Estimate()
 Estimate::~Estimate()
 {
 	qDeleteAll(children);
+
+	// Remove self from estimate map, unless already removed or replaced
+	if (estimatesById->value(id) == this)
+	{
+		estimatesById->remove(id);
+	}
 }
 
 //------------------------------------------------------------------------------
@@ -71,18 +77,17 @@ Estimate::Estimate(Estimate* parent, uint id,
 	parent->setDueDateOffset(-1);
 	parent->setFinishedState(false);
 
+	// Grab estimate map and add self to it
+	estimatesById = parent->estimatesById;
+	estimatesById->insert(id, this);
+
 	// Add self to parent's children
 	parent->addChild(this, index);
-
-	// Grab estimate path map
-	paths = parent->paths;
-	// Add self to estimate pointer map
-	paths->insert(id, path());
 }
 
 //------------------------------------------------------------------------------
 Estimate::Estimate(const Estimate& orig)
-	: paths(orig.paths), parent(orig.parent), id(orig.id),
+	: estimatesById(orig.estimatesById), parent(orig.parent), id(orig.id),
 	  name(orig.name), description(orig.description), type(orig.type),
 	  amount(orig.amount), dueDateOffset(orig.dueDateOffset),
 	  finished(orig.finished)
@@ -101,9 +106,6 @@ void Estimate::addChild(Estimate* child, int index)
 		children.append(child);
 	}
 
-	// Re-determine all paths for children under this estimate
-	repath();
-
 	emit childAdded(child, index);
 }
 
@@ -115,9 +117,6 @@ void Estimate::removeChild(Estimate* child, bool del)
 	{
 		children.removeOne(child);
 
-		// Re-determine all paths for children under this estimate
-		repath();
-
 		emit childRemoved(child, index);
 	}
 
@@ -141,9 +140,6 @@ void Estimate::moveChild(Estimate* child, int newIndex)
 	{
 		children.move(oldIndex, newIndex);
 
-		// Re-determine all paths for children under this estimate
-		repath();
-
 		emit childMoved(child, oldIndex, newIndex);
 	}
 }
@@ -157,57 +153,6 @@ Estimate* Estimate::root() const
 		return parent->root();
 }
 
-//------------------------------------------------------------------------------
-Estimate* Estimate::fromPath(const QList<int>& path) const
-{
-	if (path.size() == 0)
-		return 0;
-
-	Estimate* estimate = root();
-	int index;
-
-	foreach(index, path)
-	{
-		if ( ! estimate)
-		{
-			return 0;
-		}
-		else
-		{
-			estimate = estimate->childAt(index);
-		}
-	}
-
-	return estimate;
-}
-
-//------------------------------------------------------------------------------
-QList<int> Estimate::path() const
-{
-	QList<int> path;
-	Estimate* estimate = const_cast<Estimate*>(this);
-
-	// Work our way up the tree until we hit root
-	while ( ! estimate->isRoot())
-	{
-		path.insert(0, estimate->parentEstimate()->indexOf(estimate));
-		estimate = estimate->parentEstimate();
-	}
-
-	return path;
-}
-
-//------------------------------------------------------------------------------
-void Estimate::repath()
-{
-	for (int i=0; i<children.size(); ++i)
-	{
-		Estimate* child = children.at(i);
-		paths->insert(child->estimateId(), child->path());
-		child->repath();
-	}
-}
-
 //------------------------------------------------------------------------------
 bool Estimate::isRoot() const
 {
@@ -418,8 +363,8 @@ void Estimate::createChild(uint id, const QString& name,
 //------------------------------------------------------------------------------
 void Estimate::deleteSelf()
 {
-	// Remove self from estimate paths map
-	paths->remove(id);
+	// Remove self from estimate map
+	estimatesById->remove(id);
 
 	emit deleted();
 
@@ -462,12 +407,10 @@ void Estimate::moveTo(uint newParentId, int newIndex)
 	{
 		// Remove from old parent
 		parentEstimate()->removeChild(this);
-		paths->remove(id);
 
 		// Add to new parent
 		parent = newParent;
 		parentEstimate()->addChild(this, (newIndex < 0) ? 0 : newIndex);
-		paths->insert(id, path());
 	}
 	else
 	{
@@ -583,12 +526,24 @@ Estimate* Estimate::find(uint estimateId) const
 {
 	if (estimateId == 0)
 		return root();
-	return fromPath(paths->value(estimateId, QList<int>()));
+	return estimatesById->value(estimateId, 0);
 }
 
 //------------------------------------------------------------------------------
 Estimate::Progress Estimate::progress(const QHash<uint,Money>& actuals,
 	const QDate& start) const
+{
+	// Root is a special case, it is never populated
+	if (isRoot())
+		return progress(Money(), Money(), start);
+
+	// Get total/hierarchical values
+	return progress(totalEstimatedAmount(), totalActualAmount(actuals), start);
+}
+
+//------------------------------------------------------------------------------
+Estimate::Progress Estimate::progress(const Money& totalEstimated,
+	const Money& totalActual, const QDate& start) const
 {
 	Estimate::Progress progress;
 	progress.isHealthy = true;
@@ -596,9 +551,8 @@ Estimate::Progress Estimate::progress(const QHash<uint,Money>& actuals,
 	// Root is a special case, it is never populated
 	if ( ! isRoot())
 	{
-		// Get total/hierarchical values
-		progress.estimated = totalEstimatedAmount();
-		progress.actual = totalActualAmount(actuals);
+		progress.estimated = totalEstimated;
+		progress.actual = totalActual;
 
 		if (progress.actual.isZero() && (dueDateOffset >= 0))
 		{
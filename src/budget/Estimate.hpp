@@ -246,6 +246,19 @@ public:
 	Progress progress(const QHash<uint,Money>& actuals,
 		const QDate& start = QDate()) const;
 
+	/**
+	 * Returns the progress of this estimate, given the previously
+	 * calculated total estimated and actual amounts of this estimate
+	 * and all of its descendants.
+	 *
+	 * @param[in] totalEstimated total estimated amount
+	 * @param[in] totalActual    total actual amount
+	 * @param[in] start          budgeting period start date
+	 * @return progress of this estimate
+	 */
+	Progress progress(const Money& totalEstimated, const Money& totalActual,
+		const QDate& start = QDate()) const;
+
 	/**
 	 * Returns the impact of this estimate on the estimated, actual,
 	 * and expected ending balances.
@@ -612,18 +625,16 @@ signals:
 
 private:
 	/**
-	 * Pointer to shared map of estimate paths. As a shared pointer,
-	 * once all estimates have been deleted in an estimate tree, the
-	 * map itself will also be destroyed.
-	 *
-	 * Each entry in the map consists of a list of indices, starting
-	 * with the root estimate, necessary to reach a specific estimate.
+	 * Pointer to shared map of all estimates in the tree, by estimate ID.
+	 * As a shared pointer, once all estimates have been deleted in an
+	 * estimate tree, the map itself will also be destroyed.
 	 *
-	 * The map of paths is used to simplify searching for estimates
-	 * by ID. The path entry for an estimate must be updated whenever
-	 * the estimate is deleted or moved.
+	 * The map allows estimates to be found by ID without searching the
+	 * tree. An estimate adds itself to the map when it is created and
+	 * removes itself when it is deleted. Moving an estimate does not
+	 * affect the map. The root estimate is not in the map.
 	 */
-	QSharedPointer<QHash<uint, QList<int> > > paths;
+	QSharedPointer<QHash<uint, Estimate*> > estimatesById;
 
 	/** Parent estimate */
 	Estimate* parent;
@@ -694,35 +705,6 @@ private:
 	 */
 	Estimate* root() const;
 
-	/**
-	 * Returns the estimate located at the specified path.
-	 *
-	 * Starting with the root estimate for the current tree, use each
-	 * index entry in the path to traverse down the tree until
-	 * the estimate is found. If at any point, an invalid index is
-	 * specified (i.e., out of bounds) a null pointer is returned.
-	 * If the path contains no index entries, a null pointer is returned.
-	 *
-	 * @param[in] path estimate ID path
-	 * @return estimate at the specified path, or a null pointer if
-	 *         the estimate was not found or the path was invalid
-	 */
-	Estimate* fromPath(const QList<int>& path) const;
-
-	/**
-	 * Returns the path of this estimate, as a list of child indices,
-	 * starting with the root estimate.
-	 *
-	 * @return path to reach this estimate from the root estimate
-	 */
-	QList<int> path() const;
-
-	/**
-	 * Reinserts paths for all estimates under this estimate
-	 * into the path map.
-	 */
-	void repath();
-
 	/**
 	 * Checks if this estimate is the root estimate.
 	 *
@@ -0,0 +1,282 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Qt include(s)
+#include <QtCore>
+
+// UnderBudget include(s)
+#include "budget/AssignmentRule.hpp"
+#include "budget/AssignmentRules.hpp"
+#include "budget/Balance.hpp"
+#include "budget/Budget.hpp"
+#include "budget/BudgetingPeriod.hpp"
+#include "budget/Estimate.hpp"
+#include "budget/storage/BudgetChanges.hpp"
+
+namespace ub {
+
+//------------------------------------------------------------------------------
+BudgetChanges::BudgetChanges(QSharedPointer<Budget> budget, QObject* parent)
+	: QObject(parent), name(false), period(false), balance(false)
+{
+	connect(budget.data(), &Budget::nameChanged,
+		this, &BudgetChanges::recordNameChange);
+	connect(budget->budgetingPeriod().data(), &BudgetingPeriod::paramsChanged,
+		this, &BudgetChanges::recordPeriodChange);
+	connect(budget->initialBalance().data(), &Balance::valueChanged,
+		this, &BudgetChanges::recordBalanceChange);
+
+	listen(budget->estimates().data());
+
+	AssignmentRules* rules = budget->rules().data();
+	connect(rules, &AssignmentRules::ruleAdded,
+		this, &BudgetChanges::recordRuleAdded);
+	connect(rules, &AssignmentRules::ruleRemoved,
+		this, &BudgetChanges::recordRuleRemoved);
+	connect(rules, &AssignmentRules::ruleMoved,
+		this, &BudgetChanges::recordRuleMoved);
+	for (int i=0; i<rules->size(); ++i)
+	{
+		listen(rules->at(i));
+	}
+}
+
+//------------------------------------------------------------------------------
+void BudgetChanges::listen(Estimate* estimate)
+{
+	// Estimates may be re-added to the tree when moved, so make sure
+	// not to connect more than once
+	connect(estimate, &Estimate::nameChanged,
+		this, &BudgetChanges::recordEstimateChange, Qt::UniqueConnection);
+	connect(estimate, &Estimate::descriptionChanged,
+		this, &BudgetChanges::recordEstimateChange, Qt::UniqueConnection);
+	connect(estimate, &Estimate::typeChanged,
+		this, &BudgetChanges::recordEstimateChange, Qt::UniqueConnection);
+	connect(estimate, &Estimate::amountChanged,
+		this, &BudgetChanges::recordEstimateChange, Qt::UniqueConnection);
+	connect(estimate, &Estimate::dueDateOffsetChanged,
+		this, &BudgetChanges::recordEstimateChange, Qt::UniqueConnection);
+	connect(estimate, &Estimate::finishedStateChanged,
+		this, &BudgetChanges::recordEstimateChange, Qt::UniqueConnection);
+	connect(estimate, &Estimate::childAdded,
+		this, &BudgetChanges::recordChildAdded, Qt::UniqueConnection);
+	connect(estimate, &Estimate::childRemoved,
+		this, &BudgetChanges::recordChildRemoved, Qt::UniqueConnection);
+	connect(estimate, &Estimate::childMoved,
+		this, &BudgetChanges::recordChildMoved, Qt::UniqueConnection);
+
+	for (int i=0; i<estimate->childCount(); ++i)
+	{
+		listen(estimate->childAt(i));
+	}
+}
+
+//------------------------------------------------------------------------------
+void BudgetChanges::listen(AssignmentRule* rule)
+{
+	connect(rule, &AssignmentRule::conditionAdded,
+		this, &BudgetChanges::recordRuleChange, Qt::UniqueConnection);
+	connect(rule, &AssignmentRule::conditionRemoved,
+		this, &BudgetChanges::recordRuleChange, Qt::UniqueConnection);
+	connect(rule, &AssignmentRule::conditionUpdated,
+		this, &BudgetChanges::recordRuleChange, Qt::UniqueConnection);
+}
+
+//------------------------------------------------------------------------------
+void BudgetChanges::reset()
+{
+	name = false;
+	period = false;
+	balance = false;
+	estimateIds.clear();
+	ruleIds.clear();
+}
+
+//------------------------------------------------------------------------------
+bool BudgetChanges::nameChanged() const
+{
+	return name;
+}
+
+//------------------------------------------------------------------------------
+bool BudgetChanges::periodChanged() const
+{
+	return period;
+}
+
+//------------------------------------------------------------------------------
+bool BudgetChanges::balanceChanged() const
+{
+	return balance;
+}
+
+//------------------------------------------------------------------------------
+QSet<uint> BudgetChanges::estimates() const
+{
+	return estimateIds;
+}
+
+//------------------------------------------------------------------------------
+QSet<uint> BudgetChanges::rules() const
+{
+	return ruleIds;
+}
+
+//------------------------------------------------------------------------------
+void BudgetChanges::recordNameChange()
+{
+	name = true;
+}
+
+//------------------------------------------------------------------------------
+void BudgetChanges::recordPeriodChange()
+{
+	period = true;
+}
+
+//------------------------------------------------------------------------------
+void BudgetChanges::recordBalanceChange()
+{
+	balance = true;
+}
+
+//------------------------------------------------------------------------------
+void BudgetChanges::recordEstimateChange()
+{
+	Estimate* estimate = qobject_cast<Estimate*>(sender());
+	if (estimate)
+	{
+		estimateIds.insert(estimate->estimateId());
+	}
+}
+
+//------------------------------------------------------------------------------
+void BudgetChanges::recordChildAdded(Estimate* child, int index)
+{
+	listen(child);
+	recordTree(child);
+
+	// Siblings after the new child have been shifted down
+	Estimate* parent = qobject_cast<Estimate*>(sender());
+	if (parent)
+	{
+		recordChildren(parent, index + 1, parent->childCount() - 1);
+	}
+}
+
+//------------------------------------------------------------------------------
+void BudgetChanges::recordChildRemoved(Estimate* child, int index)
+{
+	recordTree(child);
+
+	// Siblings after the removed child have been shifted up
+	Estimate* parent = qobject_cast<Estimate*>(sender());
+	if (parent)
+	{
+		recordChildren(parent, index, parent->childCount() - 1);
+	}
+}
+
+//------------------------------------------------------------------------------
+void BudgetChanges::recordChildMoved(Estimate* child, int oldIndex,
+	int newIndex)
+{
+	Q_UNUSED(child)
+
+	Estimate* parent = qobject_cast<Estimate*>(sender());
+	if (parent)
+	{
+		recordChildren(parent, qMin(oldIndex, newIndex),
+			qMax(oldIndex, newIndex));
+	}
+}
+
+//------------------------------------------------------------------------------
+void BudgetChanges::recordRuleAdded(AssignmentRule* rule, int index)
+{
+	listen(rule);
+
+	AssignmentRules* rules = qobject_cast<AssignmentRules*>(sender());
+	if (rules)
+	{
+		recordRules(rules, index, rules->size() - 1);
+	}
+}
+
+//------------------------------------------------------------------------------
+void BudgetChanges::recordRuleRemoved(AssignmentRule* rule, int index)
+{
+	ruleIds.insert(rule->ruleId());
+
+	AssignmentRules* rules = qobject_cast<AssignmentRules*>(sender());
+	if (rules)
+	{
+		recordRules(rules, index, rules->size() - 1);
+	}
+}
+
+//------------------------------------------------------------------------------
+void BudgetChanges::recordRuleMoved(AssignmentRule* rule, int from, int to)
+{
+	Q_UNUSED(rule)
+
+	AssignmentRules* rules = qobject_cast<AssignmentRules*>(sender());
+	if (rules)
+	{
+		recordRules(rules, qMin(from, to), qMax(from, to));
+	}
+}
+
+//------------------------------------------------------------------------------
+void BudgetChanges::recordRuleChange()
+{
+	AssignmentRule* rule = qobject_cast<AssignmentRule*>(sender());
+	if (rule)
+	{
+		ruleIds.insert(rule->ruleId());
+	}
+}
+
+//------------------------------------------------------------------------------
+void BudgetChanges::recordTree(const Estimate* estimate)
+{
+	estimateIds.insert(estimate->estimateId());
+	for (int i=0; i<estimate->childCount(); ++i)
+	{
+		recordTree(estimate->childAt(i));
+	}
+}
+
+//------------------------------------------------------------------------------
+void BudgetChanges::recordChildren(const Estimate* parent, int from, int to)
+{
+	for (int i=qMax(from, 0); i<=to && i<parent->childCount(); ++i)
+	{
+		estimateIds.insert(parent->childAt(i)->estimateId());
+	}
+}
+
+//------------------------------------------------------------------------------
+void BudgetChanges::recordRules(const AssignmentRules* rules, int from, int to)
+{
+	for (int i=qMax(from, 0); i<=to && i<rules->size(); ++i)
+	{
+		ruleIds.insert(rules->at(i)->ruleId());
+	}
+}
+
+}
@@ -0,0 +1,241 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef BUDGETCHANGES_HPP
+#define BUDGETCHANGES_HPP
+
+// Qt include(s)
+#include <QObject>
+#include <QSet>
+#include <QSharedPointer>
+
+namespace ub {
+
+// Forward declaration(s)
+class AssignmentRule;
+class AssignmentRules;
+class Budget;
+class Estimate;
+
+/**
+ * Record of the parts of a budget that have been modified since the budget
+ * was last retrieved or stored.
+ *
+ * Every modification made through an undoable command, whether executed or
+ * undone, results in a modification signal from the budget, estimate, rule
+ * or balance that was modified. The changes are collected from those signals,
+ * so that a budget source can write only the modified entries. Estimates and
+ * rules whose position changed, as a result of a sibling being added,
+ * removed or moved, are recorded as modified as well.
+ *
+ * @ingroup budget_storage
+ */
+class BudgetChanges : public QObject
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * Constructs a record of changes to the given budget, initially empty.
+	 *
+	 * @param[in] budget budget to be monitored
+	 * @param[in] parent parent object
+	 */
+	BudgetChanges(QSharedPointer<Budget> budget, QObject* parent = 0);
+
+	/**
+	 * Discards all recorded changes.
+	 */
+	void reset();
+
+	/**
+	 * Checks if the name of the budget has been modified.
+	 *
+	 * @return `true` if the budget name has been modified
+	 */
+	bool nameChanged() const;
+
+	/**
+	 * Checks if the budgeting period has been modified.
+	 *
+	 * @return `true` if the budgeting period has been modified
+	 */
+	bool periodChanged() const;
+
+	/**
+	 * Checks if the initial balance has been modified.
+	 *
+	 * @return `true` if the initial balance has been modified
+	 */
+	bool balanceChanged() const;
+
+	/**
+	 * Returns the IDs of all estimates that have been added, modified,
+	 * moved, or removed. The estimate tree must be searched to determine
+	 * if an estimate still exists.
+	 *
+	 * @return IDs of modified estimates
+	 */
+	QSet<uint> estimates() const;
+
+	/**
+	 * Returns the IDs of all rules that have been added, modified,
+	 * moved, or removed. The rules list must be searched to determine
+	 * if a rule still exists.
+	 *
+	 * @return IDs of modified rules
+	 */
+	QSet<uint> rules() const;
+
+private slots:
+	/**
+	 * Records a modification of the budget name.
+	 */
+	void recordNameChange();
+
+	/**
+	 * Records a modification of the budgeting period.
+	 */
+	void recordPeriodChange();
+
+	/**
+	 * Records a modification of the initial balance.
+	 */
+	void recordBalanceChange();
+
+	/**
+	 * Records a modification of the estimate that emitted the
+	 * current signal.
+	 */
+	void recordEstimateChange();
+
+	/**
+	 * Records the added estimate, along with all of its children and
+	 * all siblings whose position has changed.
+	 *
+	 * @param[in] child added estimate
+	 * @param[in] index index of the added estimate
+	 */
+	void recordChildAdded(Estimate* child, int index);
+
+	/**
+	 * Records the removed estimate, along with all of its children and
+	 * all siblings whose position has changed.
+	 *
+	 * @param[in] child removed estimate
+	 * @param[in] index old index of the removed estimate
+	 */
+	void recordChildRemoved(Estimate* child, int index);
+
+	/**
+	 * Records all siblings whose position has changed as a result of
+	 * an estimate being moved.
+	 *
+	 * @param[in] child    moved estimate
+	 * @param[in] oldIndex old index of the moved estimate
+	 * @param[in] newIndex new index of the moved estimate
+	 */
+	void recordChildMoved(Estimate* child, int oldIndex, int newIndex);
+
+	/**
+	 * Records the added rule, along with all rules after it.
+	 *
+	 * @param[in] rule  added rule
+	 * @param[in] index index of the added rule
+	 */
+	void recordRuleAdded(AssignmentRule* rule, int index);
+
+	/**
+	 * Records the removed rule, along with all rules after it.
+	 *
+	 * @param[in] rule  removed rule
+	 * @param[in] index old index of the removed rule
+	 */
+	void recordRuleRemoved(AssignmentRule* rule, int index);
+
+	/**
+	 * Records all rules whose position has changed as a result of a
+	 * rule being moved.
+	 *
+	 * @param[in] rule moved rule
+	 * @param[in] from old index of the moved rule
+	 * @param[in] to   new index of the moved rule
+	 */
+	void recordRuleMoved(AssignmentRule* rule, int from, int to);
+
+	/**
+	 * Records a modification of the rule that emitted the current signal.
+	 */
+	void recordRuleChange();
+
+private:
+	/** Whether the budget name has been modified */
+	bool name;
+	/** Whether the budgeting period has been modified */
+	bool period;
+	/** Whether the initial balance has been modified */
+	bool balance;
+	/** IDs of modified estimates */
+	QSet<uint> estimateIds;
+	/** IDs of modified rules */
+	QSet<uint> ruleIds;
+
+	/**
+	 * Connects to the modification signals of the given estimate and
+	 * all of its children.
+	 *
+	 * @param[in] estimate estimate to be monitored
+	 */
+	void listen(Estimate* estimate);
+
+	/**
+	 * Connects to the modification signals of the given rule.
+	 *
+	 * @param[in] rule rule to be monitored
+	 */
+	void listen(AssignmentRule* rule);
+
+	/**
+	 * Records the given estimate and all of its children.
+	 *
+	 * @param[in] estimate modified estimate
+	 */
+	void recordTree(const Estimate* estimate);
+
+	/**
+	 * Records all children of the given estimate within the given range
+	 * of indices.
+	 *
+	 * @param[in] parent parent estimate
+	 * @param[in] from   index of the first child to be recorded
+	 * @param[in] to     index of the last child to be recorded
+	 */
+	void recordChildren(const Estimate* parent, int from, int to);
+
+	/**
+	 * Records all rules within the given range of indices.
+	 *
+	 * @param[in] rules rules list
+	 * @param[in] from  index of the first rule to be recorded
+	 * @param[in] to    index of the last rule to be recorded
+	 */
+	void recordRules(const AssignmentRules* rules, int from, int to);
+};
+
+}
+
+#endif //BUDGETCHANGES_HPP
@@ -16,28 +16,721 @@
 
 // Qt include(s)
 #include <QtCore>
+#include <QtSql>
 
 // UnderBudget include(s)
+#include "budget/AssignmentRule.hpp"
+#include "budget/AssignmentRules.hpp"
+#include "budget/Balance.hpp"
+#include "budget/BudgetingPeriod.hpp"
+#include "budget/Estimate.hpp"
+#include "budget/UIPrefs.hpp"
+#include "budget/storage/BudgetChanges.hpp"
 #include "budget/storage/SqlBudgetFile.hpp"
 
 namespace ub {
 
+//------------------------------------------------------------------------------
+// Version 1 stored amounts as floating point values, version 2 stores the
+// exact scaled integer amounts
+static const int schemaVersion = 2;
+
+//------------------------------------------------------------------------------
+static const char* createTableQueries[] = {
+	"CREATE TABLE IF NOT EXISTS properties "
+	"(key TEXT PRIMARY KEY, value);",
+	"CREATE TABLE IF NOT EXISTS period "
+	"(id INTEGER PRIMARY KEY, type INTEGER, "
+	"param1, param2, param3, param4);",
+	"CREATE TABLE IF NOT EXISTS contributors "
+	"(position INTEGER PRIMARY KEY, name TEXT, amount INTEGER, currency TEXT, "
+	"increase INTEGER);",
+	"CREATE TABLE IF NOT EXISTS estimates "
+	"(id INTEGER PRIMARY KEY, parent INTEGER, position INTEGER, name TEXT, "
+	"description TEXT, type INTEGER, amount INTEGER, currency TEXT, "
+	"due_date_offset INTEGER, finished INTEGER);",
+	"CREATE TABLE IF NOT EXISTS rules "
+	"(id INTEGER PRIMARY KEY, position INTEGER, estimate INTEGER);",
+	"CREATE TABLE IF NOT EXISTS conditions "
+	"(rule INTEGER, position INTEGER, field INTEGER, operator INTEGER, "
+	"sensitive INTEGER, value TEXT, PRIMARY KEY (rule, position));",
+	"CREATE TABLE IF NOT EXISTS prefs "
+	"(key TEXT PRIMARY KEY, value BLOB);",
+	0
+};
+
+//------------------------------------------------------------------------------
+// Tables are dropped so that they are re-created with the current schema
+static const char* clearTableQueries[] = {
+	"DROP TABLE IF EXISTS properties;",
+	"DROP TABLE IF EXISTS period;",
+	"DROP TABLE IF EXISTS contributors;",
+	"DROP TABLE IF EXISTS estimates;",
+	"DROP TABLE IF EXISTS rules;",
+	"DROP TABLE IF EXISTS conditions;",
+	"DROP TABLE IF EXISTS prefs;",
+	0
+};
+
+//------------------------------------------------------------------------------
+static const QString insertPropertyQuery =
+	"INSERT OR REPLACE INTO properties (key, value) VALUES (:key, :value);";
+static const QString insertPeriodQuery =
+	"INSERT OR REPLACE INTO period (id, type, param1, param2, param3, param4) "
+	"VALUES (0, :type, :param1, :param2, :param3, :param4);";
+static const QString insertContributorQuery =
+	"INSERT INTO contributors (position, name, amount, currency, increase) "
+	"VALUES (:position, :name, :amount, :currency, :increase);";
+static const QString insertEstimateQuery =
+	"INSERT OR REPLACE INTO estimates (id, parent, position, name, "
+	"description, type, amount, currency, due_date_offset, finished) "
+	"VALUES (:id, :parent, :position, :name, :description, :type, :amount, "
+	":currency, :offset, :finished);";
+static const QString removeEstimateQuery =
+	"DELETE FROM estimates WHERE id=:id;";
+static const QString insertRuleQuery =
+	"INSERT OR REPLACE INTO rules (id, position, estimate) "
+	"VALUES (:id, :position, :estimate);";
+static const QString removeRuleQuery =
+	"DELETE FROM rules WHERE id=:id;";
+static const QString insertConditionQuery =
+	"INSERT INTO conditions (rule, position, field, operator, sensitive, "
+	"value) VALUES (:rule, :position, :field, :operator, :sensitive, :value);";
+static const QString removeConditionsQuery =
+	"DELETE FROM conditions WHERE rule=:rule;";
+static const QString insertPrefQuery =
+	"INSERT INTO prefs (key, value) VALUES (:key, :value);";
+
+//------------------------------------------------------------------------------
+static const QString retrievePropertiesQuery =
+	"SELECT key, value FROM properties;";
+static const QString retrievePeriodQuery =
+	"SELECT type, param1, param2, param3, param4 FROM period WHERE id=0;";
+static const QString retrieveContributorsQuery =
+	"SELECT name, amount, currency, increase FROM contributors "
+	"ORDER BY position;";
+static const QString retrieveEstimatesQuery =
+	"SELECT id, parent, name, description, type, amount, currency, "
+	"due_date_offset, finished FROM estimates ORDER BY parent, position;";
+static const QString retrieveRulesQuery =
+	"SELECT id, estimate FROM rules ORDER BY position;";
+static const QString retrieveConditionsQuery =
+	"SELECT rule, field, operator, sensitive, value FROM conditions "
+	"ORDER BY rule, position;";
+static const QString retrievePrefsQuery =
+	"SELECT key, value FROM prefs;";
+
+//------------------------------------------------------------------------------
+static Money readAmount(const QVariant& amount, const QString& currency,
+	int version)
+{
+	return (version < 2) ? Money(amount.toDouble(), currency)
+		: Money::fromScaled(amount.toLongLong(), currency);
+}
+
+//------------------------------------------------------------------------------
+struct EstimateRow
+{
+	/** Estimate ID */
+	uint id;
+	/** Estimate name */
+	QString name;
+	/** Estimate description */
+	QString description;
+	/** Estimate type */
+	Estimate::Type type;
+	/** Estimated amount */
+	Money amount;
+	/** Due date offset */
+	int offset;
+	/** Finished state */
+	bool finished;
+};
+
+//------------------------------------------------------------------------------
+static void createChildren(Estimate* parent,
+	const QHash<uint, QList<EstimateRow> >& rows)
+{
+	QList<EstimateRow> children = rows.value(parent->estimateId());
+	for (int i=0; i<children.size(); ++i)
+	{
+		const EstimateRow& row = children.at(i);
+		Estimate* child = Estimate::create(parent, row.id, row.name,
+			row.description, row.type, row.amount, row.offset, row.finished);
+		createChildren(child, rows);
+	}
+}
+
+//------------------------------------------------------------------------------
+static void collect(const Estimate* estimate, QList<const Estimate*>& estimates)
+{
+	for (int i=0; i<estimate->childCount(); ++i)
+	{
+		estimates.append(estimate->childAt(i));
+		collect(estimate->childAt(i), estimates);
+	}
+}
+
 //------------------------------------------------------------------------------
 SqlBudgetFile::SqlBudgetFile(const QString& fileName)
-	: sqliteFile(fileName)
+	: sqliteFile(fileName),
+	  connection(QString("SqlBudgetFile-%1").arg(quintptr(this)))
 { }
 
+//------------------------------------------------------------------------------
+SqlBudgetFile::~SqlBudgetFile()
+{
+	if (QSqlDatabase::contains(connection))
+	{
+		QSqlDatabase::removeDatabase(connection);
+	}
+}
+
+//------------------------------------------------------------------------------
+QSqlDatabase SqlBudgetFile::open()
+{
+	// make sure connection is registered
+	QSqlDatabase db = QSqlDatabase::database(connection, false);
+	if ( ! db.isValid())
+	{
+		db = QSqlDatabase::addDatabase("QSQLITE", connection);
+		db.setDatabaseName(sqliteFile);
+	}
+
+	if ( ! db.isOpen() && ! db.open())
+	{
+		errorMsg = QObject::tr("File, %1, could not be opened.\n%2")
+			.arg(sqliteFile).arg(db.lastError().text());
+	}
+
+	return db;
+}
+
+//------------------------------------------------------------------------------
+bool SqlBudgetFile::execute(QSqlQuery& query)
+{
+	if ( ! query.exec())
+	{
+		errorMsg = QObject::tr("Error in file, %1.\n%2")
+			.arg(sqliteFile).arg(query.lastError().text());
+		return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------
+bool SqlBudgetFile::execute(QSqlDatabase& db, const QString& statement)
+{
+	QSqlQuery query(db);
+	query.prepare(statement);
+	return execute(query);
+}
+
 //------------------------------------------------------------------------------
 QSharedPointer<Budget> SqlBudgetFile::retrieve()
 {
-	QSharedPointer<Budget> budget(new Budget);
+	QSharedPointer<Budget> budget;
+	int version = 0;
+
+	// Opening a database that does not exist would create it
+	if ( ! QFile::exists(sqliteFile))
+	{
+		errorMsg = QObject::tr("File, %1, does not exist.").arg(sqliteFile);
+		return budget;
+	}
+
+	QSqlDatabase db = open();
+	if (db.isOpen())
+	{
+		budget = read(db, version);
+		db.close();
+	}
+
+	if (budget)
+	{
+		// Files in an older format are rewritten entirely when next stored
+		if (version == schemaVersion)
+		{
+			track(budget);
+		}
+		else
+		{
+			storedBudget.clear();
+			changes.clear();
+		}
+		errorMsg = "";
+	}
+
+	return budget;
+}
+
+//------------------------------------------------------------------------------
+QSharedPointer<Budget> SqlBudgetFile::read(QSqlDatabase& db, int& version)
+{
+	QSharedPointer<Budget> budget;
+
+	// Budget properties
+	QSqlQuery query(db);
+	query.prepare(retrievePropertiesQuery);
+	if ( ! execute(query))
+		return budget;
+
+	QHash<QString, QVariant> properties;
+	while (query.next())
+	{
+		properties.insert(query.value(0).toString(), query.value(1));
+	}
+
+	if ( ! properties.contains("version"))
+	{
+		errorMsg = QObject::tr("File, %1, is not a budget file.")
+			.arg(sqliteFile);
+		return budget;
+	}
+
+	version = properties.value("version").toInt();
+	if (version > schemaVersion)
+	{
+		errorMsg = QObject::tr("File, %1, was created by a newer version of "
+			"UnderBudget.").arg(sqliteFile);
+		return budget;
+	}
+
+	QString name = properties.value("name", "Budget").toString();
+
+	// Budgeting period
+	query.prepare(retrievePeriodQuery);
+	if ( ! execute(query))
+		return budget;
+
+	QSharedPointer<BudgetingPeriod> period(new BudgetingPeriod);
+	if (query.next())
+	{
+		BudgetingPeriod::Parameters params;
+		params.type = BudgetingPeriod::Type(query.value(0).toInt());
+		params.param1 = query.value(1);
+		params.param2 = query.value(2);
+		params.param3 = query.value(3);
+		params.param4 = query.value(4);
+		period = QSharedPointer<BudgetingPeriod>(new BudgetingPeriod(params));
+	}
+
+	// Initial balance
+	query.prepare(retrieveContributorsQuery);
+	if ( ! execute(query))
+		return budget;
+
+	QList<Balance::Contributor> contributors;
+	while (query.next())
+	{
+		contributors << Balance::Contributor(query.value(0).toString(),
+			readAmount(query.value(1), query.value(2).toString(), version),
+			query.value(3).toBool());
+	}
+	QSharedPointer<Balance> initial = contributors.isEmpty()
+		? Balance::create() : Balance::create(contributors);
+
+	// Estimates, grouped by parent in child order
+	query.prepare(retrieveEstimatesQuery);
+	if ( ! execute(query))
+		return budget;
+
+	QHash<uint, QList<EstimateRow> > estimateRows;
+	while (query.next())
+	{
+		EstimateRow row;
+		row.id = query.value(0).toUInt();
+		row.name = query.value(2).toString();
+		row.description = query.value(3).toString();
+		row.type = Estimate::Type(query.value(4).toInt());
+		row.amount = readAmount(query.value(5), query.value(6).toString(),
+			version);
+		row.offset = query.value(7).toInt();
+		row.finished = query.value(8).toBool();
+		estimateRows[query.value(1).toUInt()].append(row);
+	}
+
+	QSharedPointer<Estimate> root = Estimate::createRoot();
+	createChildren(root.data(), estimateRows);
+
+	// Rule conditions, grouped by rule in condition order
+	query.prepare(retrieveConditionsQuery);
+	if ( ! execute(query))
+		return budget;
+
+	QHash<uint, QList<AssignmentRule::Condition> > conditions;
+	while (query.next())
+	{
+		conditions[query.value(0).toUInt()].append(AssignmentRule::Condition(
+			AssignmentRule::Field(query.value(1).toInt()),
+			AssignmentRule::Operator(query.value(2).toInt()),
+			query.value(3).toBool(), query.value(4).toString()));
+	}
+
+	// Rules
+	query.prepare(retrieveRulesQuery);
+	if ( ! execute(query))
+		return budget;
+
+	QSharedPointer<AssignmentRules> rules = AssignmentRules::create();
+	while (query.next())
+	{
+		uint ruleId = query.value(0).toUInt();
+		rules->createRule(ruleId, query.value(1).toUInt(),
+			conditions.value(ruleId));
+	}
+
+	// UI preferences
+	query.prepare(retrievePrefsQuery);
+	if ( ! execute(query))
+		return budget;
+
+	QSharedPointer<UIPrefs> uiPrefs = UIPrefs::create();
+	while (query.next())
+	{
+		QByteArray bytes = query.value(1).toByteArray();
+		QDataStream stream(&bytes, QIODevice::ReadOnly);
+		QVariant value;
+		stream >> value;
+		uiPrefs->setValue(query.value(0).toString(), value);
+	}
+
+	budget = QSharedPointer<Budget>(
+		new Budget(name, period, initial, root, rules, uiPrefs));
 	return budget;
 }
 
 //------------------------------------------------------------------------------
 bool SqlBudgetFile::store(QSharedPointer<Budget> budget)
 {
-	return false;
+	QSqlDatabase db = open();
+	if ( ! db.isOpen())
+		return false;
+
+	// Only the modifications need to be written if this same budget
+	// was the last one retrieved from or stored to this file
+	bool incremental = changes && (storedBudget.toStrongRef() == budget);
+
+	bool ok = db.transaction();
+	if ( ! ok)
+	{
+		errorMsg = QObject::tr("Error in file, %1.\n%2")
+			.arg(sqliteFile).arg(db.lastError().text());
+	}
+
+	if (ok)
+	{
+		ok = incremental ? (createTables(db) && writeChanges(db, budget))
+			: writeAll(db, budget);
+
+		if (ok && ! db.commit())
+		{
+			errorMsg = QObject::tr("Error in file, %1.\n%2")
+				.arg(sqliteFile).arg(db.lastError().text());
+			ok = false;
+		}
+
+		if ( ! ok)
+		{
+			db.rollback();
+		}
+	}
+	db.close();
+
+	if (ok)
+	{
+		// Modifications are kept after a failure, to be written next time
+		if (incremental)
+		{
+			changes->reset();
+		}
+		else
+		{
+			track(budget);
+		}
+		errorMsg = "";
+	}
+
+	return ok;
+}
+
+//------------------------------------------------------------------------------
+void SqlBudgetFile::track(QSharedPointer<Budget> budget)
+{
+	storedBudget = budget;
+	changes = QSharedPointer<BudgetChanges>(new BudgetChanges(budget));
+}
+
+//------------------------------------------------------------------------------
+bool SqlBudgetFile::createTables(QSqlDatabase& db)
+{
+	for (int i=0; createTableQueries[i]; ++i)
+	{
+		if ( ! execute(db, createTableQueries[i]))
+			return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------
+bool SqlBudgetFile::writeAll(QSqlDatabase& db, QSharedPointer<Budget> budget)
+{
+	for (int i=0; clearTableQueries[i]; ++i)
+	{
+		if ( ! execute(db, clearTableQueries[i]))
+			return false;
+	}
+	if ( ! createTables(db))
+		return false;
+
+	QList<const Estimate*> estimates;
+	collect(budget->estimates().data(), estimates);
+
+	QSharedPointer<AssignmentRules> rules = budget->rules();
+	QList<int> indices;
+	for (int i=0; i<rules->size(); ++i)
+	{
+		indices.append(i);
+	}
+
+	return writeProperty(db, "version", schemaVersion)
+		&& writeProperty(db, "name", budget->name())
+		&& writePeriod(db, budget)
+		&& writeBalance(db, budget)
+		&& writePrefs(db, budget)
+		&& writeEstimates(db, estimates)
+		&& writeRules(db, rules, indices);
+}
+
+//------------------------------------------------------------------------------
+bool SqlBudgetFile::writeChanges(QSqlDatabase& db,
+	QSharedPointer<Budget> budget)
+{
+	if (changes->nameChanged() && ! writeProperty(db, "name", budget->name()))
+		return false;
+	if (changes->periodChanged() && ! writePeriod(db, budget))
+		return false;
+	if (changes->balanceChanged() && ! writeBalance(db, budget))
+		return false;
+
+	// UI preferences do not report modifications, so are always written
+	if ( ! writePrefs(db, budget))
+		return false;
+
+	// Modified estimates that are no longer in the tree have been removed
+	QSharedPointer<Estimate> root = budget->estimates();
+	QList<const Estimate*> estimates;
+	QList<uint> removedEstimates;
+	foreach (uint id, changes->estimates())
+	{
+		Estimate* estimate = root->find(id);
+		if (estimate && estimate != root.data())
+		{
+			estimates.append(estimate);
+		}
+		else
+		{
+			removedEstimates.append(id);
+		}
+	}
+
+	QSharedPointer<AssignmentRules> rules = budget->rules();
+	QList<int> indices;
+	QList<uint> removedRules;
+	foreach (uint id, changes->rules())
+	{
+		int index = rules->indexOf(id);
+		if (index >= 0)
+		{
+			indices.append(index);
+		}
+		else
+		{
+			removedRules.append(id);
+		}
+	}
+
+	return removeEstimates(db, removedEstimates)
+		&& writeEstimates(db, estimates)
+		&& removeRules(db, removedRules)
+		&& writeRules(db, rules, indices);
+}
+
+//------------------------------------------------------------------------------
+bool SqlBudgetFile::writeProperty(QSqlDatabase& db, const QString& key,
+	const QVariant& value)
+{
+	QSqlQuery query(db);
+	query.prepare(insertPropertyQuery);
+	query.bindValue(":key", key);
+	query.bindValue(":value", value);
+	return execute(query);
+}
+
+//------------------------------------------------------------------------------
+bool SqlBudgetFile::writePeriod(QSqlDatabase& db, QSharedPointer<Budget> budget)
+{
+	BudgetingPeriod::Parameters params = budget->budgetingPeriod()->parameters();
+
+	QSqlQuery query(db);
+	query.prepare(insertPeriodQuery);
+	query.bindValue(":type", int(params.type));
+	query.bindValue(":param1", params.param1);
+	query.bindValue(":param2", params.param2);
+	query.bindValue(":param3", params.param3);
+	query.bindValue(":param4", params.param4);
+	return execute(query);
+}
+
+//------------------------------------------------------------------------------
+bool SqlBudgetFile::writeBalance(QSqlDatabase& db, QSharedPointer<Budget> budget)
+{
+	if ( ! execute(db, "DELETE FROM contributors;"))
+		return false;
+
+	QSharedPointer<Balance> balance = budget->initialBalance();
+	QSqlQuery query(db);
+	query.prepare(insertContributorQuery);
+	for (int i=0; i<balance->contributorCount(); ++i)
+	{
+		Balance::Contributor contributor = balance->contributorAt(i);
+		query.bindValue(":position", i);
+		query.bindValue(":name", contributor.name);
+		query.bindValue(":amount", contributor.amount.scaled());
+		query.bindValue(":currency", contributor.amount.currency().code());
+		query.bindValue(":increase", contributor.increase);
+		if ( ! execute(query))
+			return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------
+bool SqlBudgetFile::writePrefs(QSqlDatabase& db, QSharedPointer<Budget> budget)
+{
+	if ( ! execute(db, "DELETE FROM prefs;"))
+		return false;
+
+	// Values are serialized so that any variant type can be restored
+	QSharedPointer<UIPrefs> uiPrefs = budget->uiPreferences();
+	QStringList keys = uiPrefs->allKeys();
+	QSqlQuery query(db);
+	query.prepare(insertPrefQuery);
+	for (int i=0; i<keys.size(); ++i)
+	{
+		QByteArray bytes;
+		QDataStream stream(&bytes, QIODevice::WriteOnly);
+		stream << uiPrefs->value(keys.at(i));
+
+		query.bindValue(":key", keys.at(i));
+		query.bindValue(":value", bytes);
+		if ( ! execute(query))
+			return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------
+bool SqlBudgetFile::writeEstimates(QSqlDatabase& db,
+	const QList<const Estimate*>& estimates)
+{
+	QSqlQuery query(db);
+	query.prepare(insertEstimateQuery);
+	for (int i=0; i<estimates.size(); ++i)
+	{
+		const Estimate* estimate = estimates.at(i);
+		Estimate* parent = estimate->parentEstimate();
+		Money amount = estimate->estimatedAmount();
+
+		query.bindValue(":id", estimate->estimateId());
+		query.bindValue(":parent", parent->estimateId());
+		query.bindValue(":position",
+			parent->indexOf(const_cast<Estimate*>(estimate)));
+		query.bindValue(":name", estimate->estimateName());
+		query.bindValue(":description", estimate->estimateDescription());
+		query.bindValue(":type", int(estimate->estimateType()));
+		query.bindValue(":amount", amount.scaled());
+		query.bindValue(":currency", amount.currency().code());
+		query.bindValue(":offset", estimate->activityDueDateOffset());
+		query.bindValue(":finished", estimate->isActivityFinished());
+		if ( ! execute(query))
+			return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------
+bool SqlBudgetFile::removeEstimates(QSqlDatabase& db, const QList<uint>& ids)
+{
+	QSqlQuery query(db);
+	query.prepare(removeEstimateQuery);
+	for (int i=0; i<ids.size(); ++i)
+	{
+		query.bindValue(":id", ids.at(i));
+		if ( ! execute(query))
+			return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------
+bool SqlBudgetFile::writeRules(QSqlDatabase& db,
+	QSharedPointer<AssignmentRules> rules, const QList<int>& indices)
+{
+	QSqlQuery ruleQuery(db);
+	ruleQuery.prepare(insertRuleQuery);
+	QSqlQuery removeQuery(db);
+	removeQuery.prepare(removeConditionsQuery);
+	QSqlQuery conditionQuery(db);
+	conditionQuery.prepare(insertConditionQuery);
+
+	for (int i=0; i<indices.size(); ++i)
+	{
+		const AssignmentRule* rule = rules->at(indices.at(i));
+
+		ruleQuery.bindValue(":id", rule->ruleId());
+		ruleQuery.bindValue(":position", indices.at(i));
+		ruleQuery.bindValue(":estimate", rule->estimateId());
+		if ( ! execute(ruleQuery))
+			return false;
+
+		// Conditions are re-written, as their positions may have changed
+		removeQuery.bindValue(":rule", rule->ruleId());
+		if ( ! execute(removeQuery))
+			return false;
+
+		for (int c=0; c<rule->conditionCount(); ++c)
+		{
+			AssignmentRule::Condition condition = rule->conditionAt(c);
+			conditionQuery.bindValue(":rule", rule->ruleId());
+			conditionQuery.bindValue(":position", c);
+			conditionQuery.bindValue(":field", int(condition.field));
+			conditionQuery.bindValue(":operator", int(condition.op));
+			conditionQuery.bindValue(":sensitive", condition.sensitive);
+			conditionQuery.bindValue(":value", condition.value);
+			if ( ! execute(conditionQuery))
+				return false;
+		}
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------
+bool SqlBudgetFile::removeRules(QSqlDatabase& db, const QList<uint>& ids)
+{
+	QSqlQuery ruleQuery(db);
+	ruleQuery.prepare(removeRuleQuery);
+	QSqlQuery conditionQuery(db);
+	conditionQuery.prepare(removeConditionsQuery);
+
+	for (int i=0; i<ids.size(); ++i)
+	{
+		ruleQuery.bindValue(":id", ids.at(i));
+		conditionQuery.bindValue(":rule", ids.at(i));
+		if ( ! execute(ruleQuery) || ! execute(conditionQuery))
+			return false;
+	}
+	return true;
 }
 
 //------------------------------------------------------------------------------
@@ -53,4 +746,3 @@ QString SqlBudgetFile::location() const
 }
 
 }
-
@@ -17,14 +17,35 @@
 #ifndef SQLBUDGETFILE_HPP
 #define SQLBUDGETFILE_HPP
 
+// Qt include(s)
+#include <QList>
+#include <QSharedPointer>
+#include <QWeakPointer>
+
 // UnderBudget include(s)
 #include "budget/storage/BudgetSource.hpp"
 
+// Forward declaration(s)
+class QSqlDatabase;
+class QSqlQuery;
+
 namespace ub {
 
+// Forward declaration(s)
+class AssignmentRules;
+class BudgetChanges;
+
 /**
  * A budget source for budgets stored in an Sqlite database file.
  *
+ * Estimates, rules, rule conditions, initial balance contributors, the
+ * budgeting period, and UI preferences are each stored in their own table.
+ * The first time a budget is stored to the file, all tables are written.
+ * Afterwards, the budget is monitored for modifications, and subsequent
+ * stores of the same budget only write the rows of the estimates and rules
+ * that have been modified since the last store. Every store is performed
+ * within a single database transaction.
+ *
  * @ingroup budget_storage
  */
 class SqlBudgetFile : public BudgetSource {
@@ -36,6 +57,11 @@ public:
 	 */
 	SqlBudgetFile(const QString& fileName);
 
+	/**
+	 * Closes the database connection.
+	 */
+	~SqlBudgetFile();
+
 	// Implemented base methods
 	QSharedPointer<Budget> retrieve();
 	bool store(QSharedPointer<Budget> budget);
@@ -45,8 +71,161 @@ public:
 private:
 	/** Sqlite budget file name */
 	const QString sqliteFile;
+	/** Database connection name */
+	const QString connection;
 	/** Last error message */
 	QString errorMsg;
+	/** Budget most recently retrieved from or stored to the file */
+	QWeakPointer<Budget> storedBudget;
+	/** Modifications to the stored budget since it was retrieved or stored */
+	QSharedPointer<BudgetChanges> changes;
+
+	/**
+	 * Opens the database connection.
+	 *
+	 * @return database connection, which is not open if an error occurred
+	 */
+	QSqlDatabase open();
+
+	/**
+	 * Executes the given query, recording the error message if the
+	 * query fails.
+	 *
+	 * @param[in] query query to be executed
+	 * @return `true` if the query was successfully executed
+	 */
+	bool execute(QSqlQuery& query);
+
+	/**
+	 * Executes the given statement, recording the error message if the
+	 * statement fails.
+	 *
+	 * @param[in] db        database connection
+	 * @param[in] statement statement to be executed
+	 * @return `true` if the statement was successfully executed
+	 */
+	bool execute(QSqlDatabase& db, const QString& statement);
+
+	/**
+	 * Creates all tables that do not yet exist.
+	 *
+	 * @param[in] db database connection
+	 * @return `true` if successful
+	 */
+	bool createTables(QSqlDatabase& db);
+
+	/**
+	 * Writes the entire budget, replacing any previous contents and
+	 * re-creating all tables with the current schema.
+	 *
+	 * @param[in] db     database connection
+	 * @param[in] budget budget to be written
+	 * @return `true` if successful
+	 */
+	bool writeAll(QSqlDatabase& db, QSharedPointer<Budget> budget);
+
+	/**
+	 * Writes the modifications to the budget since it was last retrieved
+	 * or stored.
+	 *
+	 * @param[in] db     database connection
+	 * @param[in] budget budget to be written
+	 * @return `true` if successful
+	 */
+	bool writeChanges(QSqlDatabase& db, QSharedPointer<Budget> budget);
+
+	/**
+	 * Writes a budget property.
+	 *
+	 * @param[in] db    database connection
+	 * @param[in] key   property key
+	 * @param[in] value property value
+	 * @return `true` if successful
+	 */
+	bool writeProperty(QSqlDatabase& db, const QString& key,
+		const QVariant& value);
+
+	/**
+	 * Writes the budgeting period.
+	 *
+	 * @param[in] db     database connection
+	 * @param[in] budget budget whose budgeting period is to be written
+	 * @return `true` if successful
+	 */
+	bool writePeriod(QSqlDatabase& db, QSharedPointer<Budget> budget);
+
+	/**
+	 * Writes all initial balance contributors.
+	 *
+	 * @param[in] db     database connection
+	 * @param[in] budget budget whose initial balance is to be written
+	 * @return `true` if successful
+	 */
+	bool writeBalance(QSqlDatabase& db, QSharedPointer<Budget> budget);
+
+	/**
+	 * Writes all UI preferences.
+	 *
+	 * @param[in] db     database connection
+	 * @param[in] budget budget whose UI preferences are to be written
+	 * @return `true` if successful
+	 */
+	bool writePrefs(QSqlDatabase& db, QSharedPointer<Budget> budget);
+
+	/**
+	 * Writes the given estimates.
+	 *
+	 * @param[in] db        database connection
+	 * @param[in] estimates estimates to be written
+	 * @return `true` if successful
+	 */
+	bool writeEstimates(QSqlDatabase& db,
+		const QList<const Estimate*>& estimates);
+
+	/**
+	 * Removes the estimates with the given IDs.
+	 *
+	 * @param[in] db  database connection
+	 * @param[in] ids IDs of the estimates to be removed
+	 * @return `true` if successful
+	 */
+	bool removeEstimates(QSqlDatabase& db, const QList<uint>& ids);
+
+	/**
+	 * Writes the rules at the given indices, along with their conditions.
+	 *
+	 * @param[in] db      database connection
+	 * @param[in] rules   rules list
+	 * @param[in] indices indices of the rules to be written
+	 * @return `true` if successful
+	 */
+	bool writeRules(QSqlDatabase& db, QSharedPointer<AssignmentRules> rules,
+		const QList<int>& indices);
+
+	/**
+	 * Removes the rules with the given IDs, along with their conditions.
+	 *
+	 * @param[in] db  database connection
+	 * @param[in] ids IDs of the rules to be removed
+	 * @return `true` if successful
+	 */
+	bool removeRules(QSqlDatabase& db, const QList<uint>& ids);
+
+	/**
+	 * Reads the budget from the database.
+	 *
+	 * @param[in]  db      database connection
+	 * @param[out] version schema version of the file
+	 * @return retrieved budget, or a null pointer if an error occurred
+	 */
+	QSharedPointer<Budget> read(QSqlDatabase& db, int& version);
+
+	/**
+	 * Begins monitoring the given budget for modifications.
+	 *
+	 * @param[in] budget budget to be monitored
+	 */
+	void track(QSharedPointer<Budget> budget);
 };
 
 }
@@ -20,14 +20,34 @@
 // UnderBudget include(s)
 #include "budget/storage/XmlBudgetFile.hpp"
 #include "budget/storage/XmlBudgetWriter.hpp"
+#include "gzip/GZipFile.hpp"
 
 namespace ub {
 
 //------------------------------------------------------------------------------
 XmlBudgetFile::XmlBudgetFile(const QString& fileName)
-	: xmlFile(fileName)
+	: xmlFile(fileName), compressed(fileName.endsWith(".gz")),
+	  compressionLevel(-1)
 { }
 
+//------------------------------------------------------------------------------
+void XmlBudgetFile::setCompressed(bool enabled)
+{
+	compressed = enabled;
+}
+
+//------------------------------------------------------------------------------
+bool XmlBudgetFile::isCompressed() const
+{
+	return compressed;
+}
+
+//------------------------------------------------------------------------------
+void XmlBudgetFile::setCompressionLevel(int level)
+{
+	compressionLevel = level;
+}
+
 //------------------------------------------------------------------------------
 QSharedPointer<Budget> XmlBudgetFile::retrieve()
 {
@@ -36,7 +56,28 @@ QSharedPointer<Budget> XmlBudgetFile::retrieve()
 	QFile file(xmlFile);
 	if (file.open(QIODevice::ReadOnly))
 	{
-		if (reader.read(&file))
+		// Keep storing the budget in the same format as the existing file
+		compressed = GZipFile::isGZip(file);
+
+		// Decompress while reading, rather than decompressing the whole
+		// file into memory first
+		GZipFile gzipFile(xmlFile);
+		QIODevice* device = &file;
+		if (compressed)
+		{
+			file.close();
+			gzipFile.setReadAhead(true);
+			device = &gzipFile;
+
+			if ( ! gzipFile.open(QIODevice::ReadOnly))
+			{
+				errorMsg = QObject::tr("File, %1, could not be decompressed.")
+					.arg(xmlFile);
+				return budget;
+			}
+		}
+
+		if (reader.read(device))
 		{
 			budget = reader.lastReadBudget();
 			errorMsg = "";
@@ -60,11 +101,49 @@ QSharedPointer<Budget> XmlBudgetFile::retrieve()
 //------------------------------------------------------------------------------
 bool XmlBudgetFile::store(QSharedPointer<Budget> budget)
 {
+	if (compressed)
+	{
+		// The XML is compressed as it is written
+		GZipFile file(xmlFile);
+		file.setCompressionLevel(compressionLevel);
+		if (file.open(QIODevice::WriteOnly))
+		{
+			errorMsg = QObject::tr("Unknown error writing to XML file.");
+			bool written = XmlBudgetWriter::write(&file, budget);
+
+			// Buffered data and the gzip trailer are written when closed
+			if ( ! file.finish())
+			{
+				errorMsg = QObject::tr("File, %1, could not be written.\n%2")
+					.arg(xmlFile)
+					.arg(file.errorString());
+				return false;
+			}
+			return written;
+		}
+		else
+		{
+			errorMsg = QObject::tr("File, %1, could not be written.")
+				.arg(xmlFile);
+			return false;
+		}
+	}
+
 	QFile file(xmlFile);
 	if (file.open(QIODevice::WriteOnly))
 	{
 		errorMsg = QObject::tr("Unknown error writing to XML file.");
-		return XmlBudgetWriter::write(&file, budget);
+		bool written = XmlBudgetWriter::write(&file, budget);
+
+		// Buffered data is only written when flushed
+		if ( ! file.flush())
+		{
+			errorMsg = QObject::tr("File, %1, could not be written.\n%2")
+				.arg(xmlFile)
+				.arg(file.errorString());
+			return false;
+		}
+		return written;
 	}
 	else
 	{
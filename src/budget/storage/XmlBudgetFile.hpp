@@ -28,6 +28,12 @@ namespace ub {
 /**
  * A budget source for budgets stored in an XML file.
  *
+ * The XML file may be gzip-compressed. Compressed files are detected by
+ * their content rather than their name when the budget is retrieved, and
+ * are written back compressed when the budget is stored. New files are
+ * compressed if their name ends with `.gz` or if compression has been
+ * explicitly enabled.
+ *
  * @ingroup budget_storage
  */
 class XmlBudgetFile : public BudgetSource {
@@ -39,6 +45,30 @@ public:
 	 */
 	XmlBudgetFile(const QString& fileName);
 
+	/**
+	 * Enables or disables compression of the stored XML. Retrieving the
+	 * budget from the file will override this setting according to
+	 * whether the existing file is compressed.
+	 *
+	 * @param[in] enabled whether to compress the stored XML
+	 */
+	void setCompressed(bool enabled);
+
+	/**
+	 * Returns whether the XML is stored compressed.
+	 *
+	 * @return `true` if the XML is stored compressed
+	 */
+	bool isCompressed() const;
+
+	/**
+	 * Sets the compression level used when storing compressed XML, from
+	 * 1 (fastest) to 9 (smallest).
+	 *
+	 * @param[in] level compression level, or -1 for the default level
+	 */
+	void setCompressionLevel(int level);
+
 	// Implemented base methods
 	QSharedPointer<Budget> retrieve();
 	bool store(QSharedPointer<Budget> budget);
@@ -50,6 +80,10 @@ private:
 	XmlBudgetReader reader;
 	/** XML budget file name */
 	const QString xmlFile;
+	/** Whether the XML is gzip-compressed */
+	bool compressed;
+	/** Compression level for storing compressed XML */
+	int compressionLevel;
 	/** Last error message */
 	QString errorMsg;
 };
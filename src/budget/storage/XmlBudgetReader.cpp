@@ -35,11 +35,14 @@ bool XmlBudgetReader::read(QIODevice* device)
 {
 	budget.reset();
 	xml.setDevice(device);
+	defaultCurrency = Currency::byLocale();
+	lastCurrencyCode = QString();
+	lastCurrency = Currency(lastCurrencyCode);
 
 	// Go through all top-level elements
 	if (xml.readNextStartElement())
 	{
-		if (xml.name() == "budget")
+		if (element() == BudgetElement)
 		{
 			QString version = xml.attributes().value("version").toString();
 			if (version == "4.0")
@@ -76,6 +79,123 @@ QString XmlBudgetReader::errorString() const
 	}
 }
 
+//------------------------------------------------------------------------------
+XmlBudgetReader::Element XmlBudgetReader::element() const
+{
+	struct ElementName
+	{
+		QLatin1String name;
+		Element element;
+	};
+
+	// Ordered by how often the elements occur in a typical budget
+	static const ElementName names[] = {
+		{ QLatin1String("estimate"), EstimateElement },
+		{ QLatin1String("name"), NameElement },
+		{ QLatin1String("amount"), AmountElement },
+		{ QLatin1String("type"), TypeElement },
+		{ QLatin1String("description"), DescriptionElement },
+		{ QLatin1String("due-date-offset"), DueDateOffsetElement },
+		{ QLatin1String("finished"), FinishedElement },
+		{ QLatin1String("estimates"), EstimatesElement },
+		{ QLatin1String("complete"), CompleteElement },
+		{ QLatin1String("due-date"), DueDateElement },
+		{ QLatin1String("day"), DayElement },
+		{ QLatin1String("month"), MonthElement },
+		{ QLatin1String("year"), YearElement },
+		{ QLatin1String("rule"), RuleElement },
+		{ QLatin1String("condition"), ConditionElement },
+		{ QLatin1String("field"), FieldElement },
+		{ QLatin1String("operator"), OperatorElement },
+		{ QLatin1String("value"), ValueElement },
+		{ QLatin1String("case-sensitive"), CaseSensitiveElement },
+		{ QLatin1String("conditions"), ConditionsElement },
+		{ QLatin1String("contributor"), ContributorElement },
+		{ QLatin1String("increase"), IncreaseElement },
+		{ QLatin1String("rules"), RulesElement },
+		{ QLatin1String("budget"), BudgetElement },
+		{ QLatin1String("period"), PeriodElement },
+		{ QLatin1String("param1"), Param1Element },
+		{ QLatin1String("param2"), Param2Element },
+		{ QLatin1String("start-date"), StartDateElement },
+		{ QLatin1String("end-date"), EndDateElement },
+		{ QLatin1String("initial-balance"), InitialBalanceElement },
+	};
+	static const int count = sizeof(names) / sizeof(names[0]);
+
+	// The local name refers to the reader's own buffer, and is compared
+	// without being copied into a new string
+	QStringRef name = xml.name();
+	for (int i=0; i<count; ++i)
+	{
+		if (names[i].name.size() == name.size() && names[i].name == name)
+			return names[i].element;
+	}
+
+	return UnknownElement;
+}
+
+//------------------------------------------------------------------------------
+const QString& XmlBudgetReader::readText()
+{
+	Q_ASSERT(xml.isStartElement());
+
+	// Re-use the allocated buffer from the previous element
+	text.resize(0);
+
+	while ( ! xml.atEnd())
+	{
+		switch (xml.readNext())
+		{
+		case QXmlStreamReader::Characters:
+		case QXmlStreamReader::EntityReference:
+			text.append(xml.text());
+			break;
+
+		case QXmlStreamReader::EndElement:
+			return text;
+
+		case QXmlStreamReader::StartElement:
+			xml.raiseError(QObject::tr("Expected character data."));
+			return text;
+
+		default:
+			break;
+		}
+	}
+
+	return text;
+}
+
+//------------------------------------------------------------------------------
+bool XmlBudgetReader::readBool()
+{
+	const QString& value = readText();
+	return ! (value.isEmpty() || value == QLatin1String("0")
+		|| value.compare(QLatin1String("false"), Qt::CaseInsensitive) == 0);
+}
+
+//------------------------------------------------------------------------------
+Currency XmlBudgetReader::currencyFor(const QStringRef& code)
+{
+	if (code != lastCurrencyCode)
+	{
+		lastCurrencyCode = code.toString();
+		lastCurrency = Currency(lastCurrencyCode);
+	}
+
+	return lastCurrency;
+}
+
+//------------------------------------------------------------------------------
+Money XmlBudgetReader::readMoney()
+{
+	// Currency must be read before the attributes are invalidated
+	// by reading the element text
+	Currency currency = currencyFor(xml.attributes().value(QLatin1String("currency")));
+	return Money(readText().toDouble(), currency);
+}
+
 //------------------------------------------------------------------------------
 void XmlBudgetReader::readVersion4()
 {
@@ -93,31 +213,30 @@ void XmlBudgetReader::readVersion4()
 	// Go through all elements under a budget element
 	while (xml.readNextStartElement())
 	{
-		if (xml.name() == "name")
+		switch (element())
 		{
+		case NameElement:
 			name = xml.readElementText();
-		}
-		else if (xml.name() == "period")
-		{
+			break;
+
+		case PeriodElement:
 			readVersion4Period(period);
-		}
-		else if (xml.name() == "initial-balance")
-		{
-			QString currency = xml.attributes().value("currency").toString();
-			QVariant amount = xml.readElementText();
-			initial = Balance::create(Money(amount.toDouble(), currency));
-		}
-		else if (xml.name() == "estimate")
-		{
+			break;
+
+		case InitialBalanceElement:
+			initial = Balance::create(readMoney());
+			break;
+
+		case EstimateElement:
 			// Go through all elements belonging to the root estimate
 			while (xml.readNextStartElement())
 			{
-				if (xml.name() == "estimates")
+				if (element() == EstimatesElement)
 				{
 					// Go through all elements belonging to the root estimate's estimates
 					while (xml.readNextStartElement())
 					{
-						if (xml.name() == "estimate")
+						if (element() == EstimateElement)
 							readVersion4Estimate(root.data(), period->startDate());
 						else
 							xml.skipCurrentElement();
@@ -126,20 +245,22 @@ void XmlBudgetReader::readVersion4()
 				else
 					xml.skipCurrentElement();
 			}
-		}
-		else if (xml.name() == "rules")
-		{
+			break;
+
+		case RulesElement:
 			// Go through all rule elements
 			while (xml.readNextStartElement())
 			{
-				if (xml.name() == "rule")
+				if (element() == RuleElement)
 					readVersion4Rule(rules);
 				else
 					xml.skipCurrentElement();
 			}
-		}
-		else
+			break;
+
+		default:
 			xml.skipCurrentElement();
+		}
 	}
 
 	if ( ! xml.error())
@@ -166,42 +287,45 @@ void XmlBudgetReader::readVersion5()
 	// Go through all elements under a budget element
 	while (xml.readNextStartElement())
 	{
-		if (xml.name() == "name")
+		switch (element())
 		{
+		case NameElement:
 			name = xml.readElementText();
-		}
-		else if (xml.name() == "period")
-		{
+			break;
+
+		case PeriodElement:
 			readVersion5Period(period);
-		}
-		else if (xml.name() == "initial-balance")
-		{
+			break;
+
+		case InitialBalanceElement:
 			readVersion5Balance(initial);
-		}
-		else if (xml.name() == "estimate")
-		{
+			break;
+
+		case EstimateElement:
 			// Go through all elements belonging to the root estimate
 			while (xml.readNextStartElement())
 			{
-				if (xml.name() == "estimate")
+				if (element() == EstimateElement)
 					readVersion5Estimate(root.data());
 				else
 					xml.skipCurrentElement();
 			}
-		}
-		else if (xml.name() == "rules")
-		{
+			break;
+
+		case RulesElement:
 			// Go through all rule elements
 			while (xml.readNextStartElement())
 			{
-				if (xml.name() == "rule")
+				if (element() == RuleElement)
 					readVersion5Rule(rules);
 				else
 					xml.skipCurrentElement();
 			}
-		}
-		else
+			break;
+
+		default:
 			xml.skipCurrentElement();
+		}
 	}
 
 	if ( ! xml.error())
@@ -231,28 +355,29 @@ void XmlBudgetReader::readVersion4Period(QSharedPointer<BudgetingPeriod>& period
 	// Go through all elements under a budgeting period
 	while (xml.readNextStartElement())
 	{
-		if (xml.name() == "year")
+		switch (element())
 		{
+		case YearElement:
 			// Year always goes in param 1
-			int year = QVariant(xml.readElementText()).toInt();
-			parameters.param1 = year;
-		}
-		else if (xml.name() == "month")
-		{
+			parameters.param1 = readText().toInt();
+			break;
+
+		case MonthElement:
 			// Month always goes in param 2
-			int month = QVariant(xml.readElementText()).toInt() + 1;
-			parameters.param2 = month;
-		}
-		else if (xml.name() == "start-date")
-		{
+			parameters.param2 = readText().toInt() + 1;
+			break;
+
+		case StartDateElement:
 			parameters.param1 = readDate(true);
-		}
-		else if (xml.name() == "end-date")
-		{
+			break;
+
+		case EndDateElement:
 			parameters.param2 = readDate(true);
-		}
-		else
+			break;
+
+		default:
 			xml.skipCurrentElement();
+		}
 	}
 
 	period = QSharedPointer<BudgetingPeriod>(new BudgetingPeriod(parameters));
@@ -261,13 +386,13 @@ void XmlBudgetReader::readVersion4Period(QSharedPointer<BudgetingPeriod>& period
 //------------------------------------------------------------------------------
 BudgetingPeriod::Type periodTypeFrom(const QString& type)
 {
-	if (type == "custom")
+	if (type == QLatin1String("custom"))
 		return BudgetingPeriod::CustomDateRange;
-	else if (type == "paydate-month")
+	else if (type == QLatin1String("paydate-month"))
 		return BudgetingPeriod::PaydateMonth;
-	else if (type == "calendar-month")
+	else if (type == QLatin1String("calendar-month"))
 		return BudgetingPeriod::CalendarMonth;
-	else if (type == "calendar-year")
+	else if (type == QLatin1String("calendar-year"))
 		return BudgetingPeriod::CalendarYear;
 	else
 		return BudgetingPeriod::Undefined;
@@ -285,16 +410,19 @@ void XmlBudgetReader::readVersion5Period(QSharedPointer<BudgetingPeriod>& period
 	// Go through all elements under a budgeting period
 	while (xml.readNextStartElement())
 	{
-		if (xml.name() == "param1")
+		switch (element())
 		{
+		case Param1Element:
 			parameters.param1 = QVariant(xml.readElementText());
-		}
-		else if (xml.name() == "param2")
-		{
+			break;
+
+		case Param2Element:
 			parameters.param2 = QVariant(xml.readElementText());
-		}
-		else
+			break;
+
+		default:
 			xml.skipCurrentElement();
+		}
 	}
 
 	// Validate all parsed parameters according to the defined period type
@@ -355,25 +483,30 @@ void XmlBudgetReader::readVersion5Balance(QSharedPointer<Balance>& balance)
 	// Go through all elements under a balance
 	while (xml.readNextStartElement())
 	{
-		if (xml.name() == "contributor")
+		if (element() == ContributorElement)
 		{
 			Balance::Contributor contributor;
 
 			// Go through all elements under a contributor
 			while (xml.readNextStartElement())
 			{
-				if (xml.name() == "name")
-					contributor.name = xml.readElementText();
-				else if (xml.name() == "amount")
+				switch (element())
 				{
-					QString currency = xml.attributes().value("currency").toString();
-					QVariant amount = xml.readElementText();
-					contributor.amount = Money(amount.toDouble(), currency);
-				}
-				else if (xml.name() == "increase")
-					contributor.increase = QVariant(xml.readElementText()).toBool();
-				else
+				case NameElement:
+					contributor.name = xml.readElementText();
+					break;
+
+				case AmountElement:
+					contributor.amount = readMoney();
+					break;
+
+				case IncreaseElement:
+					contributor.increase = readBool();
+					break;
+
+				default:
 					xml.skipCurrentElement();
+				}
 			}
 
 			contributors << contributor;
@@ -393,19 +526,26 @@ QDate XmlBudgetReader::readDate(bool januaryIsZero)
 	// Go through all elements under a date
 	while (xml.readNextStartElement())
 	{
-		if (xml.name() == "day")
-			day = QVariant(xml.readElementText()).toInt();
-		else if (xml.name() == "month")
+		switch (element())
 		{
-			month = QVariant(xml.readElementText()).toInt();
+		case DayElement:
+			day = readText().toInt();
+			break;
+
+		case MonthElement:
+			month = readText().toInt();
 
 			if (januaryIsZero)
 				month++;
-		}
-		else if (xml.name() == "year")
-			year = QVariant(xml.readElementText()).toInt();
-		else
+			break;
+
+		case YearElement:
+			year = readText().toInt();
+			break;
+
+		default:
 			xml.skipCurrentElement();
+		}
 	}
 
 	return QDate(year, month, day);
@@ -416,38 +556,44 @@ void XmlBudgetReader::readVersion4Estimate(Estimate* parent, const QDate& start)
 {
 	Q_ASSERT(xml.isStartElement() && xml.name() == "estimate");
 
-	uint id = QVariant(xml.attributes().value("id").toString()).toUInt();
+	uint id = xml.attributes().value(QLatin1String("id")).toUInt();
 	QString name;
 	QString description;
 	Estimate::Type type;
-	Money amount;
+	Money amount(0.0, defaultCurrency);
 	int dueDateOffset = -1;
 	bool finished;
 
 	// Go through all elements under an estimate
 	while (xml.readNextStartElement())
 	{
-		if (xml.name() == "name")
+		switch (element())
+		{
+		case NameElement:
 			name = xml.readElementText();
-		else if (xml.name() == "description")
+			break;
+
+		case DescriptionElement:
 			description = xml.readElementText();
-		else if (xml.name() == "amount")
-		{
-			QString currency = xml.attributes().value("currency").toString();
-			QVariant amt = xml.readElementText();
-			amount = Money(amt.toDouble(), currency);
-		}
-		else if (xml.name() == "type")
+			break;
+
+		case AmountElement:
+			amount = readMoney();
+			break;
+
+		case TypeElement:
 		{
-			QString typeStr = xml.readElementText();
-			if (typeStr == "INCOME")
+			const QString& typeStr = readText();
+			if (typeStr == QLatin1String("INCOME"))
 				type = Estimate::Income;
-			else if (typeStr == "TRANSFER")
+			else if (typeStr == QLatin1String("TRANSFER"))
 				type = Estimate::Transfer;
 			else
 				type = Estimate::Expense;
+			break;
 		}
-		else if (xml.name() == "due-date")
+
+		case DueDateElement:
 		{
 			QDate dueDate = readDate(true);
 			dueDateOffset = start.daysTo(dueDate);
@@ -458,10 +604,14 @@ void XmlBudgetReader::readVersion4Estimate(Estimate* parent, const QDate& start)
 					<< "), reverting to start date (0 offset)";
 				dueDateOffset = 0;
 			}
+			break;
 		}
-		else if (xml.name() == "complete")
-			finished = QVariant(xml.readElementText()).toBool();
-		else if (xml.name() == "estimates")
+
+		case CompleteElement:
+			finished = readBool();
+			break;
+
+		case EstimatesElement:
 		{
 			// According to the v4.0 spec, all estimate attributes have been
 			// defined by now, so we can create the estimate
@@ -471,14 +621,17 @@ void XmlBudgetReader::readVersion4Estimate(Estimate* parent, const QDate& start)
 			// Go through all estimate elements
 			while (xml.readNextStartElement())
 			{
-				if (xml.name() == "estimate")
+				if (element() == EstimateElement)
 					readVersion4Estimate(child, start);
 				else
 					xml.skipCurrentElement();
 			}
+			break;
 		}
-		else
+
+		default:
 			xml.skipCurrentElement();
+		}
 	}
 }
 
@@ -487,11 +640,11 @@ void XmlBudgetReader::readVersion5Estimate(Estimate* parent)
 {
 	Q_ASSERT(xml.isStartElement() && xml.name() == "estimate");
 
-	uint id = QVariant(xml.attributes().value("id").toString()).toUInt();
+	uint id = xml.attributes().value(QLatin1String("id")).toUInt();
 	QString name;
 	QString description;
 	Estimate::Type type = parent->estimateType();
-	Money amount;
+	Money amount(0.0, defaultCurrency);
 	int dueDateOffset = -1;
 	bool finished(false);
 	Estimate* estimate = 0;
@@ -499,37 +652,42 @@ void XmlBudgetReader::readVersion5Estimate(Estimate* parent)
 	// Go through all elements under an estimate
 	while (xml.readNextStartElement())
 	{
-		if (xml.name() == "name")
+		switch (element())
+		{
+		case NameElement:
 			name = xml.readElementText();
-		else if (xml.name() == "description")
+			break;
+
+		case DescriptionElement:
 			description = xml.readElementText();
-		else if (xml.name() == "amount")
-		{
-			QString currency = xml.attributes().value("currency").toString();
-			QVariant amt = xml.readElementText();
-			amount = Money(amt.toDouble(), currency);
-		}
-		else if (xml.name() == "type")
+			break;
+
+		case AmountElement:
+			amount = readMoney();
+			break;
+
+		case TypeElement:
 		{
-			QString typeStr = xml.readElementText();
-			if (typeStr == "income")
+			const QString& typeStr = readText();
+			if (typeStr == QLatin1String("income"))
 				type = Estimate::Income;
-			else if (typeStr == "transfer")
+			else if (typeStr == QLatin1String("transfer"))
 				type = Estimate::Transfer;
 			else
 				type = Estimate::Expense;
+			break;
 		}
-		else if (xml.name() == "due-date-offset")
-		{
-			dueDateOffset = QVariant(xml.readElementText()).toInt();
-		}
-		else if (xml.name() == "finished")
-		{
+
+		case DueDateOffsetElement:
+			dueDateOffset = readText().toInt();
+			break;
+
+		case FinishedElement:
 			finished = true;
 			xml.skipCurrentElement();
-		}
-		else if (xml.name() == "estimate")
-		{
+			break;
+
+		case EstimateElement:
 			if ( ! estimate)
 			{
 				// According to the v5.0 spec, all estimate attributes will
@@ -540,9 +698,11 @@ void XmlBudgetReader::readVersion5Estimate(Estimate* parent)
 			}
 
 			readVersion5Estimate(estimate);
-		}
-		else
+			break;
+
+		default:
 			xml.skipCurrentElement();
+		}
 	}
 
 	if ( ! estimate)
@@ -566,55 +726,65 @@ void XmlBudgetReader::readVersion4Rule(QSharedPointer<AssignmentRules> rules)
 	// Go through all elements under a rule
 	while (xml.readNextStartElement())
 	{
-		if (xml.name() == "estimate")
+		switch (element())
 		{
-			estimateId = QVariant(xml.attributes().value("reference").toString()).toUInt();
+		case EstimateElement:
+			estimateId = xml.attributes().value(QLatin1String("reference")).toUInt();
 			xml.skipCurrentElement();
-		}
-		else if (xml.name() == "conditions")
-		{
+			break;
+
+		case ConditionsElement:
 			// Go through all condition elements
 			while (xml.readNextStartElement())
 			{
-				if (xml.name() == "condition")
+				if (element() == ConditionElement)
 				{
 					AssignmentRule::Condition condition;
 
 					// Go through all elements for a condition
 					while (xml.readNextStartElement())
 					{
-						if (xml.name() == "field")
+						switch (element())
 						{
-							QString field = xml.readElementText();
-							if (field == "PAYEE")
+						case FieldElement:
+						{
+							const QString& field = readText();
+							if (field == QLatin1String("PAYEE"))
 								condition.field = AssignmentRule::Payee;
-							else if (field == "MEMO")
+							else if (field == QLatin1String("MEMO"))
 								condition.field = AssignmentRule::Memo;
-							else if (field == "DEPOSIT")
+							else if (field == QLatin1String("DEPOSIT"))
 								condition.field = AssignmentRule::DepositAccount;
-							else if (field == "WITHDRAWAL")
+							else if (field == QLatin1String("WITHDRAWAL"))
 								condition.field = AssignmentRule::WithdrawalAccount;
 							// else leave unknown
+							break;
 						}
-						else if (xml.name() == "operator")
+
+						case OperatorElement:
 						{
-							QString oper = xml.readElementText();
-							if (oper.contains("BEGINS_WITH"))
+							const QString& oper = readText();
+							if (oper.contains(QLatin1String("BEGINS_WITH")))
 								condition.op = AssignmentRule::BeginsWith;
-							else if (oper.contains("ENDS_WITH"))
+							else if (oper.contains(QLatin1String("ENDS_WITH")))
 								condition.op = AssignmentRule::EndsWith;
-							else if (oper.contains("CONTAINS"))
+							else if (oper.contains(QLatin1String("CONTAINS")))
 								condition.op = AssignmentRule::Contains;
-							else if (oper.contains("EQUALS"))
+							else if (oper.contains(QLatin1String("EQUALS")))
 								condition.op = AssignmentRule::StringEquals;
 							// else leave unknown
 
-							condition.sensitive = oper.contains("CASE");
+							condition.sensitive = oper.contains(QLatin1String("CASE"));
+							break;
 						}
-						else if (xml.name() == "value")
+
+						case ValueElement:
 							condition.value = xml.readElementText();
-						else
+							break;
+
+						default:
 							xml.skipCurrentElement();
+						}
 					}
 
 					// Done defining condition
@@ -623,9 +793,11 @@ void XmlBudgetReader::readVersion4Rule(QSharedPointer<AssignmentRules> rules)
 				else
 					xml.skipCurrentElement();
 			}
-		}
-		else
+			break;
+
+		default:
 			xml.skipCurrentElement();
+		}
 	}
 
 	rules->createRule(ruleId, estimateId, conditions);
@@ -636,19 +808,26 @@ void XmlBudgetReader::readVersion5Rule(QSharedPointer<AssignmentRules> rules)
 {
 	Q_ASSERT(xml.isStartElement() && xml.name() == "rule");
 
-	uint ruleId = QVariant(xml.attributes().value("id").toString()).toUInt();
+	uint ruleId = xml.attributes().value(QLatin1String("id")).toUInt();
 	uint estimateId;
 	QList<AssignmentRule::Condition> conditions;
 
 	// Go through all elements under a rule
 	while (xml.readNextStartElement())
 	{
-		if (xml.name() == "estimate")
-			estimateId = QVariant(xml.readElementText()).toUInt();
-		else if (xml.name() == "condition")
+		switch (element())
+		{
+		case EstimateElement:
+			estimateId = readText().toUInt();
+			break;
+
+		case ConditionElement:
 			readVersion5Condition(conditions);
-		else
+			break;
+
+		default:
 			xml.skipCurrentElement();
+		}
 	}
 
 	rules->createRule(ruleId, estimateId, conditions);
@@ -657,17 +836,17 @@ void XmlBudgetReader::readVersion5Rule(QSharedPointer<AssignmentRules> rules)
 //------------------------------------------------------------------------------
 AssignmentRule::Field conditionFieldFrom(const QString& field)
 {
-	if (field == "date")
+	if (field == QLatin1String("date"))
 		return AssignmentRule::Date;
-	else if (field == "amount")
+	else if (field == QLatin1String("amount"))
 		return AssignmentRule::Amount;
-	else if (field == "payee")
+	else if (field == QLatin1String("payee"))
 		return AssignmentRule::Payee;
-	else if (field == "memo")
+	else if (field == QLatin1String("memo"))
 		return AssignmentRule::Memo;
-	else if (field == "deposit")
+	else if (field == QLatin1String("deposit"))
 		return AssignmentRule::DepositAccount;
-	else if (field == "withdrawal")
+	else if (field == QLatin1String("withdrawal"))
 		return AssignmentRule::WithdrawalAccount;
 	else
 		return AssignmentRule::FieldNotDefined;
@@ -676,29 +855,29 @@ AssignmentRule::Field conditionFieldFrom(const QString& field)
 //------------------------------------------------------------------------------
 AssignmentRule::Operator conditionOperatorFrom(const QString& oper)
 {
-	if (oper == "begins-with")
+	if (oper == QLatin1String("begins-with"))
 		return AssignmentRule::BeginsWith;
-	else if (oper == "ends-with")
+	else if (oper == QLatin1String("ends-with"))
 		return AssignmentRule::EndsWith;
-	else if (oper == "contains")
+	else if (oper == QLatin1String("contains"))
 		return AssignmentRule::Contains;
-	else if (oper == "string-equals")
+	else if (oper == QLatin1String("string-equals"))
 		return AssignmentRule::StringEquals;
-	else if (oper == "before")
+	else if (oper == QLatin1String("before"))
 		return AssignmentRule::Before;
-	else if (oper == "after")
+	else if (oper == QLatin1String("after"))
 		return AssignmentRule::After;
-	else if (oper == "date-equals")
+	else if (oper == QLatin1String("date-equals"))
 		return AssignmentRule::DateEquals;
-	else if (oper == "less-than")
+	else if (oper == QLatin1String("less-than"))
 		return AssignmentRule::LessThan;
-	else if (oper == "less-than-or-equal")
+	else if (oper == QLatin1String("less-than-or-equal"))
 		return AssignmentRule::LessThanOrEqual;
-	else if (oper == "greater-than")
+	else if (oper == QLatin1String("greater-than"))
 		return AssignmentRule::GreaterThan;
-	else if (oper == "greater-than-or-equal")
+	else if (oper == QLatin1String("greater-than-or-equal"))
 		return AssignmentRule::GreaterThanOrEqual;
-	else if (oper == "amount-equals")
+	else if (oper == QLatin1String("amount-equals"))
 		return AssignmentRule::AmountEquals;
 	else
 		return AssignmentRule::OperatorNotDefined;
@@ -715,19 +894,28 @@ void XmlBudgetReader::readVersion5Condition(QList<AssignmentRule::Condition>& co
 	// Go through all elements for a condition
 	while (xml.readNextStartElement())
 	{
-		if (xml.name() == "field")
-			condition.field = conditionFieldFrom(xml.readElementText());
-		else if (xml.name() == "operator")
-			condition.op = conditionOperatorFrom(xml.readElementText());
-		else if (xml.name() == "case-sensitive")
-			condition.sensitive = QVariant(xml.readElementText()).toBool();
-		else if (xml.name() == "value")
+		switch (element())
 		{
+		case FieldElement:
+			condition.field = conditionFieldFrom(readText());
+			break;
+
+		case OperatorElement:
+			condition.op = conditionOperatorFrom(readText());
+			break;
+
+		case CaseSensitiveElement:
+			condition.sensitive = readBool();
+			break;
+
+		case ValueElement:
 			condition.value = xml.readElementText();
 			value = QVariant(condition.value);
-		}
-		else
+			break;
+
+		default:
 			xml.skipCurrentElement();
+		}
 	}
 
 	// Verify entries based on the field specified
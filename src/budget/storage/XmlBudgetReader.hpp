@@ -19,8 +19,11 @@
 
 // Qt include(s)
 #include <QSharedPointer>
+#include <QString>
+#include <QStringRef>
 
 // UnderBudget include(s)
+#include "accounting/Money.hpp"
 #include "budget/AssignmentRule.hpp"
 
 // Forward declaration(s)
@@ -37,6 +40,12 @@ class Estimate;
 /**
  * XML stream reader for unserializing a budget from an XML document.
  *
+ * Element names are resolved once per element into an element token, so
+ * that the parsing of each element is a switch on the token rather than a
+ * series of string comparisons. Element text that is only needed to be
+ * interpreted (numbers, flags, and enumerated values) is read into a
+ * re-used buffer rather than into a new string for every element.
+ *
  * @ingroup budget_storage
  */
 class XmlBudgetReader
@@ -75,10 +84,128 @@ public:
 	QString errorString() const;
 
 private:
+	/**
+	 * Budget XML elements, by local name.
+	 */
+	enum Element
+	{
+		/** Unrecognized element */
+		UnknownElement,
+		/** `amount` element */
+		AmountElement,
+		/** `budget` element */
+		BudgetElement,
+		/** `case-sensitive` element */
+		CaseSensitiveElement,
+		/** `complete` element */
+		CompleteElement,
+		/** `condition` element */
+		ConditionElement,
+		/** `conditions` element */
+		ConditionsElement,
+		/** `contributor` element */
+		ContributorElement,
+		/** `day` element */
+		DayElement,
+		/** `description` element */
+		DescriptionElement,
+		/** `due-date` element */
+		DueDateElement,
+		/** `due-date-offset` element */
+		DueDateOffsetElement,
+		/** `end-date` element */
+		EndDateElement,
+		/** `estimate` element */
+		EstimateElement,
+		/** `estimates` element */
+		EstimatesElement,
+		/** `field` element */
+		FieldElement,
+		/** `finished` element */
+		FinishedElement,
+		/** `increase` element */
+		IncreaseElement,
+		/** `initial-balance` element */
+		InitialBalanceElement,
+		/** `month` element */
+		MonthElement,
+		/** `name` element */
+		NameElement,
+		/** `operator` element */
+		OperatorElement,
+		/** `param1` element */
+		Param1Element,
+		/** `param2` element */
+		Param2Element,
+		/** `period` element */
+		PeriodElement,
+		/** `rule` element */
+		RuleElement,
+		/** `rules` element */
+		RulesElement,
+		/** `start-date` element */
+		StartDateElement,
+		/** `type` element */
+		TypeElement,
+		/** `value` element */
+		ValueElement,
+		/** `year` element */
+		YearElement
+	};
+
 	/** XML stream reader */
 	QXmlStreamReader xml;
 	/** Last read budget */
 	QSharedPointer<Budget> budget;
+	/** Text of the last element read with `readText()` */
+	QString text;
+	/** Currency of amounts without a specified currency */
+	Currency defaultCurrency;
+	/** Last read currency code */
+	QString lastCurrencyCode;
+	/** Currency for the last read currency code */
+	Currency lastCurrency;
+
+	/**
+	 * Returns the element token for the current start element.
+	 *
+	 * @return current element
+	 */
+	Element element() const;
+
+	/**
+	 * Reads the text of the current element, up to the end of the element.
+	 * The returned string is only valid until the next call to this method.
+	 *
+	 * @return element text
+	 */
+	const QString& readText();
+
+	/**
+	 * Reads the text of the current element as a boolean value. Empty
+	 * text, `0`, and `false` are read as `false`.
+	 *
+	 * @return element text as a boolean value
+	 */
+	bool readBool();
+
+	/**
+	 * Returns the currency for the given currency code. As budgets
+	 * typically use a single currency for all amounts, the last currency
+	 * is retained to avoid looking it up again.
+	 *
+	 * @param[in] code currency code
+	 * @return currency for the given code
+	 */
+	Currency currencyFor(const QStringRef& code);
+
+	/**
+	 * Reads the current element as a money amount, with the currency
+	 * specified by the `currency` attribute of the element.
+	 *
+	 * @return money amount
+	 */
+	Money readMoney();
 
 	/**
 	 * Reads the XML as a version 4.0 budget definition.
@@ -22,11 +22,216 @@
 
 namespace ub {
 
+// Size of each read-ahead buffer
+static const int BUFFER_SIZE = 256 * 1024;
+// Number of read-ahead buffers
+static const int BUFFER_COUNT = 4;
+
+/**
+ * Decompression thread, filling a ring of buffers ahead of the reader.
+ */
+class GZipFile::Inflater : public QThread
+{
+public:
+	/**
+	 * Constructs a decompression thread for the given gzip file handle.
+	 * The file handle must not be used by any other thread until this
+	 * thread has been destroyed.
+	 *
+	 * @param[in] file gzip file handle
+	 */
+	Inflater(gzFile file)
+		: file(file), head(0), count(0), headPos(0), headOffset(0),
+		  ended(false), failed(false), stopped(false)
+	{
+		for (int i=0; i<BUFFER_COUNT; ++i)
+		{
+			buffers[i].data.resize(BUFFER_SIZE);
+			buffers[i].size = 0;
+			buffers[i].offset = 0;
+		}
+	}
+
+	/**
+	 * Stops decompressing and waits for the thread to finish.
+	 */
+	~Inflater()
+	{
+		mutex.lock();
+		stopped = true;
+		notFull.wakeAll();
+		mutex.unlock();
+		wait();
+	}
+
+	/**
+	 * Copies decompressed data into the given buffer, blocking until
+	 * data is available or the end of the file has been reached.
+	 *
+	 * @param[out] data    buffer into which to copy
+	 * @param[in]  maxSize maximum number of bytes to copy
+	 * @return number of bytes copied, or -1 if an error occurred
+	 */
+	qint64 read(char* data, qint64 maxSize)
+	{
+		qint64 copied = 0;
+		while (copied < maxSize)
+		{
+			mutex.lock();
+			while ((count == 0) && ! ended && ! failed)
+			{
+				notEmpty.wait(&mutex);
+			}
+			if (count == 0)
+			{
+				bool error = failed;
+				mutex.unlock();
+				return (error && (copied == 0)) ? -1 : copied;
+			}
+			mutex.unlock();
+
+			// The head buffer belongs to the reader until it is released
+			Buffer& buffer = buffers[head];
+			qint64 size = qMin(qint64(buffer.size - headPos), maxSize - copied);
+			memcpy(data + copied, buffer.data.constData() + headPos, size);
+			copied += size;
+			headPos += size;
+			headOffset = buffer.offset;
+
+			if (headPos == buffer.size)
+			{
+				mutex.lock();
+				head = (head + 1) % BUFFER_COUNT;
+				--count;
+				headPos = 0;
+				notFull.wakeOne();
+				mutex.unlock();
+			}
+		}
+		return copied;
+	}
+
+	/**
+	 * Returns the compressed offset at which the data most recently
+	 * read ends.
+	 *
+	 * @return compressed offset of the data read so far
+	 */
+	qint64 offset() const
+	{
+		return headOffset;
+	}
+
+protected:
+	/**
+	 * Decompresses the file into each free buffer in turn.
+	 */
+	void run()
+	{
+		int tail = 0;
+		forever
+		{
+			mutex.lock();
+			while ((count == BUFFER_COUNT) && ! stopped)
+			{
+				notFull.wait(&mutex);
+			}
+			if (stopped)
+			{
+				mutex.unlock();
+				return;
+			}
+			mutex.unlock();
+
+			// The tail buffer belongs to this thread until it is filled
+			Buffer& buffer = buffers[tail];
+			int bytesRead = gzread(file, buffer.data.data(), BUFFER_SIZE);
+			buffer.size = qMax(bytesRead, 0);
+			buffer.offset = gzoffset(file);
+
+			mutex.lock();
+			if (bytesRead < 0)
+			{
+				int err;
+				qWarning() << gzerror(file, &err);
+				failed = true;
+			}
+			else if (bytesRead == 0)
+			{
+				ended = true;
+			}
+			else
+			{
+				tail = (tail + 1) % BUFFER_COUNT;
+				++count;
+			}
+			notEmpty.wakeOne();
+			bool done = ended || failed;
+			mutex.unlock();
+
+			if (done)
+				return;
+		}
+	}
+
+private:
+	/**
+	 * Read-ahead buffer.
+	 */
+	struct Buffer
+	{
+		/** Decompressed data */
+		QByteArray data;
+		/** Number of valid bytes */
+		int size;
+		/** Compressed offset at which the data ends */
+		qint64 offset;
+	};
+
+	/** GZip file handle */
+	gzFile file;
+	/** Read-ahead buffers */
+	Buffer buffers[BUFFER_COUNT];
+	/** Index of the buffer being read */
+	int head;
+	/** Number of filled buffers */
+	int count;
+	/** Read position within the head buffer */
+	qint64 headPos;
+	/** Compressed offset of the data read so far */
+	qint64 headOffset;
+	/** Whether the end of the file has been reached */
+	bool ended;
+	/** Whether decompression failed */
+	bool failed;
+	/** Whether decompression is to be stopped */
+	bool stopped;
+	/** Buffer state lock */
+	QMutex mutex;
+	/** Signalled when a buffer has been filled */
+	QWaitCondition notEmpty;
+	/** Signalled when a buffer has been released */
+	QWaitCondition notFull;
+};
+
 //------------------------------------------------------------------------------
 GZipFile::GZipFile(const QString& name)
-	: QIODevice(), fileName(name)
+	: QIODevice(), fileName(name), readAhead(false), compressionLevel(-1),
+	  inflater(0)
 { }
 
+//------------------------------------------------------------------------------
+void GZipFile::setReadAhead(bool enabled)
+{
+	readAhead = enabled;
+}
+
+//------------------------------------------------------------------------------
+void GZipFile::setCompressionLevel(int level)
+{
+	compressionLevel = (level >= 1 && level <= 9) ? level : -1;
+}
+
 //------------------------------------------------------------------------------
 GZipFile::~GZipFile()
 {
@@ -45,8 +250,9 @@ bool GZipFile::isSequential() const
 //------------------------------------------------------------------------------
 bool GZipFile::open(QIODevice::OpenMode mode)
 {
-	char modeStr[2];
+	char modeStr[3];
 	modeStr[1] = '\0';
+	modeStr[2] = '\0';
 
 	if ((mode & QIODevice::ReadOnly) != 0)
 	{
@@ -55,25 +261,88 @@ bool GZipFile::open(QIODevice::OpenMode mode)
 	if ((mode & QIODevice::WriteOnly) != 0)
 	{
 		modeStr[0] = 'w';
+
+		// Compression level is given as a digit after the mode
+		if (compressionLevel > 0)
+		{
+			modeStr[1] = '0' + compressionLevel;
+		}
 	}
 
 	file = gzopen(fileName.toUtf8().data(), modeStr);
 	if ( ! file)
 		return false;
 
+	if (readAhead && (modeStr[0] == 'r'))
+	{
+		inflater = new Inflater(file);
+		inflater->start();
+	}
+
 	return QIODevice::open(mode);
 }
 
 //------------------------------------------------------------------------------
 void GZipFile::close()
+{
+	finish();
+}
+
+//------------------------------------------------------------------------------
+bool GZipFile::finish()
 {
 	QIODevice::close();
-	gzclose(file);
+
+	// Decompression thread must be stopped before the handle is closed
+	delete inflater;
+	inflater = 0;
+
+	int result = gzclose(file);
+	if (result != Z_OK)
+	{
+		setErrorString(QObject::tr("Error closing gzip file, %1 (%2).")
+			.arg(fileName).arg(result));
+		return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------
+qint64 GZipFile::compressedPos() const
+{
+	if ( ! isOpen())
+		return 0;
+	return inflater ? inflater->offset() : gzoffset(file);
+}
+
+//------------------------------------------------------------------------------
+qint64 GZipFile::compressedSize() const
+{
+	return QFileInfo(fileName).size();
+}
+
+//------------------------------------------------------------------------------
+bool GZipFile::isGZip(QIODevice& device)
+{
+	char twoBytes[2];
+	if (device.peek(twoBytes, sizeof(twoBytes)) == sizeof(twoBytes))
+	{
+		char byte1 = 0x1f;
+		char byte2 = 0x8b;
+
+		// GZip files contain 0x1f8b as first two bytes
+		return (twoBytes[0] == byte1) && (twoBytes[1] == byte2);
+	}
+
+	return false;
 }
 
 //------------------------------------------------------------------------------
 qint64 GZipFile::readData(char* data, qint64 maxSize)
 {
+	if (inflater)
+		return inflater->read(data, maxSize);
+
 	int bytesRead = gzread(file, (void*) data, maxSize);
 	if (bytesRead < maxSize)
 	{
@@ -32,6 +32,10 @@ namespace ub {
  * This is a wrapper around the zlib library's
  * functions.
  *
+ * When read-ahead is enabled, the file is decompressed by a separate
+ * thread into a ring of buffers ahead of the reader, so that
+ * decompression overlaps with whatever the reader does with the data.
+ *
  * @ingroup gzip
  */
 class GZipFile : public QIODevice
@@ -52,6 +56,25 @@ public:
 	 */
 	virtual ~GZipFile();
 
+	/**
+	 * Enables or disables decompression in a separate thread when the
+	 * file is opened for reading. This must be set before the file is
+	 * opened. Read-ahead is disabled by default.
+	 *
+	 * @param[in] enabled whether to decompress ahead of the reader
+	 */
+	void setReadAhead(bool enabled);
+
+	/**
+	 * Sets the compression level to be used when the file is opened for
+	 * writing, from 1 (fastest) to 9 (smallest). This must be set before
+	 * the file is opened. By default, zlib's default compression level
+	 * is used.
+	 *
+	 * @param[in] level compression level, or -1 for the default level
+	 */
+	void setCompressionLevel(int level);
+
 	/**
 	 * Re-implemented to always return `true`.
 	 */
@@ -67,6 +90,42 @@ public:
 	 */
 	virtual void close();
 
+	/**
+	 * Closes the gzip file handle, reporting whether it was successful.
+	 * When writing, the remaining compressed data and the gzip trailer
+	 * are only written when the file is closed, so this must be used
+	 * to determine whether the entire file was written.
+	 *
+	 * @return `true` if the file was closed without error
+	 */
+	bool finish();
+
+	/**
+	 * Returns the number of compressed bytes that have been consumed
+	 * from the underlying file so far. Unlike `pos()`, which refers to
+	 * the uncompressed stream, this can be compared against
+	 * `compressedSize()` to determine how much of the file has been read.
+	 *
+	 * @return current offset in the compressed file, or 0 if not open
+	 */
+	qint64 compressedPos() const;
+
+	/**
+	 * Returns the size of the underlying compressed file.
+	 *
+	 * @return size of the compressed file, in bytes
+	 */
+	qint64 compressedSize() const;
+
+	/**
+	 * Checks if the given device contains gzip'd data, by peeking at the
+	 * gzip magic bytes. The device must be open and is not advanced.
+	 *
+	 * @param[in] device device to be checked
+	 * @return `true` if the device starts with the gzip magic bytes
+	 */
+	static bool isGZip(QIODevice& device);
+
 protected:
 	/**
 	 * Re-implemented to read data from the gzip file handle.
@@ -79,11 +138,23 @@ protected:
 	virtual qint64 writeData(const char* data, qint64 maxSize);
 
 private:
+	// Forward declaration(s)
+	class Inflater;
+
 	/** GZip file location */
 	QString fileName;
 
 	/** GZip file handle */
 	gzFile file;
+
+	/** Whether to decompress in a separate thread */
+	bool readAhead;
+
+	/** Compression level for writing, or -1 for the default */
+	int compressionLevel;
+
+	/** Read-ahead decompression thread, if in use */
+	Inflater* inflater;
 };
 
 }
@@ -22,11 +22,14 @@ namespace ub {
 //------------------------------------------------------------------------------
 Account::Account(const QString& name, const QSharedPointer<Account>& parent)
 	: accountName(name), parentAccount(parent)
-{ }
+{
+	buildPath();
+}
 
 //------------------------------------------------------------------------------
 Account::Account(const Account& orig)
-	: accountName(orig.accountName), parentAccount(orig.parentAccount)
+	: accountName(orig.accountName), parentAccount(orig.parentAccount),
+	  path(orig.path), foldedPath(orig.foldedPath)
 { }
 
 //------------------------------------------------------------------------------
@@ -34,9 +37,25 @@ Account& Account::operator=(const Account& other)
 {
 	accountName = other.accountName;
 	parentAccount = other.parentAccount;
+	path = other.path;
+	foldedPath = other.foldedPath;
 	return *this;
 }
 
+//------------------------------------------------------------------------------
+void Account::buildPath()
+{
+	if (parentAccount.isNull() || parentAccount->path.isEmpty())
+	{
+		path = accountName;
+	}
+	else
+	{
+		path = parentAccount->path + ":" + accountName;
+	}
+	foldedPath = path.toCaseFolded();
+}
+
 //------------------------------------------------------------------------------
 QSharedPointer<Account> Account::parent() const
 {
@@ -52,6 +71,9 @@ QString Account::name() const
 //------------------------------------------------------------------------------
 QString Account::fullName(const QString& delimiter) const
 {
+	if (delimiter == ":")
+		return path;
+
 	if (parentAccount.isNull())
 	{
 		return accountName;
@@ -66,6 +88,12 @@ QString Account::fullName(const QString& delimiter) const
 	}
 }
 
+//------------------------------------------------------------------------------
+QString Account::foldedFullName() const
+{
+	return foldedPath;
+}
+
 //------------------------------------------------------------------------------
 bool Account::operator==(const Account& that) const
 {
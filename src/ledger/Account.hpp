@@ -98,12 +98,24 @@ public:
 	 * cases where a root account exists but does not contribute to account
 	 * full names.
 	 *
+	 * The full name using the default delimiter is built once, when the
+	 * account is created, so that it can be retrieved without any string
+	 * operations and shared by all transactions involving this account.
+	 *
 	 * @param[in] delimiter character string to inject between
 	 * @return account's full name, which is a combination of the names of
 	 *         this account and all parents of this account
 	 */
 	QString fullName(const QString& delimiter = ":") const;
 
+	/**
+	 * Returns the case-folded full name of this account, using the
+	 * default delimiter. This is built once, when the account is created.
+	 *
+	 * @return account's case-folded full name
+	 */
+	QString foldedFullName() const;
+
 	/**
 	 * Checks if the given account is equal to this account. Two accounts
 	 * are equal if their names are identical and their parent accounts are
@@ -130,6 +142,18 @@ private:
 
 	/** Name of this account */
 	QString accountName;
+
+	/** Full name of this account, using the default delimiter */
+	QString path;
+
+	/** Case-folded full name of this account */
+	QString foldedPath;
+
+	/**
+	 * Builds the full name of this account from the full name of its
+	 * parent account.
+	 */
+	void buildPath();
 };
 
 }
@@ -75,6 +75,18 @@ QString ImportedTransaction::depositAccount() const
 	return deposit->fullName();
 }
 
+//------------------------------------------------------------------------------
+QString ImportedTransaction::foldedWithdrawalAccount() const
+{
+	return withdrawal->foldedFullName();
+}
+
+//------------------------------------------------------------------------------
+QString ImportedTransaction::foldedDepositAccount() const
+{
+	return deposit->foldedFullName();
+}
+
 //------------------------------------------------------------------------------
 bool operator<(const ImportedTransaction& lhs, const ImportedTransaction& rhs)
 {
@@ -84,7 +96,9 @@ bool operator<(const ImportedTransaction& lhs, const ImportedTransaction& rhs)
 		return (lhs.payeeDesc < rhs.payeeDesc);
 	if (lhs.memoDesc != rhs.memoDesc)
 		return (lhs.memoDesc < rhs.memoDesc);
-	if (lhs.depositAccount() != rhs.depositAccount())
+	// Transactions from the same import share their account objects
+	if ((lhs.deposit != rhs.deposit)
+		&& (lhs.depositAccount() != rhs.depositAccount()))
 		return (lhs.depositAccount() < rhs.depositAccount());
 	else
 		return (lhs.transferredAmount < rhs.transferredAmount);
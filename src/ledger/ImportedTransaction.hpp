@@ -104,6 +104,22 @@ public:
 	 */
 	QString depositAccount() const;
 
+	/**
+	 * Returns the case-folded full name of the account from which funds
+	 * were taken.
+	 *
+	 * @return case-folded withdrawal account
+	 */
+	QString foldedWithdrawalAccount() const;
+
+	/**
+	 * Returns the case-folded full name of the account to which funds
+	 * were added.
+	 *
+	 * @return case-folded deposit account
+	 */
+	QString foldedDepositAccount() const;
+
 	/**
 	 * Checks if the first transaction occurs before the second given
 	 * transaction.
@@ -121,6 +137,9 @@ public:
 	 */
 	friend bool operator<(const ImportedTransaction& lhs, const ImportedTransaction& rhs);
 
+	// Allow the transaction store to copy out all fields directly
+	friend class TransactionStore;
+
 private:
 	/** Transaction ID */
 	uint id;
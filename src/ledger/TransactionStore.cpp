@@ -0,0 +1,463 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Qt include(s)
+#include <QtCore>
+
+// UnderBudget include(s)
+#include "ledger/Account.hpp"
+#include "ledger/TransactionStore.hpp"
+
+namespace ub {
+
+//------------------------------------------------------------------------------
+struct StringOrder
+{
+	/** Interned strings */
+	const QVector<QString>* strings;
+
+	/**
+	 * Checks if the first string ID refers to a string that is ordered
+	 * before the string referred to by the second string ID.
+	 */
+	bool operator()(int lhs, int rhs) const
+	{
+		return strings->at(lhs) < strings->at(rhs);
+	}
+};
+
+//------------------------------------------------------------------------------
+struct AmountOrder
+{
+	/** Transferred amounts */
+	const QVector<Money>* amounts;
+
+	/**
+	 * Checks if the amount of the first transaction is less than the
+	 * amount of the second transaction.
+	 */
+	bool operator()(int lhs, int rhs) const
+	{
+		return amounts->at(lhs) < amounts->at(rhs);
+	}
+};
+
+//------------------------------------------------------------------------------
+struct RankOrder
+{
+	/** Day offsets, by transaction */
+	QVector<quint64> days;
+	/** Payee ranks, by transaction */
+	QVector<quint64> payees;
+	/** Memo ranks, by transaction */
+	QVector<quint64> memos;
+	/** Deposit account ranks, by transaction */
+	QVector<quint64> deposits;
+	/** Amount ranks, by transaction */
+	QVector<quint64> amounts;
+
+	/**
+	 * Checks if the first transaction is ordered before the second,
+	 * following the ordering of the transaction less-than operator.
+	 */
+	bool operator()(int lhs, int rhs) const
+	{
+		if (days.at(lhs) != days.at(rhs))
+			return days.at(lhs) < days.at(rhs);
+		if (payees.at(lhs) != payees.at(rhs))
+			return payees.at(lhs) < payees.at(rhs);
+		if (memos.at(lhs) != memos.at(rhs))
+			return memos.at(lhs) < memos.at(rhs);
+		if (deposits.at(lhs) != deposits.at(rhs))
+			return deposits.at(lhs) < deposits.at(rhs);
+		return amounts.at(lhs) < amounts.at(rhs);
+	}
+};
+
+//------------------------------------------------------------------------------
+static QVector<int> identity(int size)
+{
+	QVector<int> order(size);
+	for (int i=0; i<size; ++i)
+	{
+		order[i] = i;
+	}
+	return order;
+}
+
+//------------------------------------------------------------------------------
+static int bitsFor(quint64 value)
+{
+	int bits = 0;
+	while (value)
+	{
+		++bits;
+		value >>= 1;
+	}
+	return bits;
+}
+
+//------------------------------------------------------------------------------
+static QVector<int> radixSort(const QVector<quint64>& keys, int bits)
+{
+	QVector<int> order = identity(keys.size());
+	QVector<int> sorted(keys.size());
+
+	// Stable least-significant-digit sort, one byte of the key per pass
+	for (int shift=0; shift<bits; shift+=8)
+	{
+		int offsets[257] = { 0 };
+		for (int i=0; i<order.size(); ++i)
+		{
+			++offsets[((keys.at(order.at(i)) >> shift) & 0xff) + 1];
+		}
+		for (int digit=0; digit<256; ++digit)
+		{
+			offsets[digit + 1] += offsets[digit];
+		}
+		for (int i=0; i<order.size(); ++i)
+		{
+			int index = order.at(i);
+			sorted[offsets[(keys.at(index) >> shift) & 0xff]++] = index;
+		}
+		order.swap(sorted);
+	}
+
+	return order;
+}
+
+//------------------------------------------------------------------------------
+template<typename T>
+static void permute(QVector<T>& column, const QVector<int>& order)
+{
+	QVector<T> permuted;
+	permuted.reserve(order.size());
+	for (int i=0; i<order.size(); ++i)
+	{
+		permuted.append(column.at(order.at(i)));
+	}
+	column = permuted;
+}
+
+//------------------------------------------------------------------------------
+TransactionStore::TransactionStore()
+{ }
+
+//------------------------------------------------------------------------------
+TransactionStore::TransactionStore(const QList<ImportedTransaction>& transactions)
+{
+	append(transactions);
+}
+
+//------------------------------------------------------------------------------
+int TransactionStore::size() const
+{
+	return ids.size();
+}
+
+//------------------------------------------------------------------------------
+bool TransactionStore::isEmpty() const
+{
+	return ids.isEmpty();
+}
+
+//------------------------------------------------------------------------------
+void TransactionStore::clear()
+{
+	ids.clear();
+	days.clear();
+	amounts.clear();
+	payees.clear();
+	memos.clear();
+	withdrawals.clear();
+	deposits.clear();
+	strings.clear();
+	foldedStrings.clear();
+	stringIds.clear();
+	accounts.clear();
+	accountNames.clear();
+	accountIds.clear();
+}
+
+//------------------------------------------------------------------------------
+void TransactionStore::append(const ImportedTransaction& transaction)
+{
+	ids.append(transaction.id);
+	days.append(transaction.postedDate.toJulianDay());
+	amounts.append(transaction.transferredAmount);
+	payees.append(intern(transaction.payeeDesc));
+	memos.append(intern(transaction.memoDesc));
+	withdrawals.append(intern(transaction.withdrawal));
+	deposits.append(intern(transaction.deposit));
+}
+
+//------------------------------------------------------------------------------
+void TransactionStore::append(const QList<ImportedTransaction>& transactions)
+{
+	int total = size() + transactions.size();
+	ids.reserve(total);
+	days.reserve(total);
+	amounts.reserve(total);
+	payees.reserve(total);
+	memos.reserve(total);
+	withdrawals.reserve(total);
+	deposits.reserve(total);
+
+	for (int i=0; i<transactions.size(); ++i)
+	{
+		append(transactions.at(i));
+	}
+}
+
+//------------------------------------------------------------------------------
+ImportedTransaction TransactionStore::at(int index) const
+{
+	return ImportedTransaction(ids.at(index), date(index), amounts.at(index),
+		payee(index), memo(index), accounts.at(withdrawals.at(index)),
+		accounts.at(deposits.at(index)));
+}
+
+//------------------------------------------------------------------------------
+QList<ImportedTransaction> TransactionStore::toList() const
+{
+	QList<ImportedTransaction> transactions;
+	transactions.reserve(size());
+	for (int i=0; i<size(); ++i)
+	{
+		transactions.append(at(i));
+	}
+	return transactions;
+}
+
+//------------------------------------------------------------------------------
+QVector<int> TransactionStore::sortedOrder() const
+{
+	if (isEmpty())
+		return QVector<int>();
+
+	// Rank each interned string once, so that transactions can be
+	// ordered by comparing integers
+	QVector<int> byString = identity(strings.size());
+	StringOrder stringOrder = { &strings };
+	qSort(byString.begin(), byString.end(), stringOrder);
+
+	QVector<quint64> stringRanks(strings.size());
+	for (int i=1; i<byString.size(); ++i)
+	{
+		stringRanks[byString.at(i)] = stringRanks.at(byString.at(i - 1))
+			+ (strings.at(byString.at(i - 1)) < strings.at(byString.at(i)) ? 1 : 0);
+	}
+
+	// Rank amounts the same way, so amounts in different currencies are
+	// only compared (and converted) while ranking
+	QVector<int> byAmount = identity(size());
+	AmountOrder amountOrder = { &amounts };
+	qSort(byAmount.begin(), byAmount.end(), amountOrder);
+
+	RankOrder ranks;
+	ranks.amounts.resize(size());
+	for (int i=1; i<byAmount.size(); ++i)
+	{
+		ranks.amounts[byAmount.at(i)] = ranks.amounts.at(byAmount.at(i - 1))
+			+ (amounts.at(byAmount.at(i - 1)) < amounts.at(byAmount.at(i)) ? 1 : 0);
+	}
+
+	qint64 firstDay = days.at(0);
+	for (int i=1; i<size(); ++i)
+	{
+		firstDay = qMin(firstDay, days.at(i));
+	}
+
+	quint64 maxDay = 0;
+	quint64 maxString = stringRanks.at(byString.last());
+	quint64 maxAmount = ranks.amounts.at(byAmount.last());
+	ranks.days.reserve(size());
+	ranks.payees.reserve(size());
+	ranks.memos.reserve(size());
+	ranks.deposits.reserve(size());
+	for (int i=0; i<size(); ++i)
+	{
+		quint64 day = days.at(i) - firstDay;
+		maxDay = qMax(maxDay, day);
+		ranks.days.append(day);
+		ranks.payees.append(stringRanks.at(payees.at(i)));
+		ranks.memos.append(stringRanks.at(memos.at(i)));
+		ranks.deposits.append(stringRanks.at(accountNames.at(deposits.at(i))));
+	}
+
+	// Pack all ranks into a single key, if they fit
+	int amountBits = bitsFor(maxAmount);
+	int stringBits = bitsFor(maxString);
+	int dayBits = bitsFor(maxDay);
+	int bits = dayBits + 3 * stringBits + amountBits;
+	if (bits > 64)
+	{
+		QVector<int> order = identity(size());
+		qSort(order.begin(), order.end(), ranks);
+		return order;
+	}
+
+	QVector<quint64> keys;
+	keys.reserve(size());
+	for (int i=0; i<size(); ++i)
+	{
+		quint64 key = ranks.days.at(i);
+		key = (key << stringBits) | ranks.payees.at(i);
+		key = (key << stringBits) | ranks.memos.at(i);
+		key = (key << stringBits) | ranks.deposits.at(i);
+		key = (key << amountBits) | ranks.amounts.at(i);
+		keys.append(key);
+	}
+
+	return radixSort(keys, bits);
+}
+
+//------------------------------------------------------------------------------
+void TransactionStore::sort()
+{
+	QVector<int> order = sortedOrder();
+
+	permute(ids, order);
+	permute(days, order);
+	permute(amounts, order);
+	permute(payees, order);
+	permute(memos, order);
+	permute(withdrawals, order);
+	permute(deposits, order);
+}
+
+//------------------------------------------------------------------------------
+void TransactionStore::sort(QList<ImportedTransaction>& transactions)
+{
+	QVector<int> order = TransactionStore(transactions).sortedOrder();
+
+	QList<ImportedTransaction> sorted;
+	sorted.reserve(order.size());
+	for (int i=0; i<order.size(); ++i)
+	{
+		sorted.append(transactions.at(order.at(i)));
+	}
+	transactions = sorted;
+}
+
+//------------------------------------------------------------------------------
+uint TransactionStore::transactionId(int index) const
+{
+	return ids.at(index);
+}
+
+//------------------------------------------------------------------------------
+QDate TransactionStore::date(int index) const
+{
+	return QDate::fromJulianDay(days.at(index));
+}
+
+//------------------------------------------------------------------------------
+const Money& TransactionStore::amount(int index) const
+{
+	return amounts.at(index);
+}
+
+//------------------------------------------------------------------------------
+const QString& TransactionStore::payee(int index) const
+{
+	return strings.at(payees.at(index));
+}
+
+//------------------------------------------------------------------------------
+const QString& TransactionStore::memo(int index) const
+{
+	return strings.at(memos.at(index));
+}
+
+//------------------------------------------------------------------------------
+const QString& TransactionStore::withdrawalAccount(int index) const
+{
+	return strings.at(withdrawalAccountId(index));
+}
+
+//------------------------------------------------------------------------------
+const QString& TransactionStore::depositAccount(int index) const
+{
+	return strings.at(depositAccountId(index));
+}
+
+//------------------------------------------------------------------------------
+int TransactionStore::payeeId(int index) const
+{
+	return payees.at(index);
+}
+
+//------------------------------------------------------------------------------
+int TransactionStore::memoId(int index) const
+{
+	return memos.at(index);
+}
+
+//------------------------------------------------------------------------------
+int TransactionStore::withdrawalAccountId(int index) const
+{
+	return accountNames.at(withdrawals.at(index));
+}
+
+//------------------------------------------------------------------------------
+int TransactionStore::depositAccountId(int index) const
+{
+	return accountNames.at(deposits.at(index));
+}
+
+//------------------------------------------------------------------------------
+const QString& TransactionStore::string(int id) const
+{
+	return strings.at(id);
+}
+
+//------------------------------------------------------------------------------
+const QString& TransactionStore::foldedString(int id) const
+{
+	return foldedStrings.at(id);
+}
+
+//------------------------------------------------------------------------------
+int TransactionStore::intern(const QString& string)
+{
+	QHash<QString, int>::const_iterator iter = stringIds.constFind(string);
+	if (iter != stringIds.constEnd())
+		return iter.value();
+
+	int id = strings.size();
+	strings.append(string);
+	foldedStrings.append(string.toCaseFolded());
+	stringIds.insert(string, id);
+	return id;
+}
+
+//------------------------------------------------------------------------------
+int TransactionStore::intern(const QSharedPointer<Account>& account)
+{
+	QHash<const Account*, int>::const_iterator iter =
+		accountIds.constFind(account.data());
+	if (iter != accountIds.constEnd())
+		return iter.value();
+
+	int id = accounts.size();
+	accounts.append(account);
+	accountNames.append(intern(account->fullName()));
+	accountIds.insert(account.data(), id);
+	return id;
+}
+
+}
@@ -0,0 +1,307 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRANSACTIONSTORE_HPP
+#define TRANSACTIONSTORE_HPP
+
+// Qt include(s)
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+// UnderBudget include(s)
+#include "accounting/Money.hpp"
+#include "ledger/ImportedTransaction.hpp"
+
+namespace ub {
+
+// Forward declaration(s)
+class Account;
+
+/**
+ * Column-oriented storage of imported transactions.
+ *
+ * Each transaction field is stored in its own contiguous array, indexed by
+ * the position of the transaction in the store. Dates are stored as day
+ * numbers and amounts as fixed-point values, so that scanning a single
+ * field of many transactions is a loop over a plain array.
+ *
+ * Payees, memos, and account names are interned: each distinct string is
+ * stored once, along with its case-folded form, and transactions only
+ * refer to it by ID. Strings that are repeated by many transactions are
+ * therefore only case-folded or compared once.
+ *
+ * @ingroup ledger
+ */
+class TransactionStore
+{
+public:
+	/**
+	 * Constructs an empty transaction store.
+	 */
+	TransactionStore();
+
+	/**
+	 * Constructs a transaction store holding the given transactions, in
+	 * the same order.
+	 *
+	 * @param[in] transactions transactions to be stored
+	 */
+	TransactionStore(const QList<ImportedTransaction>& transactions);
+
+	/**
+	 * Returns the number of stored transactions.
+	 *
+	 * @return number of stored transactions
+	 */
+	int size() const;
+
+	/**
+	 * Checks if no transactions are stored.
+	 *
+	 * @return `true` if no transactions are stored
+	 */
+	bool isEmpty() const;
+
+	/**
+	 * Removes all stored transactions and interned strings.
+	 */
+	void clear();
+
+	/**
+	 * Appends the given transaction to the store.
+	 *
+	 * @param[in] transaction transaction to be stored
+	 */
+	void append(const ImportedTransaction& transaction);
+
+	/**
+	 * Appends the given transactions to the store, in order.
+	 *
+	 * @param[in] transactions transactions to be stored
+	 */
+	void append(const QList<ImportedTransaction>& transactions);
+
+	/**
+	 * Re-creates the transaction at the given index.
+	 *
+	 * @param[in] index transaction index
+	 * @return transaction at the given index
+	 */
+	ImportedTransaction at(int index) const;
+
+	/**
+	 * Re-creates all stored transactions, in order.
+	 *
+	 * @return stored transactions
+	 */
+	QList<ImportedTransaction> toList() const;
+
+	/**
+	 * Determines the order of the stored transactions as defined by the
+	 * transaction less-than operator.
+	 *
+	 * Interned strings and amounts are ranked once, and the date, payee,
+	 * memo, deposit account, and amount ranks of each transaction are
+	 * packed into a single integer key which is then radix sorted. If
+	 * the ranks do not fit in 64 bits, the transactions are instead
+	 * sorted by comparing their ranks. Either way, no strings or amounts
+	 * are compared while sorting the transactions themselves. Equivalent
+	 * transactions keep their stored order.
+	 *
+	 * @return indices of the stored transactions, in sorted order
+	 */
+	QVector<int> sortedOrder() const;
+
+	/**
+	 * Sorts the stored transactions into the same order as defined by
+	 * the transaction less-than operator.
+	 */
+	void sort();
+
+	/**
+	 * Sorts the given transactions into the same order as defined by the
+	 * transaction less-than operator, using a sort key packed from the
+	 * transaction fields rather than comparing the transactions.
+	 *
+	 * @param[in,out] transactions transactions to be sorted
+	 */
+	static void sort(QList<ImportedTransaction>& transactions);
+
+	/**
+	 * Returns the ID of the transaction at the given index.
+	 *
+	 * @param[in] index transaction index
+	 * @return transaction ID
+	 */
+	uint transactionId(int index) const;
+
+	/**
+	 * Returns the date of the transaction at the given index.
+	 *
+	 * @param[in] index transaction index
+	 * @return transaction date
+	 */
+	QDate date(int index) const;
+
+	/**
+	 * Returns the amount of the transaction at the given index.
+	 *
+	 * @param[in] index transaction index
+	 * @return transferred amount
+	 */
+	const Money& amount(int index) const;
+
+	/**
+	 * Returns the payee of the transaction at the given index.
+	 *
+	 * @param[in] index transaction index
+	 * @return transaction payee
+	 */
+	const QString& payee(int index) const;
+
+	/**
+	 * Returns the memo of the transaction at the given index.
+	 *
+	 * @param[in] index transaction index
+	 * @return transaction memo
+	 */
+	const QString& memo(int index) const;
+
+	/**
+	 * Returns the full name of the withdrawal account of the transaction
+	 * at the given index.
+	 *
+	 * @param[in] index transaction index
+	 * @return withdrawal account
+	 */
+	const QString& withdrawalAccount(int index) const;
+
+	/**
+	 * Returns the full name of the deposit account of the transaction
+	 * at the given index.
+	 *
+	 * @param[in] index transaction index
+	 * @return deposit account
+	 */
+	const QString& depositAccount(int index) const;
+
+	/**
+	 * Returns the interned string ID of the payee of the transaction
+	 * at the given index.
+	 *
+	 * @param[in] index transaction index
+	 * @return payee string ID
+	 */
+	int payeeId(int index) const;
+
+	/**
+	 * Returns the interned string ID of the memo of the transaction
+	 * at the given index.
+	 *
+	 * @param[in] index transaction index
+	 * @return memo string ID
+	 */
+	int memoId(int index) const;
+
+	/**
+	 * Returns the interned string ID of the withdrawal account name of the
+	 * transaction at the given index.
+	 *
+	 * @param[in] index transaction index
+	 * @return withdrawal account string ID
+	 */
+	int withdrawalAccountId(int index) const;
+
+	/**
+	 * Returns the interned string ID of the deposit account name of the
+	 * transaction at the given index.
+	 *
+	 * @param[in] index transaction index
+	 * @return deposit account string ID
+	 */
+	int depositAccountId(int index) const;
+
+	/**
+	 * Returns the interned string with the given ID.
+	 *
+	 * @param[in] id string ID
+	 * @return interned string
+	 */
+	const QString& string(int id) const;
+
+	/**
+	 * Returns the case-folded form of the interned string with the
+	 * given ID.
+	 *
+	 * @param[in] id string ID
+	 * @return case-folded interned string
+	 */
+	const QString& foldedString(int id) const;
+
+private:
+	/** Transaction IDs */
+	QVector<uint> ids;
+	/** Transaction dates, as Julian day numbers */
+	QVector<qint64> days;
+	/** Transferred amounts */
+	QVector<Money> amounts;
+	/** Payee string IDs */
+	QVector<int> payees;
+	/** Memo string IDs */
+	QVector<int> memos;
+	/** Withdrawal account IDs */
+	QVector<int> withdrawals;
+	/** Deposit account IDs */
+	QVector<int> deposits;
+
+	/** Interned strings, by string ID */
+	QVector<QString> strings;
+	/** Case-folded interned strings, by string ID */
+	QVector<QString> foldedStrings;
+	/** String IDs, by string */
+	QHash<QString, int> stringIds;
+
+	/** Accounts, by account ID */
+	QVector<QSharedPointer<Account> > accounts;
+	/** Full name string IDs, by account ID */
+	QVector<int> accountNames;
+	/** Account IDs, by account */
+	QHash<const Account*, int> accountIds;
+
+	/**
+	 * Returns the ID of the given string, interning it if necessary.
+	 *
+	 * @param[in] string string to be interned
+	 * @return string ID
+	 */
+	int intern(const QString& string);
+
+	/**
+	 * Returns the ID of the given account, interning it if necessary.
+	 *
+	 * @param[in] account account to be interned
+	 * @return account ID
+	 */
+	int intern(const QSharedPointer<Account>& account);
+};
+
+}
+
+#endif //TRANSACTIONSTORE_HPP
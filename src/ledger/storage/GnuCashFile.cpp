@@ -19,11 +19,15 @@
 
 // UnderBudget include(s)
 #include "settings.hpp"
+#include "gzip/GZipFile.hpp"
 #include "ledger/storage/GnuCashFile.hpp"
 #include "ledger/storage/GnuCashReader.hpp"
 
 namespace ub {
 
+// Number of transactions read before they are handed off
+static const int BATCH_SIZE = 5000;
+
 //------------------------------------------------------------------------------
 GnuCashFile::GnuCashFile(const QString& fileName)
 	: fileName(fileName), isImporting(false), fileChanges(0)
@@ -32,7 +36,10 @@ GnuCashFile::GnuCashFile(const QString& fileName)
 	qRegisterMetaType<ImportedTransactionSource::Result>("ImportedTransactionSource::Result");
 	qRegisterMetaType<QList<ImportedTransaction> >("QList<ImportedTransaction>");
 
+	// Hand off transactions in batches, so that they can be assigned
+	// while the rest of the file is still being read
 	reader = new GnuCashReader(fileName);
+	reader->setBatchSize(BATCH_SIZE);
 	reader->moveToThread(&thread);
 
 	// Make sure the reader is deleted when the thread terminates
@@ -45,6 +52,8 @@ GnuCashFile::GnuCashFile(const QString& fileName)
 	connect(reader, SIGNAL(progress(int)), this, SIGNAL(progress(int)));
 	connect(reader, SIGNAL(imported(QList<ImportedTransaction>)),
 		this, SIGNAL(imported(QList<ImportedTransaction>)));
+	connect(reader, SIGNAL(importedBatch(QList<ImportedTransaction>)),
+		this, SIGNAL(importedBatch(QList<ImportedTransaction>)));
 
 	// Record importing state of the reader thread
 	connect(reader, SIGNAL(started()), this, SLOT(importingStarted()));
@@ -58,6 +67,10 @@ GnuCashFile::GnuCashFile(const QString& fileName)
 	QSettings settings;
 	if (settings.value(import::AutoReImport).toBool())
 	{
+		// A watched file is likely to be rewritten in place while it is
+		// being re-imported, which is only safe to read through a buffer
+		reader->setMemoryMapping(false);
+
 		watcher.addPath(fileName);
 		connect(&watcher, SIGNAL(fileChanged(QString)),
 			this, SLOT(fileChanged(QString)));
@@ -127,6 +140,9 @@ bool GnuCashFile::import(const QDate& start, const QDate& end)
 {
 	if ( ! isImporting)
 	{
+		// Cleared here rather than by the reader thread, so that a
+		// cancellation arriving before the queued import starts is kept
+		reader->resetCancel();
 		QMetaObject::invokeMethod(reader, "import", Qt::QueuedConnection,
 			Q_ARG(QDate, start), Q_ARG(QDate, end));
 		return true;
@@ -138,7 +154,9 @@ bool GnuCashFile::import(const QDate& start, const QDate& end)
 //------------------------------------------------------------------------------
 void GnuCashFile::cancel()
 {
-	QMetaObject::invokeMethod(reader, "cancel");
+	// Called directly, as the reader thread is busy with the import and
+	// would not process a queued call until the import has finished
+	reader->cancel();
 }
 
 //------------------------------------------------------------------------------
@@ -149,16 +167,8 @@ bool GnuCashFile::isGnuCashFile(QFile& file)
 		return true;
 
 	// Check if a gzip file
-	char twoBytes[2];
-	if (file.peek(twoBytes, sizeof(twoBytes)) == sizeof(twoBytes))
-	{
-		char byte1 = 0x1f;
-		char byte2 = 0x8b;
-
-		// GZip files contain 0x1f8b as first two bytes
-		if ((twoBytes[0] == byte1) && (twoBytes[1] == byte2))
-			return true;
-	}
+	if (GZipFile::isGZip(file))
+		return true;
 
 	// Check if an XML file
 	char twoLines[50];
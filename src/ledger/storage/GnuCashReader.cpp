@@ -21,19 +21,35 @@
 #include "gzip/GZipFile.hpp"
 #include "ledger/Account.hpp"
 #include "ledger/ImportedTransaction.hpp"
+#include "ledger/TransactionStore.hpp"
 #include "ledger/storage/GnuCashReader.hpp"
 
 namespace ub {
 
 //------------------------------------------------------------------------------
 GnuCashReader::GnuCashReader()
+	: batchSize(0), emittedBatch(false), memoryMapping(true), deviceSize(0),
+	  lastProgress(-1), cancelled(0)
 { }
 
 //------------------------------------------------------------------------------
 GnuCashReader::GnuCashReader(const QString& fileName)
-	: fileName(fileName)
+	: fileName(fileName), batchSize(0), emittedBatch(false),
+	  memoryMapping(true), deviceSize(0), lastProgress(-1), cancelled(0)
 { }
 
+//------------------------------------------------------------------------------
+void GnuCashReader::setBatchSize(int size)
+{
+	batchSize = qMax(0, size);
+}
+
+//------------------------------------------------------------------------------
+void GnuCashReader::setMemoryMapping(bool enabled)
+{
+	memoryMapping = enabled;
+}
+
 //------------------------------------------------------------------------------
 void GnuCashReader::import(const QDate& start, const QDate& end)
 {
@@ -44,7 +60,34 @@ void GnuCashReader::import(const QDate& start, const QDate& end)
 		return;
 	}
 
+	QFile file(fileName);
+	if (memoryMapping && file.open(QIODevice::ReadOnly)
+		&& ! GZipFile::isGZip(file))
+	{
+		// Uncompressed books are read straight out of a memory mapping,
+		// rather than being copied through the file's read buffer
+		uchar* mapped = ((file.size() > 0) && (file.size() <= INT_MAX))
+			? file.map(0, file.size()) : 0;
+		if (mapped)
+		{
+			QByteArray data = QByteArray::fromRawData(
+				reinterpret_cast<const char*>(mapped), file.size());
+			QBuffer buffer(&data);
+			buffer.open(QIODevice::ReadOnly);
+
+			QList<ImportedTransaction> trns;
+			read(&buffer, trns, start, end);
+
+			buffer.close();
+			file.unmap(mapped);
+			return;
+		}
+	}
+	file.close();
+
+	// Decompress in parallel with parsing
 	GZipFile gzipFile(fileName);
+	gzipFile.setReadAhead(true);
 	if (gzipFile.open(QIODevice::ReadOnly))
 	{
 		QList<ImportedTransaction> trns;
@@ -83,10 +126,24 @@ bool GnuCashReader::read(QIODevice* device, QList<ImportedTransaction>& trns,
 	endDateFilter = end;
 	xml.setDevice(device);
 
+	// Progress is measured against the bytes on disk, which for a gzip
+	// file are the compressed bytes rather than the decompressed XML
+	GZipFile* gzipFile = qobject_cast<GZipFile*>(device);
+	if (gzipFile)
+	{
+		deviceSize = gzipFile->compressedSize();
+	}
+	else
+	{
+		deviceSize = device->isSequential() ? 0 : device->size();
+	}
+	lastProgress = -1;
+	reportProgress();
+
 	// Reset imported accounts and transactions
 	accounts.clear();
-	accountTypes.clear();
 	transactions.clear();
+	emittedBatch = false;
 
 	// Go through all top-level elements
 	if (xml.readNextStartElement())
@@ -98,15 +155,39 @@ bool GnuCashReader::read(QIODevice* device, QList<ImportedTransaction>& trns,
 		else
 			xml.raiseError(tr("The given XML is not a valid GnuCash file."));
 	}
+	reportProgress();
 
-	if (xml.hasError())
+	// A cancellation only applies to the import that was in progress. The
+	// flag is cleared before the result is reported, as the next import
+	// cannot be requested until the result has been received.
+	bool wasCancelled = cancelled.fetchAndStoreOrdered(0);
+
+	if (wasCancelled)
+	{
+		transactions.clear();
+		emit finished(ImportedTransactionSource::Cancelled, errorString());
+	}
+	else if (xml.hasError())
 	{
 		emit finished(ImportedTransactionSource::FailedWithError, errorString());
 	}
+	else if (batchSize > 0)
+	{
+		// Hand off whatever remains of the last batch. At least one batch
+		// is always emitted, so that a book without any transactions in
+		// range still replaces the previously imported transactions.
+		if ( ! transactions.isEmpty() || ! emittedBatch)
+		{
+			emit importedBatch(transactions);
+			transactions.clear();
+		}
+
+		emit finished(ImportedTransactionSource::Complete, "");
+	}
 	else
 	{
 		// sort the transactions
-		qSort(transactions);
+		TransactionStore::sort(transactions);
 
 		emit finished(ImportedTransactionSource::Complete, "");
 		emit imported(transactions);
@@ -155,6 +236,12 @@ void GnuCashReader::readVersion2Book()
 	// Go through all elements under the book
 	while (xml.readNextStartElement())
 	{
+		if (cancelled.loadAcquire())
+		{
+			xml.raiseError(tr("Import cancelled."));
+			break;
+		}
+
 		if (xml.qualifiedName() == "gnc:account")
 		{
 			readVersion2Account();
@@ -162,9 +249,36 @@ void GnuCashReader::readVersion2Book()
 		else if (xml.qualifiedName() == "gnc:transaction")
 		{
 			readVersion2Transaction();
+
+			if (batchSize > 0 && transactions.size() >= batchSize)
+			{
+				emit importedBatch(transactions);
+				transactions.clear();
+				emittedBatch = true;
+			}
 		}
 		else
 			xml.skipCurrentElement();
+
+		reportProgress();
+	}
+}
+
+//------------------------------------------------------------------------------
+void GnuCashReader::reportProgress()
+{
+	if (deviceSize <= 0)
+		return;
+
+	QIODevice* device = xml.device();
+	GZipFile* gzipFile = qobject_cast<GZipFile*>(device);
+	qint64 consumed = gzipFile ? gzipFile->compressedPos() : device->pos();
+
+	int percent = qMin(consumed * 100 / deviceSize, qint64(100));
+	if (percent != lastProgress)
+	{
+		lastProgress = percent;
+		emit progress(percent);
 	}
 }
 
@@ -184,11 +298,11 @@ void GnuCashReader::readVersion2Account()
 	{
 		if (xml.qualifiedName() == "act:id")
 		{
-			uid = QUuid::createUuidV5(QUuid(), xml.readElementText());
+			uid = readGuid();
 		}
 		else if (xml.qualifiedName() == "act:parent")
 		{
-			parentUid = QUuid::createUuidV5(QUuid(), xml.readElementText());
+			parentUid = readGuid();
 		}
 		else if (xml.qualifiedName() == "act:name")
 		{
@@ -216,9 +330,8 @@ void GnuCashReader::readVersion2Account()
 	}
 	else if (type == Root)
 	{
-		QSharedPointer<Account> root(new Account());
+		ImportedAccount root = { QSharedPointer<Account>(new Account()), type };
 		accounts.insert(uid, root);
-		accountTypes.insert(uid, type);
 	}
 	else if (parentUid.isNull())
 	{
@@ -226,16 +339,16 @@ void GnuCashReader::readVersion2Account()
 	}
 	else
 	{
-		QSharedPointer<Account> parent = accounts.value(parentUid);
+		QSharedPointer<Account> parent = accounts.value(parentUid).account;
 		if (parent.isNull())
 		{
 			xml.raiseError(tr("Missing parent account for %1.").arg(name));
 		}
 		else
 		{
-			QSharedPointer<Account> account(new Account(name, parent));
+			ImportedAccount account = {
+				QSharedPointer<Account>(new Account(name, parent)), type };
 			accounts.insert(uid, account);
-			accountTypes.insert(uid, type);
 		}
 	}
 }
@@ -284,11 +397,19 @@ void GnuCashReader::readVersion2Transaction()
 	{
 		if (xml.qualifiedName() == "trn:id")
 		{
-			uid = QUuid::createUuidV5(QUuid(), xml.readElementText());
+			uid = readGuid();
 		}
 		else if (xml.qualifiedName() == "trn:date-posted")
 		{
 			datePosted = readDate();
+
+			// Skip the rest of the transaction (i.e., the splits) as soon
+			// as it is known to be outside of the import range
+			if (datePosted.isValid() && ! inRange(datePosted))
+			{
+				xml.skipCurrentElement();
+				return;
+			}
 		}
 		else if (xml.qualifiedName() == "trn:currency")
 		{
@@ -308,17 +429,22 @@ void GnuCashReader::readVersion2Transaction()
 
 	//qDebug() << "Read transaction" << datePosted << currency << payee;
 
-	// Only filter by date if both start and end are valid dates
-	if (startDateFilter.isValid() && endDateFilter.isValid())
-	{
-		// If before start or after end, skip this transaction
-		if ((datePosted < startDateFilter) || (endDateFilter < datePosted))
-			return;
-	}
+	// If before start or after end, skip this transaction
+	if ( ! inRange(datePosted))
+		return;
 
 	createTransactionsFromSplits(datePosted, currency, payee, splits);
 }
 
+//------------------------------------------------------------------------------
+bool GnuCashReader::inRange(const QDate& date) const
+{
+	// Only filter by date if both start and end are valid dates
+	if (startDateFilter.isValid() && endDateFilter.isValid())
+		return ( ! (date < startDateFilter)) && ( ! (endDateFilter < date));
+	return true;
+}
+
 //------------------------------------------------------------------------------
 QHash<QUuid, GnuCashReader::TransactionSplit> GnuCashReader::readSplits()
 {
@@ -351,7 +477,7 @@ GnuCashReader::TransactionSplit GnuCashReader::readSplit()
 	{
 		if (xml.qualifiedName() == "split:id")
 		{
-			split.uid = QUuid::createUuidV5(QUuid(), xml.readElementText());
+			split.uid = readGuid();
 		}
 		else if (xml.qualifiedName() == "split:memo")
 		{
@@ -363,7 +489,7 @@ GnuCashReader::TransactionSplit GnuCashReader::readSplit()
 		}
 		else if (xml.qualifiedName() == "split:account")
 		{
-			split.account = QUuid::createUuidV5(QUuid(), xml.readElementText());
+			split.account = readGuid();
 		}
 		else
 			xml.skipCurrentElement();
@@ -374,6 +500,60 @@ GnuCashReader::TransactionSplit GnuCashReader::readSplit()
 	return split;
 }
 
+//------------------------------------------------------------------------------
+QUuid GnuCashReader::readGuid()
+{
+	QString text = xml.readElementText();
+
+	// GnuCash writes GUIDs as 32 hex digits, e.g. 0719754ce69a13860400bdbb10208c99
+	if (text.size() == 32)
+	{
+		uchar bytes[16];
+		bool valid(true);
+		const QChar* digits = text.constData();
+
+		for (int i=0; valid && i<32; ++i)
+		{
+			ushort c = digits[i].unicode();
+			uchar nibble;
+			if (c >= '0' && c <= '9')
+				nibble = c - '0';
+			else if (c >= 'a' && c <= 'f')
+				nibble = c - 'a' + 10;
+			else if (c >= 'A' && c <= 'F')
+				nibble = c - 'A' + 10;
+			else
+			{
+				valid = false;
+				break;
+			}
+
+			if (i % 2 == 0)
+				bytes[i / 2] = nibble << 4;
+			else
+				bytes[i / 2] |= nibble;
+		}
+
+		QUuid uuid;
+		if (valid)
+		{
+			uuid = QUuid(
+				(uint(bytes[0]) << 24) | (uint(bytes[1]) << 16)
+					| (uint(bytes[2]) << 8) | uint(bytes[3]),
+				(ushort(bytes[4]) << 8) | bytes[5],
+				(ushort(bytes[6]) << 8) | bytes[7],
+				bytes[8], bytes[9], bytes[10], bytes[11],
+				bytes[12], bytes[13], bytes[14], bytes[15]);
+		}
+
+		if ( ! uuid.isNull())
+			return uuid;
+	}
+
+	// Anything else is hashed, which is much slower but still unique
+	return QUuid::createUuidV5(QUuid(), text);
+}
+
 //------------------------------------------------------------------------------
 QDate GnuCashReader::readDate()
 {
@@ -477,12 +657,13 @@ void GnuCashReader::createTransactionsFromSplits(const QDate& datePosted,
 	else
 	{
 		TransactionSplit primarySplit = splits.value(primaryUid);
-		QSharedPointer<Account> primaryAccount = accounts.value(primarySplit.account);
+		ImportedAccount primary = accounts.value(primarySplit.account);
+		QSharedPointer<Account> primaryAccount = primary.account;
 
 		// Transaction is a refund if it's a withdrawal from an expense account
 		bool primaryIsWithdrawal = (primarySplit.value < 0);
 		bool primaryIsRefund = primaryIsWithdrawal
-			&& (accountTypes.value(primarySplit.account, Root) == Expense);
+			&& ( ! primaryAccount.isNull()) && (primary.type == Expense);
 
 		// Make sure account exists
 		if (primaryAccount.isNull())
@@ -504,7 +685,7 @@ void GnuCashReader::createTransactionsFromSplits(const QDate& datePosted,
 			if (uid != primaryUid)
 			{
 				TransactionSplit split = splits.value(uid);
-				QSharedPointer<Account> splitAccount = accounts.value(split.account);
+				QSharedPointer<Account> splitAccount = accounts.value(split.account).account;
 
 				// Make sure account exists
 				if (splitAccount.isNull())
@@ -582,7 +763,15 @@ QUuid GnuCashReader::findPrimary(const QHash<QUuid, TransactionSplit>& splits)
 
 //------------------------------------------------------------------------------
 void GnuCashReader::cancel()
-{ }
+{
+	cancelled.storeRelease(1);
+}
+
+//------------------------------------------------------------------------------
+void GnuCashReader::resetCancel()
+{
+	cancelled.storeRelease(0);
+}
 
 }
 
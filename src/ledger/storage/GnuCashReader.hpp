@@ -18,6 +18,7 @@
 #define GNUCASHREADER_HPP
 
 // Qt include(s)
+#include <QAtomicInt>
 #include <QDate>
 #include <QHash>
 #include <QList>
@@ -66,6 +67,11 @@ public:
 	 * will be imported. Otherwise only transactions that have occurred
 	 * between the start and end dates will be imported.
 	 *
+	 * If a batch size has been set, the transactions are instead emitted
+	 * with the `importedBatch` signal as they are read, in file order,
+	 * and neither sorted nor returned in `trns`. The `imported` signal
+	 * is not emitted in this case.
+	 *
 	 * For use of this reading in a multi-threaded environment, it is recommended
 	 * that the `import` slot be used instead, relying on the `started`, `finished`,
 	 * `progress`, and `imported` signals for monitoring progress and retrieving
@@ -89,11 +95,42 @@ public:
 	 */
 	QString errorString() const;
 
+	/**
+	 * Sets the number of transactions to be read before they are emitted
+	 * with the `importedBatch` signal. This allows the transactions to be
+	 * processed while the remainder of the file is still being read. A
+	 * batch size of 0, the default, disables batching so that all
+	 * transactions are emitted at once with the `imported` signal.
+	 *
+	 * @param[in] size number of transactions per batch, or 0
+	 */
+	void setBatchSize(int size);
+
+	/**
+	 * Enables or disables reading uncompressed files from a memory
+	 * mapping. Memory mapping is enabled by default.
+	 *
+	 * If a mapped file is truncated by another process while it is being
+	 * read, accessing the missing pages raises a bus error rather than
+	 * a read error. Memory mapping should therefore be disabled for files
+	 * that are expected to be rewritten while they are being imported,
+	 * such as files that are watched for changes. Those are read through
+	 * a buffer instead, so that a concurrent rewrite only results in a
+	 * parse error.
+	 *
+	 * @param[in] enabled whether to memory-map uncompressed files
+	 */
+	void setMemoryMapping(bool enabled);
+
 public slots:
 	/**
 	 * Reads the given file and imports all transactions that occurred
 	 * between the given start and end dates.
 	 *
+	 * Gzip'd files are decompressed as they are read. Uncompressed files
+	 * are memory-mapped and parsed directly from the mapping, unless
+	 * memory mapping has been disabled.
+	 *
 	 * If the start and end dates are not valid dates, then all transactions
 	 * will be imported.
 	 *
@@ -104,9 +141,25 @@ public slots:
 
 	/**
 	 * Cancels the current import operation, if one is in progress.
+	 *
+	 * This may be called directly from any thread, since the import is
+	 * likely to be blocking the event loop of the reader's thread. The
+	 * import stops at the next element of the book, and the `finished`
+	 * signal is emitted with the `Cancelled` result.
+	 *
+	 * A cancellation that is requested before an import starts applies
+	 * to that import, so that an import which is queued for the reader's
+	 * thread can be cancelled before it begins.
 	 */
 	void cancel();
 
+	/**
+	 * Withdraws any cancellation that has not yet been applied to an
+	 * import. This is to be called before queueing a new import, from
+	 * any thread.
+	 */
+	void resetCancel();
+
 signals:
 	/**
 	 * Emitted when an import operation commences.
@@ -143,6 +196,18 @@ signals:
 	 */
 	void imported(QList<ImportedTransaction> transactions);
 
+	/**
+	 * Emitted during a batched import each time a batch of transactions
+	 * has been read, and once more before the import finishes for any
+	 * remaining transactions. A successful import always emits at least
+	 * one batch, which is empty if no transactions were imported. Batches
+	 * are emitted in file order, and are not sorted. If the import fails
+	 * or is cancelled, previously emitted batches are to be discarded.
+	 *
+	 * @param transactions batch of imported transactions
+	 */
+	void importedBatch(QList<ImportedTransaction> transactions);
+
 private:
 	/** Location of the GnuCash file */
 	const QString fileName;
@@ -150,15 +215,30 @@ private:
 	/** XML stream reader */
 	QXmlStreamReader xml;
 
-	/** Imported accounts */
-	QHash<QUuid, QSharedPointer<Account> > accounts;
-
 	/** Start date of import range filter */
 	QDate startDateFilter;
 
 	/** End date of import range filter */
 	QDate endDateFilter;
 
+	/** Number of transactions per batch, or 0 if not batching */
+	int batchSize;
+
+	/** Whether a batch has been emitted during the current import */
+	bool emittedBatch;
+
+	/** Whether uncompressed files are read from a memory mapping */
+	bool memoryMapping;
+
+	/** Size of the file being read, or 0 if unknown */
+	qint64 deviceSize;
+
+	/** Last reported progress percentage */
+	int lastProgress;
+
+	/** Whether the current import has been cancelled */
+	QAtomicInt cancelled;
+
 	/**
 	 * GnuCash account type enumeration.
 	 */
@@ -176,8 +256,19 @@ private:
 		Root
 	};
 
-	/** Account types */
-	QHash<QUuid, AccountType> accountTypes;
+	/**
+	 * Imported account, along with its GnuCash account type.
+	 */
+	struct ImportedAccount
+	{
+		/** Account */
+		QSharedPointer<Account> account;
+		/** Account type */
+		AccountType type;
+	};
+
+	/** Imported accounts, by account UID */
+	QHash<QUuid, ImportedAccount> accounts;
 
 	/** Imported transactions */
 	QList<ImportedTransaction> transactions;
@@ -207,6 +298,12 @@ private:
 	 */
 	void readVersion2Book();
 
+	/**
+	 * Emits the `progress` signal if the percentage of the file that has
+	 * been consumed has changed since it was last reported.
+	 */
+	void reportProgress();
+
 	/**
 	 * Parses the current XML stream for a version 2.0.0 account definition.
 	 *
@@ -216,8 +313,7 @@ private:
 	 *  - if the parent account does not exist (i.e., has not been previously
 	 *    defined)
 	 *
-	 * If successful, the account is created and added to the `accounts` and
-	 * `accountTypes` maps.
+	 * If successful, the account is created and added to the `accounts` map.
 	 */
 	void readVersion2Account();
 
@@ -240,10 +336,21 @@ private:
 	 *  - the `currency` element contains an invalid currency definition
 	 *
 	 * If the date-posted for the transaction is not within the valid start
-	 * and end dates, then the transaction is ignored.
+	 * and end dates, then the transaction is ignored. The remainder of the
+	 * transaction definition is skipped without being parsed as soon as
+	 * the date-posted has been read.
 	 */
 	void readVersion2Transaction();
 
+	/**
+	 * Checks if the given date is within the start and end dates of the
+	 * import range. If either date is not valid, all dates are in range.
+	 *
+	 * @param[in] date date to be checked
+	 * @return `true` if the date is within the import range
+	 */
+	bool inRange(const QDate& date) const;
+
 	/**
 	 * Parses the current XML stream for transaction split definitions.
 	 *
@@ -311,6 +418,18 @@ private:
 	 */
 	QUuid findPrimary(const QHash<QUuid, TransactionSplit>& splits);
 
+	/**
+	 * Parses the current XML element text as a GnuCash GUID.
+	 *
+	 * GnuCash GUIDs are written as 32 hexadecimal digits, which are
+	 * converted directly into the equivalent UUID. Any other text is
+	 * converted into a name-based UUID, so that it still uniquely
+	 * identifies the element.
+	 *
+	 * @return parsed UUID
+	 */
+	QUuid readGuid();
+
 	/**
 	 * Parses the current XML element stream for a date definition.
 	 *
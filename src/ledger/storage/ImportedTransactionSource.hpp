@@ -141,12 +141,25 @@ signals:
 	/**
 	 * Emitted when the import has finished and has successfully imported
 	 * a list of transactions. If the import failed or was cancelled, this
-	 * signal is not emitted.
+	 * signal is not emitted. Sources that emit their transactions in
+	 * batches do not emit this signal.
 	 *
 	 * @param transactions imported transactions
 	 */
 	void imported(QList<ImportedTransaction> transactions);
 
+	/**
+	 * If emitted, provides the next batch of imported transactions while
+	 * the import is still in progress. Batches are provided in the order
+	 * the transactions were read from the source, and the last batch is
+	 * provided before the `finished` signal is emitted. If the import
+	 * failed or was cancelled, all batches received during the import
+	 * are to be discarded.
+	 *
+	 * @param transactions batch of imported transactions
+	 */
+	void importedBatch(QList<ImportedTransaction> transactions);
+
 	/**
 	 * Emitted when new data is available for import.
 	 */
@@ -31,6 +31,21 @@ const QString UseMDI = "UseMDI";
 
 }
 
+/**
+ * Budget storage settings keys.
+ *
+ * @ingroup main
+ */
+namespace storage {
+
+//------------------------------------------------------------------------------
+const QString CompressBudgets = "CompressBudgetFiles";
+
+//------------------------------------------------------------------------------
+const QString CompressionLevel = "BudgetCompressionLevel";
+
+}
+
 /**
  * Import settings keys.
  *
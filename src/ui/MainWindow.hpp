@@ -156,6 +156,11 @@ private slots:
 	 */
 	void importTransactionsFrom();
 
+	/**
+	 * Cancels the transaction import in progress in the current session
+	 */
+	void cancelImport();
+
 	/**
 	 * Assigns imported transactions in the current session
 	 */
@@ -225,6 +230,7 @@ protected:
 	// Analyze menu actions
 	QAction* importAction;
 	QAction* importFromAction;
+	QAction* cancelImportAction;
 	QAction* assignAction;
 	QAction* calculateAction;
 	QAction* summaryAction;
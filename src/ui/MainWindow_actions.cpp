@@ -181,6 +181,15 @@ void MainWindow::importTransactionsFrom()
 	}
 }
 
+//------------------------------------------------------------------------------
+void MainWindow::cancelImport()
+{
+	if (activeSession())
+	{
+		activeSession()->cancelImport();
+	}
+}
+
 //------------------------------------------------------------------------------
 void MainWindow::assignTransactions()
 {
@@ -122,6 +122,10 @@ void MainWindow::createActions()
 	importFromAction->setStatusTip(tr("Import transactions from file"));
 	connect(importFromAction, SIGNAL(triggered()), this, SLOT(importTransactionsFrom()));
 
+	cancelImportAction = new QAction(tr("Ca&ncel import"), this);
+	cancelImportAction->setStatusTip(tr("Cancel the import in progress"));
+	connect(cancelImportAction, SIGNAL(triggered()), this, SLOT(cancelImport()));
+
 	assignAction = new QAction(Icon::assign(), tr("&Assign transactions"), this);
 	assignAction->setShortcut(QKeySequence(Qt::CTRL + Qt::SHIFT + Qt::Key_A));
 	assignAction->setIconText(tr("Assign"));
@@ -212,6 +216,7 @@ void MainWindow::createMenus()
 	analyzeMenu = menuBar()->addMenu(tr("&Analyze"));
 	analyzeMenu->addAction(importAction);
 	analyzeMenu->addAction(importFromAction);
+	analyzeMenu->addAction(cancelImportAction);
 	analyzeMenu->addAction(assignAction);
 	analyzeMenu->addAction(calculateAction);
 	analyzeMenu->addSeparator();
@@ -307,6 +312,7 @@ void MainWindow::updateMenus()
 	// Analyze menu actions
 	importAction->setEnabled(hasActiveSession);
 	importFromAction->setEnabled(hasActiveSession);
+	cancelImportAction->setEnabled(hasActiveSession);
 	assignAction->setEnabled(hasActiveSession);
 	calculateAction->setEnabled(hasActiveSession);
 	summaryAction->setEnabled(hasActiveSession);
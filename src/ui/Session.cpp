@@ -24,6 +24,7 @@
 #include "analysis/ProjectedBalance.hpp"
 #include "analysis/SortedDifferences.hpp"
 #include "analysis/TransactionAssigner.hpp"
+#include "ledger/TransactionStore.hpp"
 #include "ui/Session.hpp"
 #include "ui/analysis/AnalysisSummaryWidget.hpp"
 #include "ui/analysis/EstimateDiffsModel.hpp"
@@ -45,7 +46,8 @@ static const QString LAST_USED_TRANSACTION_SRC = "LastUsedTrnSrc";
 //------------------------------------------------------------------------------
 Session::Session(QWidget* parent)
 	: QStackedWidget(parent),
-	  isUntitled(true)
+	  isUntitled(true), receivedBatches(false),
+	  reImporting(false)
 {
 	// Setup undo stack signals/slots
 	undoStack = new QUndoStack(this);
@@ -296,6 +298,15 @@ void Session::importTransactions()
 	}
 }
 
+//------------------------------------------------------------------------------
+void Session::cancelImport()
+{
+	if (transactionSource)
+	{
+		transactionSource->cancel();
+	}
+}
+
 //------------------------------------------------------------------------------
 bool Session::reImportTransactions()
 {
@@ -345,8 +356,10 @@ void Session::importFrom(QSharedPointer<ImportedTransactionSource> newSource)
 		this, SLOT(updateProgress(int)));
 	connect(newSource.data(), SIGNAL(imported(QList<ImportedTransaction>)),
 		this, SLOT(transactionsImported(QList<ImportedTransaction>)));
+	connect(newSource.data(), SIGNAL(importedBatch(QList<ImportedTransaction>)),
+		this, SLOT(transactionsBatchImported(QList<ImportedTransaction>)));
 	connect(newSource.data(), SIGNAL(newDataAvailable()),
-		this, SLOT(importFromCurrentSource()));
+		this, SLOT(reImportFromCurrentSource()));
 
 	transactionSource = newSource;
 	importFromCurrentSource();
@@ -363,6 +376,13 @@ void Session::importFromCurrentSource()
 	}
 }
 
+//------------------------------------------------------------------------------
+void Session::reImportFromCurrentSource()
+{
+	reImporting = ! importedTransactions.isEmpty();
+	importFromCurrentSource();
+}
+
 //------------------------------------------------------------------------------
 void Session::importStarted()
 {
@@ -371,6 +391,10 @@ void Session::importStarted()
 
 	// Start indefinite progress indicator
 	emit showProgress(0, 0);
+
+	receivedBatches = false;
+	stagedTransactions.clear();
+	assigner->discardStaged();
 }
 
 //------------------------------------------------------------------------------
@@ -380,6 +404,13 @@ void Session::importFinished(ImportedTransactionSource::Result result,
 	// Clear progress indicator
 	emit showProgress(100, 100);
 
+	if (receivedBatches)
+	{
+		receivedBatches = false;
+		batchedImportFinished(result == ImportedTransactionSource::Complete);
+	}
+	reImporting = false;
+
 	if (result == ImportedTransactionSource::Cancelled)
 	{
 		emit showMessage(tr("Import cancelled."));
@@ -407,7 +438,55 @@ void Session::transactionsImported(QList<ImportedTransaction> transactions)
 	transactionsModel->setTransactions(transactions);
 	analysisSummary->setImportedTransactionSource(transactionSource->name());
 	analysisSummary->setNumberOfImportedTransactions(transactions.size());
-	assignTransactions();
+
+	if (reImporting)
+	{
+		assigner->update(importedTransactions);
+	}
+	else
+	{
+		assignTransactions();
+	}
+}
+
+//------------------------------------------------------------------------------
+void Session::transactionsBatchImported(QList<ImportedTransaction> transactions)
+{
+	// Previous results are only replaced once the import is complete
+	receivedBatches = true;
+	stagedTransactions += transactions;
+
+	// Re-imported batches are compared once the re-import is complete
+	if ( ! reImporting)
+	{
+		assigner->stage(transactions);
+	}
+}
+
+//------------------------------------------------------------------------------
+void Session::batchedImportFinished(bool complete)
+{
+	if ( ! complete)
+	{
+		// Previous results are kept if the import did not complete
+		assigner->discardStaged();
+	}
+	else if (reImporting)
+	{
+		TransactionStore::sort(stagedTransactions);
+		transactionsImported(stagedTransactions);
+	}
+	else
+	{
+		TransactionStore::sort(stagedTransactions);
+		importedTransactions = stagedTransactions;
+		transactionsModel->setTransactions(importedTransactions);
+		analysisSummary->setImportedTransactionSource(transactionSource->name());
+		analysisSummary->setNumberOfImportedTransactions(importedTransactions.size());
+		assigner->commitStaged();
+	}
+
+	stagedTransactions.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -122,6 +122,12 @@ public:
 	 */
 	void importTransactionsFrom();
 
+	/**
+	 * Cancels the transaction import in progress, if any. The previously
+	 * imported transactions are left in place.
+	 */
+	void cancelImport();
+
 	/**
 	 * Displays the analysis summary view.
 	 */
@@ -290,6 +296,18 @@ private slots:
 	 */
 	void transactionsImported(QList<ImportedTransaction> transactions);
 
+	/**
+	 * Stages a batch of transactions from an import that is still in
+	 * progress, and matches them against the assignment rules in addition
+	 * to the previous batches. The previously imported transactions are
+	 * only replaced once the import is complete. Batches of a re-import
+	 * are only stored, to be compared with the previously imported
+	 * transactions once the re-import is complete.
+	 *
+	 * @param[in] transactions batch of imported transactions
+	 */
+	void transactionsBatchImported(QList<ImportedTransaction> transactions);
+
 	/**
 	 * Emits an indefinite progress signal, to indicate that
 	 * assignment has begun.
@@ -318,6 +336,13 @@ private slots:
 	 */
 	void importFromCurrentSource();
 
+	/**
+	 * Re-imports transactions from the current imported transaction source
+	 * after it has been modified. Only the differences from the previously
+	 * imported transactions are re-assigned.
+	 */
+	void reImportFromCurrentSource();
+
 protected:
 	/**
 	 * Intercepts the window closing event to prompt the
@@ -344,6 +369,12 @@ private:
 	QList<ImportedTransaction> importedTransactions;
 	/** Imported transactions model */
 	ImportedTransactionsModel* transactionsModel;
+	/** Whether the current import has provided transactions in batches */
+	bool receivedBatches;
+	/** Whether the current import is a re-import of modified source data */
+	bool reImporting;
+	/** Transaction batches received so far during the current import */
+	QList<ImportedTransaction> stagedTransactions;
 
 	/** Actuals */
 	Actuals* actuals;
@@ -421,6 +452,18 @@ private:
 	 * @param[in] newSource new transaction source
 	 */
 	void importFrom(QSharedPointer<ImportedTransactionSource> newSource);
+
+	/**
+	 * Completes an import that provided its transactions in batches. If
+	 * the import was successful, the staged batches replace the previously
+	 * imported transactions and their assignments, and the balances are
+	 * re-calculated. A successful re-import is instead compared with the
+	 * previously imported transactions. If the import was not successful,
+	 * all batches are discarded and the previous results are left in place.
+	 *
+	 * @param[in] complete whether the import was successful
+	 */
+	void batchedImportFinished(bool complete);
 };
 
 }
@@ -34,7 +34,8 @@ EstimateModel::EstimateModel(QSharedPointer<Estimate> root,
 		QSharedPointer<BudgetingPeriod> period, AssignmentRulesModel* rules,
 		Actuals* actuals, QUndoStack* stack, QObject* parent)
 	: QAbstractItemModel(parent), root(root), period(period), rules(rules),
-	  actualsModel(actuals), undoStack(stack)
+	  actualsModel(actuals), undoStack(stack),
+	  totals(new EstimateTotalsCache(root, actuals, this))
 {
 	headers << tr("Name")
 		// Definition columns
@@ -50,7 +51,7 @@ EstimateModel::EstimateModel(QSharedPointer<Estimate> root,
 	impactColumns << 0 << 12 << 13 << 14 << 15;
 
 	connect(actualsModel, SIGNAL(actualsChanged()),
-		this, SLOT(cacheActuals()));
+		this, SLOT(actualsChanged()));
 	// Make sure we pick up changes to the budgeting period start date
 	// (have to use Qt5 style connect because of namespaced type)
 	connect(period.data(), &BudgetingPeriod::paramsChanged,
@@ -58,9 +59,8 @@ EstimateModel::EstimateModel(QSharedPointer<Estimate> root,
 }
 
 //------------------------------------------------------------------------------
-void EstimateModel::cacheActuals()
+void EstimateModel::actualsChanged()
 {
-	actuals = actualsModel->map();
 	// columns progress "estimated" to impact "notice"
 	emit dataChanged(createIndex(0, 7), createIndex(0, 15));
 }
@@ -160,8 +160,8 @@ QVariant EstimateModel::data(const QModelIndex& index, int role) const
 	Estimate* estimate = cast(index);
 	int column = index.column();
 	Estimate::Progress progress
-		= estimate->progress(actuals, period->startDate());
-	Estimate::Impact impact = estimate->impact(actuals);
+		= totals->progress(estimate, period->startDate());
+	Estimate::Impact impact = totals->impact(estimate);
 
 	switch (column)
 	{
@@ -21,6 +21,7 @@
 #include <QAbstractItemModel>
 
 // UnderBudget include(s)
+#include "analysis/EstimateTotalsCache.hpp"
 #include "budget/Estimate.hpp"
 
 namespace ub {
@@ -250,9 +251,9 @@ public slots:
 
 private slots:
 	/**
-	 * Updates the cached actuals.
+	 * Updates the actuals as a result of the actuals changing.
 	 */
-	void cacheActuals();
+	void actualsChanged();
 
 	/**
 	 * Updates the due dates as a result of the start date changing.
@@ -280,8 +281,8 @@ private:
 
 	/** Activity actuals model */
 	Actuals* actualsModel;
-	/** Cached actuals */
-	QHash<uint,Money> actuals;
+	/** Memoized estimate totals */
+	EstimateTotalsCache* totals;
 
 	/**
 	 * Extracts the estimate object referenced by the model index.
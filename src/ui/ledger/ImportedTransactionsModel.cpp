@@ -140,8 +140,7 @@ QVariant ImportedTransactionsModel::checkStateData(const QModelIndex& index) con
 	if (row < 0 || row >= transactions.size())
 		return QVariant();
 
-	ImportedTransaction transaction = transactions.at(row);
-	return (assignments->estimate(transaction.transactionId()) != 0)
+	return (assignments->estimate(transactions.transactionId(row)) != 0)
 		? Qt::Checked : Qt::Unchecked;
 }
 
@@ -152,8 +151,7 @@ QVariant ImportedTransactionsModel::displayData(const QModelIndex& index) const
 	if (row < 0 || row >= transactions.size())
 		return QVariant();
 
-	ImportedTransaction transaction = transactions.at(row);
-	uint id = transaction.transactionId();
+	uint id = transactions.transactionId(row);
 	switch (index.column())
 	{
 	case TRN_ID_COL:
@@ -163,17 +161,17 @@ QVariant ImportedTransactionsModel::displayData(const QModelIndex& index) const
 	case RULE_ID_COL:
 		return assignments->rule(id);
 	case DATE_COL:
-		return transaction.date();
+		return transactions.date(row);
 	case PAYEE_COL:
-		return transaction.payee();
+		return transactions.payee(row);
 	case MEMO_COL:
-		return transaction.memo();
+		return transactions.memo(row);
 	case AMOUNT_COL:
-		return transaction.amount().toString();
+		return transactions.amount(row).toString();
 	case WITHDRAWAL_COL:
-		return transaction.withdrawalAccount();
+		return transactions.withdrawalAccount(row);
 	case DEPOSIT_COL:
-		return transaction.depositAccount();
+		return transactions.depositAccount(row);
 	case ESTIMATE_COL:
 	{
 		uint eid = assignments->estimate(id);
@@ -202,12 +200,11 @@ QVariant ImportedTransactionsModel::editData(const QModelIndex& index) const
 	if (row < 0 || row >= transactions.size())
 		return QVariant();
 
-	ImportedTransaction transaction = transactions.at(row);
 	switch (index.column())
 	{
 	case AMOUNT_COL:
 	{
-		return QVariant::fromValue(transaction.amount());
+		return QVariant::fromValue(transactions.amount(row));
 	}
 	default:
 		return QVariant();
@@ -221,7 +218,6 @@ QVariant ImportedTransactionsModel::toolTipData(const QModelIndex& index) const
 	if (row < 0 || row >= transactions.size())
 		return QVariant();
 
-	ImportedTransaction transaction = transactions.at(row);
 	// TODO get from assignments model
 	return "Transaction assignment info";
 }
@@ -233,7 +229,7 @@ void ImportedTransactionsModel::setTransactions(const QList<ImportedTransaction>
 	transactions.clear();
 	endRemoveRows();
 	beginInsertRows(QModelIndex(), 0, trns.size()-1);
-	transactions = trns;
+	transactions = TransactionStore(trns);
 	endInsertRows();
 }
 
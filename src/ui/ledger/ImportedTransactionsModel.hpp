@@ -24,6 +24,7 @@
 
 // UnderBudget include(s)
 #include "ledger/ImportedTransaction.hpp"
+#include "ledger/TransactionStore.hpp"
 
 namespace ub {
 
@@ -103,7 +104,7 @@ private:
 	/** Assignments list */
 	Assignments* assignments;
 	/** Imported transactions list */
-	QList<ImportedTransaction> transactions;
+	TransactionStore transactions;
 
 	/**
 	 * Returns check state data for the given index.
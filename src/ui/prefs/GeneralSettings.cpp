@@ -28,6 +28,9 @@ GeneralSettings::GeneralSettings(QWidget* parent)
 	: QGroupBox(tr("General Settings"), parent)
 {
 	// Create input fields
+	compressBudgets = new QCheckBox(this);
+	compressionLevel = new QSpinBox(this);
+	compressionLevel->setRange(1, 9);
 	autoReImport = new QCheckBox(this);
 
 	// Populate with initial values
@@ -35,9 +38,21 @@ GeneralSettings::GeneralSettings(QWidget* parent)
 
 #ifndef Q_OS_WIN
 	// Connect signals for immediate-apply
+	connect(compressBudgets, SIGNAL(toggled(bool)), this, SLOT(apply()));
+	connect(compressionLevel, SIGNAL(valueChanged(int)), this, SLOT(apply()));
 	connect(autoReImport, SIGNAL(toggled(bool)), this, SLOT(apply()));
 #endif
 
+	// Budget file settings
+	QGroupBox* budgetSettings = new QGroupBox(tr("Budget File Settings"));
+	{
+		QFormLayout* form = new QFormLayout;
+		form->addRow(tr("Compress new budget files?"), compressBudgets);
+		form->addRow(tr("Compression level\n(1 is fastest, 9 is smallest)"),
+			compressionLevel);
+		budgetSettings->setLayout(form);
+	}
+
 	// Import settings
 	QGroupBox* importSettings = new QGroupBox(tr("Transaction Import Settings"));
 	{
@@ -49,6 +64,7 @@ GeneralSettings::GeneralSettings(QWidget* parent)
 
 	// Put it all together...
 	QVBoxLayout* layout = new QVBoxLayout;
+	layout->addWidget(budgetSettings);
 	layout->addWidget(importSettings);
 	setLayout(layout);
 }
@@ -57,6 +73,8 @@ GeneralSettings::GeneralSettings(QWidget* parent)
 void GeneralSettings::apply()
 {
 	QSettings settings;
+	settings.setValue(storage::CompressBudgets, compressBudgets->isChecked());
+	settings.setValue(storage::CompressionLevel, compressionLevel->value());
 	settings.setValue(import::AutoReImport, autoReImport->isChecked());
 }
 
@@ -64,6 +82,8 @@ void GeneralSettings::apply()
 void GeneralSettings::reset()
 {
 	QSettings settings;
+	compressBudgets->setChecked(settings.value(storage::CompressBudgets).toBool());
+	compressionLevel->setValue(settings.value(storage::CompressionLevel, 6).toInt());
 	autoReImport->setChecked(settings.value(import::AutoReImport).toBool());
 }
 
@@ -22,6 +22,7 @@
 
 // Forward declaration(s)
 class QCheckBox;
+class QSpinBox;
 
 namespace ub {
 
@@ -54,6 +55,10 @@ public slots:
 	void reset();
 
 private:
+	/** Compress new budget files */
+	QCheckBox* compressBudgets;
+	/** Budget file compression level */
+	QSpinBox* compressionLevel;
 	/** Auto re-import */
 	QCheckBox* autoReImport;
 };
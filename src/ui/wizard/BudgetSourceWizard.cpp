@@ -18,7 +18,9 @@
 #include <QtWidgets>
 
 // UnderBudget include(s)
+#include "budget/storage/SqlBudgetFile.hpp"
 #include "budget/storage/XmlBudgetFile.hpp"
+#include "settings.hpp"
 #include "ui/wizard/BudgetSourceWizard.hpp"
 
 namespace ub {
@@ -60,7 +62,7 @@ QSharedPointer<BudgetSource> BudgetSourceWizard::promptForBudgetToOpen(
 	QString fileName = QFileDialog::getOpenFileName(parent,
 		QObject::tr("Open Budget File"),
 		settings.value(LAST_USED_BUDGET_DIR).toString(),
-		QObject::tr("Budgets (*.budget *.xml);;All (*)"));
+		QObject::tr("Budgets (*.budget *.budget.gz *.xml *.xml.gz *.sqlite);;All (*)"));
 
 	QSharedPointer<BudgetSource> source;
 
@@ -97,7 +99,7 @@ QSharedPointer<BudgetSource> BudgetSourceWizard::promptForBudgetToSave(
 
 	QString fileName = QFileDialog::getSaveFileName(parent,
 		QObject::tr("Save Budget File"),
-		dir, QObject::tr("Budgets (*.budget *.xml);;All (*)"));
+		dir, QObject::tr("Budgets (*.budget *.budget.gz *.xml *.xml.gz *.sqlite);;All (*)"));
 
 	QSharedPointer<BudgetSource> source;
 
@@ -130,8 +132,23 @@ void BudgetSourceWizard::recordLastUsedPath(const QString& fileName)
 //------------------------------------------------------------------------------
 BudgetSource* BudgetSourceWizard::createForFile(const QString& fileName)
 {
-	if (fileName.endsWith("budget") || fileName.endsWith("xml"))
-		return new XmlBudgetFile(fileName);
+	if (fileName.endsWith("budget") || fileName.endsWith("xml")
+		|| fileName.endsWith("budget.gz") || fileName.endsWith("xml.gz"))
+	{
+		XmlBudgetFile* file = new XmlBudgetFile(fileName);
+
+		QSettings settings;
+		if (settings.value(storage::CompressBudgets).toBool())
+		{
+			file->setCompressed(true);
+		}
+		file->setCompressionLevel(
+			settings.value(storage::CompressionLevel, -1).toInt());
+
+		return file;
+	}
+	else if (fileName.endsWith("sqlite"))
+		return new SqlBudgetFile(fileName);
 	else
 		return 0;
 }
@@ -121,4 +121,47 @@ void CurrencyTest::conversionRate()
 	QCOMPARE(source.conversionRate(target, rates), rate);
 }
 
+//------------------------------------------------------------------------------
+void CurrencyTest::interning()
+{
+	Currency usd("USD");
+	Currency copy(usd);
+	Currency other(QString("U") + QString("SD"));
+	Currency eur("EUR");
+
+	QCOMPARE(copy.id(), usd.id());
+	QCOMPARE(other.id(), usd.id());
+	QVERIFY(eur.id() != usd.id());
+	QCOMPARE(other.code(), QString("USD"));
+	QCOMPARE(eur.code(), QString("EUR"));
+}
+
+//------------------------------------------------------------------------------
+void CurrencyTest::internOverflow()
+{
+	Currency usd("USD");
+	int count = 0;
+	while ((count <= Currency::INVALID_ID)
+		&& Currency(QString("X%1").arg(count)).isValid())
+	{
+		++count;
+	}
+	QVERIFY(count < Currency::INVALID_ID);
+
+	Currency overflow("OVERFLOW");
+	QVERIFY( ! overflow.isValid());
+	QCOMPARE(overflow.id(), Currency::INVALID_ID);
+	QCOMPARE(overflow.code(), QString());
+
+	// Invalid currencies do not alias any other currency
+	QVERIFY(overflow != usd);
+	QVERIFY( ! (overflow == overflow));
+	QVERIFY(overflow != Currency("ANOTHER"));
+
+	// Previously interned currencies are unaffected
+	QVERIFY(usd.isValid());
+	QCOMPARE(Currency("USD"), usd);
+	QCOMPARE(usd.code(), QString("USD"));
+}
+
 }
@@ -59,6 +59,17 @@ private slots:
 	 * Test data for conversion rate
 	 */
 	void conversionRate_data();
+
+	/**
+	 * Tests interning of currency codes
+	 */
+	void interning();
+
+	/**
+	 * Tests that currencies beyond the interning capacity are invalid.
+	 * This fills the intern table, so it must be the last test run.
+	 */
+	void internOverflow();
 };
 
 }
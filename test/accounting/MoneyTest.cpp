@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+// std include(s)
+#include <limits>
+
 // UnderBudget include(s)
 #include "accounting/ConversionRatesSource.hpp"
 #include "accounting/Money.hpp"
@@ -554,5 +557,467 @@ void MoneyTest::conversion()
 	QCOMPARE(local.toLocal(), Money(8.0, "USD"));
 }
 
+//------------------------------------------------------------------------------
+void MoneyTest::valueSemantics()
+{
+	Money money(-12.34, "UAH");
+
+	QVariant variant = QVariant::fromValue(money);
+	QCOMPARE(variant.value<Money>(), money);
+
+	QVector<Money> values(3, money);
+	values.insert(1, Money(5.0, "USD"));
+	QCOMPARE(values.at(0), money);
+	QCOMPARE(values.at(1), Money(5.0, "USD"));
+	QCOMPARE(values.at(3), money);
+
+	// An amount and an interned currency ID, no heap-allocated members
+	QVERIFY(sizeof(Money) <= 2 * sizeof(qint64));
+}
+
+//------------------------------------------------------------------------------
+void MoneyTest::largeAmounts()
+{
+	Money first(1500000.25, "USD");
+	Money second(2750000.5, "USD");
+
+	QCOMPARE((first + second).amount(), 4250000.75);
+	QCOMPARE((first - second).amount(), -1250000.25);
+	QCOMPARE((second * 4.0).amount(), 11000002.0);
+	QCOMPARE((second / 2.0).amount(), 1375000.25);
+	QVERIFY(second > first);
+	QCOMPARE(Money(987654321.1234, "USD").amount(), 987654321.1234);
+}
+
+//------------------------------------------------------------------------------
+void MoneyTest::saturation()
+{
+	// Scaled amount of about 9 * 10^18, just under the 64-bit limit
+	Money huge(900000000000000.0, "USD");
+	Money largest = huge * 4.0;
+	Money smallest = huge * -4.0;
+
+	QCOMPARE(smallest, -largest);
+	QCOMPARE(huge + huge, largest);
+	QCOMPARE(-huge - huge, smallest);
+	QCOMPARE(huge - (-huge), largest);
+	QCOMPARE(-huge + (-huge), smallest);
+
+	Money sum(huge);
+	sum += huge;
+	sum += huge;
+	QCOMPARE(sum, largest);
+
+	// Amounts beyond the limit are clamped when constructed
+	QCOMPARE(Money(1e20, "USD"), largest);
+	QCOMPARE(Money(-1e20, "USD"), smallest);
+	QCOMPARE(Money(std::numeric_limits<double>::infinity(), "USD"), largest);
+	QCOMPARE(Money(std::numeric_limits<double>::quiet_NaN(), "USD"),
+		Money(0.0, "USD"));
+
+	// Values below the limit are unaffected
+	QCOMPARE((huge + huge) - huge, largest - huge);
+	QCOMPARE(huge + (-huge), Money(0.0, "USD"));
+}
+
+//------------------------------------------------------------------------------
+void MoneyTest::rounding_data()
+{
+	QTest::addColumn<Money>("money");
+	QTest::addColumn<double>("factor");
+	QTest::addColumn<bool>("divide");
+	QTest::addColumn<int>("rounding");
+	QTest::addColumn<Money>("result");
+
+	// 0.0001 / 2 = 0.00005
+	QTest::newRow("half-toward-zero") << Money(0.0001) << 2.0 << true
+		<< (int) Money::TowardZero << Money(0.0);
+	QTest::newRow("half-floor") << Money(0.0001) << 2.0 << true
+		<< (int) Money::Floor << Money(0.0);
+	QTest::newRow("half-ceiling") << Money(0.0001) << 2.0 << true
+		<< (int) Money::Ceiling << Money(0.0001);
+	QTest::newRow("half-away") << Money(0.0001) << 2.0 << true
+		<< (int) Money::HalfAwayFromZero << Money(0.0001);
+	QTest::newRow("half-even-down") << Money(0.0001) << 2.0 << true
+		<< (int) Money::HalfEven << Money(0.0);
+	QTest::newRow("half-even-up") << Money(0.0003) << 2.0 << true
+		<< (int) Money::HalfEven << Money(0.0002);
+
+	// -0.0003 / 2 = -0.00015
+	QTest::newRow("neg-toward-zero") << Money(-0.0003) << 2.0 << true
+		<< (int) Money::TowardZero << Money(-0.0001);
+	QTest::newRow("neg-floor") << Money(-0.0003) << 2.0 << true
+		<< (int) Money::Floor << Money(-0.0002);
+	QTest::newRow("neg-ceiling") << Money(-0.0003) << 2.0 << true
+		<< (int) Money::Ceiling << Money(-0.0001);
+	QTest::newRow("neg-half-away") << Money(-0.0003) << 2.0 << true
+		<< (int) Money::HalfAwayFromZero << Money(-0.0002);
+
+	// 10 / 3 = 3.33333...
+	QTest::newRow("third-toward-zero") << Money(10.0) << 3.0 << true
+		<< (int) Money::TowardZero << Money(3.3333);
+	QTest::newRow("third-ceiling") << Money(10.0) << 3.0 << true
+		<< (int) Money::Ceiling << Money(3.3334);
+
+	// 1 * 0.3 is exactly 0.3, even though 0.3 is not exact in binary
+	QTest::newRow("decimal-factor") << Money(1.0) << 0.3 << false
+		<< (int) Money::TowardZero << Money(0.3);
+	// 0.0005 * 0.15 = 0.000075
+	QTest::newRow("multiply-half-away") << Money(0.0005) << 0.15 << false
+		<< (int) Money::HalfAwayFromZero << Money(0.0001);
+	QTest::newRow("multiply-floor") << Money(0.0005) << 0.15 << false
+		<< (int) Money::Floor << Money(0.0);
+	QTest::newRow("multiply-negative") << Money(0.0005) << -0.15 << false
+		<< (int) Money::Floor << Money(-0.0001);
+}
+
+//------------------------------------------------------------------------------
+void MoneyTest::rounding()
+{
+	QFETCH(Money, money);
+	QFETCH(double, factor);
+	QFETCH(bool, divide);
+	QFETCH(int, rounding);
+	QFETCH(Money, result);
+
+	Money::Rounding mode = (Money::Rounding) rounding;
+	if (divide)
+	{
+		QCOMPARE(money.dividedBy(factor, mode), result);
+	}
+	else
+	{
+		QCOMPARE(money.multipliedBy(factor, mode), result);
+	}
+}
+
+//------------------------------------------------------------------------------
+// Arbitrary-precision decimal reference, with digits stored least
+// significant first
+typedef QVector<int> Digits;
+
+//------------------------------------------------------------------------------
+static Digits toDigits(quint64 value)
+{
+	Digits digits;
+	do
+	{
+		digits.append(value % 10);
+		value /= 10;
+	} while (value > 0);
+	return digits;
+}
+
+//------------------------------------------------------------------------------
+static Digits multiplyDigits(const Digits& lhs, const Digits& rhs)
+{
+	Digits product(lhs.size() + rhs.size(), 0);
+	for (int i=0; i<lhs.size(); ++i)
+	{
+		int carry = 0;
+		for (int j=0; j<rhs.size() || carry; ++j)
+		{
+			int value = product.at(i + j) + carry
+				+ ((j < rhs.size()) ? lhs.at(i) * rhs.at(j) : 0);
+			product[i + j] = value % 10;
+			carry = value / 10;
+		}
+	}
+	return product;
+}
+
+//------------------------------------------------------------------------------
+static Digits divideDigits(const Digits& dividend, quint64 divisor,
+	quint64& remainder)
+{
+	Digits quotient(dividend.size(), 0);
+	remainder = 0;
+	for (int i=dividend.size()-1; i>=0; --i)
+	{
+		remainder = remainder * 10 + dividend.at(i);
+		quotient[i] = remainder / divisor;
+		remainder %= divisor;
+	}
+	return quotient;
+}
+
+//------------------------------------------------------------------------------
+static qint64 fromDigits(const Digits& digits)
+{
+	static const qint64 LIMIT = std::numeric_limits<qint64>::max() / 10 - 1;
+
+	qint64 value = 0;
+	for (int i=digits.size()-1; i>=0; --i)
+	{
+		// Saturate rather than overflow
+		if (value > LIMIT)
+			return std::numeric_limits<qint64>::max();
+		value = value * 10 + digits.at(i);
+	}
+	return value;
+}
+
+//------------------------------------------------------------------------------
+static qint64 reference(qint64 value, quint64 numerator, quint64 denominator,
+	bool negativeFactor, Money::Rounding rounding)
+{
+	bool negative = (value < 0) != negativeFactor;
+	quint64 remainder;
+	Digits product = multiplyDigits(toDigits(qAbs(value)), toDigits(numerator));
+	qint64 quotient = fromDigits(divideDigits(product, denominator, remainder));
+
+	if (remainder != 0)
+	{
+		bool up = false;
+		switch (rounding)
+		{
+		case Money::Floor:
+			up = negative;
+			break;
+		case Money::Ceiling:
+			up = ! negative;
+			break;
+		case Money::HalfAwayFromZero:
+			up = (2 * remainder >= denominator);
+			break;
+		case Money::HalfEven:
+			up = (2 * remainder > denominator)
+				|| ((2 * remainder == denominator) && (quotient % 2));
+			break;
+		default:
+			break;
+		}
+		if (up)
+		{
+			++quotient;
+		}
+	}
+
+	return negative ? -quotient : quotient;
+}
+
+//------------------------------------------------------------------------------
+static quint64 nextRandom(quint64& state)
+{
+	// xorshift, so that the generated operands are reproducible
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+	return state;
+}
+
+//------------------------------------------------------------------------------
+void MoneyTest::roundingProperties()
+{
+	quint64 state = 88172645463325252ULL;
+
+	for (int i=0; i<20000; ++i)
+	{
+		// Up to 28 bits of scaled amount, so that amount() is exact
+		qint64 scaled = (qint64) (nextRandom(state) % (1ULL << 28))
+			- (1LL << 27);
+		Money money(scaled / 10000.0, "USD");
+
+		// Scalar of up to 12 decimal places and 15 significant digits
+		int places = nextRandom(state) % 13;
+		quint64 denominator = 1;
+		for (int p=0; p<places; ++p)
+		{
+			denominator *= 10;
+		}
+		quint64 numerator = nextRandom(state) % (denominator * 1000) + 1;
+		bool negative = nextRandom(state) % 2;
+		double scalar = QString("%1%2e-%3").arg(negative ? "-" : "")
+			.arg(numerator).arg(places).toDouble();
+
+		Money::Rounding rounding = (Money::Rounding) (nextRandom(state) % 5);
+
+		qint64 product = qRound64(
+			money.multipliedBy(scalar, rounding).amount() * 10000);
+		qint64 expectedProduct = reference(scaled, numerator, denominator,
+			negative, rounding);
+		if (product != expectedProduct)
+		{
+			QFAIL(qPrintable(QString("%1 * %2 (mode %3) = %4, expected %5")
+				.arg(scaled).arg(scalar, 0, 'g', 17).arg(rounding)
+				.arg(product).arg(expectedProduct)));
+		}
+
+		// Only compare quotients small enough for amount() to be exact
+		qint64 expectedQuotient = reference(scaled, denominator, numerator,
+			negative, rounding);
+		if (qAbs(expectedQuotient) < (1LL << 40))
+		{
+			qint64 quotient = qRound64(
+				money.dividedBy(scalar, rounding).amount() * 10000);
+			if (quotient != expectedQuotient)
+			{
+				QFAIL(qPrintable(QString("%1 / %2 (mode %3) = %4, expected %5")
+					.arg(scaled).arg(scalar, 0, 'g', 17).arg(rounding)
+					.arg(quotient).arg(expectedQuotient)));
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+void MoneyTest::additionBenchmark()
+{
+	QVector<Money> values;
+	for (int i=0; i<10000; ++i)
+	{
+		values.append(Money(i * 1.25, "USD"));
+	}
+
+	Money sum(0.0, "USD");
+	QBENCHMARK
+	{
+		for (int i=0; i<values.size(); ++i)
+		{
+			sum += values.at(i);
+		}
+	}
+	QVERIFY( ! sum.isNegative());
+}
+
+//------------------------------------------------------------------------------
+void MoneyTest::multiplicationBenchmark_data()
+{
+	QTest::addColumn<bool>("baseline");
+	QTest::addColumn<double>("factor");
+
+	QTest::newRow("baseline-decimal") << true << 0.77;
+	QTest::newRow("exact-decimal") << false << 0.77;
+	QTest::newRow("baseline-integer") << true << 3.0;
+	QTest::newRow("exact-integer") << false << 3.0;
+}
+
+//------------------------------------------------------------------------------
+void MoneyTest::multiplicationBenchmark()
+{
+	QFETCH(bool, baseline);
+	QFETCH(double, factor);
+
+	Money money(1234.5678, "USD");
+	Money sum(0.0, "USD");
+
+	if (baseline)
+	{
+		// Scaled amount multiplied as a double and truncated, as before
+		// the exact 128-bit arithmetic was introduced
+		QBENCHMARK
+		{
+			for (int i=0; i<10000; ++i)
+			{
+				sum += Money::fromScaled((qint64) (money.scaled() * factor),
+					money.currency());
+			}
+		}
+		QVERIFY( ! sum.isNegative());
+	}
+	else
+	{
+		QBENCHMARK
+		{
+			for (int i=0; i<10000; ++i)
+			{
+				sum += money * factor;
+			}
+		}
+		QVERIFY( ! sum.isNegative());
+	}
+}
+
+//------------------------------------------------------------------------------
+void MoneyTest::divisionBenchmark_data()
+{
+	QTest::addColumn<bool>("baseline");
+	QTest::addColumn<double>("divisor");
+
+	QTest::newRow("baseline-decimal") << true << 0.125;
+	QTest::newRow("exact-decimal") << false << 0.125;
+	QTest::newRow("baseline-integer") << true << 4.0;
+	QTest::newRow("exact-integer") << false << 4.0;
+}
+
+//------------------------------------------------------------------------------
+void MoneyTest::divisionBenchmark()
+{
+	QFETCH(bool, baseline);
+	QFETCH(double, divisor);
+
+	Money money(1234.5678, "USD");
+	Money sum(0.0, "USD");
+
+	if (baseline)
+	{
+		QBENCHMARK
+		{
+			for (int i=0; i<10000; ++i)
+			{
+				sum += Money::fromScaled(
+					(qint64) ((double) money.scaled() / divisor),
+					money.currency());
+			}
+		}
+		QVERIFY( ! sum.isNegative());
+	}
+	else
+	{
+		QBENCHMARK
+		{
+			for (int i=0; i<10000; ++i)
+			{
+				sum += money / divisor;
+			}
+		}
+		QVERIFY( ! sum.isNegative());
+	}
+}
+
+//------------------------------------------------------------------------------
+void MoneyTest::conversionBenchmark_data()
+{
+	QTest::addColumn<bool>("baseline");
+
+	QTest::newRow("baseline") << true;
+	QTest::newRow("exact") << false;
+}
+
+//------------------------------------------------------------------------------
+void MoneyTest::conversionBenchmark()
+{
+	QFETCH(bool, baseline);
+
+	Money money(1234.5678, "EUR");
+	Money sum(0.0, "USD");
+
+	if (baseline)
+	{
+		// Rate looked up and applied as a double, as before the exact
+		// 128-bit arithmetic was introduced
+		QBENCHMARK
+		{
+			for (int i=0; i<10000; ++i)
+			{
+				double rate = money.currency().conversionRate(sum.currency());
+				sum += Money::fromScaled((qint64) (money.scaled() * rate),
+					sum.currency());
+			}
+		}
+		QVERIFY( ! sum.isNegative());
+	}
+	else
+	{
+		QBENCHMARK
+		{
+			for (int i=0; i<10000; ++i)
+			{
+				sum += money;
+			}
+		}
+		QVERIFY( ! sum.isNegative());
+	}
 }
 
+}
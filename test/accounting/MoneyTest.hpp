@@ -252,6 +252,75 @@ private slots:
 	 * Tests explicit conversion.
 	 */
 	void conversion();
+
+	/**
+	 * Tests storage of money values in variants and containers.
+	 */
+	void valueSemantics();
+
+	/**
+	 * Tests arithmetic with amounts that exceed 32-bit scaled values.
+	 */
+	void largeAmounts();
+
+	/**
+	 * Tests that all arithmetic saturates consistently on overflow.
+	 */
+	void saturation();
+
+	/**
+	 * Tests explicit rounding modes.
+	 */
+	void rounding();
+
+	/**
+	 * Test data for explicit rounding modes.
+	 */
+	void rounding_data();
+
+	/**
+	 * Tests multiplication and division against an arbitrary-precision
+	 * reference implementation, with randomly generated operands.
+	 */
+	void roundingProperties();
+
+	/**
+	 * Benchmarks addition of money values.
+	 */
+	void additionBenchmark();
+
+	/**
+	 * Benchmarks multiplication of money values by scalars, alongside
+	 * the floating-point formula that it replaced.
+	 */
+	void multiplicationBenchmark();
+
+	/**
+	 * Test data for the multiplication benchmark.
+	 */
+	void multiplicationBenchmark_data();
+
+	/**
+	 * Benchmarks division of money values by scalars, alongside
+	 * the floating-point formula that it replaced.
+	 */
+	void divisionBenchmark();
+
+	/**
+	 * Test data for the division benchmark.
+	 */
+	void divisionBenchmark_data();
+
+	/**
+	 * Benchmarks addition of money values in different currencies,
+	 * alongside the floating-point conversion that it replaced.
+	 */
+	void conversionBenchmark();
+
+	/**
+	 * Test data for the conversion benchmark.
+	 */
+	void conversionBenchmark_data();
 };
 
 }
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+// Qt include(s)
+#include <QSqlDatabase>
+
 // UnderBudget include(s)
 #include "accounting/UserConversionRates.hpp"
 #include "UserConversionRatesTest.hpp"
@@ -97,5 +100,17 @@ void UserConversionRatesTest::open()
 	QCOMPARE(rates->get("EUR", "USD"), 1.0);
 }
 
+//------------------------------------------------------------------------------
+void UserConversionRatesTest::cachedLookup()
+{
+	// with the database closed, any query would fail
+	QSqlDatabase::database("UserConversionRates", false).close();
+
+	QCOMPARE(rates->get("EUR", "USD"), 1.29);
+	QCOMPARE(rates->get("UAH", "EUR"), 0.10);
+	QCOMPARE(rates->get("USD", "USD"), 1.0);
+	QCOMPARE(rates->get("USD", "GBP"), 1.0);
+}
+
 }
 
@@ -69,6 +69,12 @@ private slots:
 	 */
 	void open();
 
+	/**
+	 * Tests that conversion rates are retrieved without
+	 * querying the database.
+	 */
+	void cachedLookup();
+
 private:
 	UserConversionRates* rates;
 };
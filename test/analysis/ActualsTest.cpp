@@ -16,6 +16,7 @@
 
 // UnderBudget include(s)
 #include "analysis/Actuals.hpp"
+#include "analysis/ChangeBatch.hpp"
 #include "ActualsTest.hpp"
 
 //------------------------------------------------------------------------------
@@ -47,5 +48,87 @@ void ActualsTest::sumOfContributingActuals()
 	QCOMPARE(actuals.forEstimate(4), Money(50.25, "USD"));
 }
 
+//------------------------------------------------------------------------------
+void ActualsTest::batchedNotifications()
+{
+	qRegisterMetaType<QList<uint> >();
+	Actuals actuals;
+	QSignalSpy changedSpy(&actuals, SIGNAL(actualsChanged()));
+	QSignalSpy estimatesSpy(&actuals, SIGNAL(estimatesChanged(QList<uint>)));
+
+	{
+		ChangeBatch<Actuals> batch(&actuals);
+		actuals.record(4, Money(10, "USD"));
+
+		{
+			// Nested batches only notify when the outermost one closes
+			ChangeBatch<Actuals> nested(&actuals);
+			actuals.record(8, Money(45.25, "USD"));
+		}
+		QCOMPARE(changedSpy.count(), 0);
+
+		actuals.record(4, Money(-5, "USD"));
+		QCOMPARE(changedSpy.count(), 0);
+	}
+
+	QCOMPARE(changedSpy.count(), 1);
+	QCOMPARE(estimatesSpy.count(), 1);
+	QList<uint> estimateIds = estimatesSpy.at(0).at(0).value<QList<uint> >();
+	qSort(estimateIds);
+	QCOMPARE(estimateIds, QList<uint>() << 4 << 8);
+	QCOMPARE(actuals.forEstimate(4), Money(5, "USD"));
+
+	// Empty batches do not notify
+	{
+		ChangeBatch<Actuals> batch(&actuals);
+	}
+	QCOMPARE(changedSpy.count(), 1);
+
+	// Outside of a batch, every modification notifies
+	actuals.record(4, Money(1, "USD"));
+	QCOMPARE(changedSpy.count(), 2);
+	QCOMPARE(estimatesSpy.last().at(0).value<QList<uint> >(),
+		QList<uint>() << 4);
 }
 
+//------------------------------------------------------------------------------
+void ActualsTest::recordBenchmark_data()
+{
+	QTest::addColumn<bool>("batched");
+	QTest::addColumn<int>("notifications");
+
+	QTest::newRow("unbatched") << false << 50000;
+	QTest::newRow("batched") << true << 1;
+}
+
+//------------------------------------------------------------------------------
+void ActualsTest::recordBenchmark()
+{
+	QFETCH(bool, batched);
+	QFETCH(int, notifications);
+
+	Actuals actuals;
+	int count = 0;
+
+	QBENCHMARK
+	{
+		actuals.clear();
+		QSignalSpy spy(&actuals, SIGNAL(actualsChanged()));
+
+		if (batched)
+			actuals.beginBatch();
+		for (int i=0; i<50000; ++i)
+		{
+			actuals.record(i % 500, Money(1.25, "USD"));
+		}
+		if (batched)
+			actuals.endBatch();
+
+		count = spy.count();
+	}
+
+	QCOMPARE(count, notifications);
+	QCOMPARE(actuals.forEstimate(7), Money(125, "USD"));
+}
+
+}
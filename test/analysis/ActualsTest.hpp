@@ -41,6 +41,22 @@ private slots:
 	 * to the same estimate.
 	 */
 	void sumOfContributingActuals();
+
+	/**
+	 * Tests that change notifications are coalesced within a batch.
+	 */
+	void batchedNotifications();
+
+	/**
+	 * Benchmarks the recording of many actuals, with and without
+	 * a batch, verifying the number of change notifications.
+	 */
+	void recordBenchmark();
+
+	/**
+	 * Test data for the recording benchmark.
+	 */
+	void recordBenchmark_data();
 };
 
 }
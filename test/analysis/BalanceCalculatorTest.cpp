@@ -166,5 +166,47 @@ void BalanceCalculatorTest::underBudgetEstimates()
 	QCOMPARE(under.difference(1), Money(2, "USD"));
 }
 
+//------------------------------------------------------------------------------
+void BalanceCalculatorTest::largeBudgetBenchmark()
+{
+	QSharedPointer<Estimate> root = Estimate::createRoot();
+	QSharedPointer<Actuals> actuals(new Actuals);
+	uint id = 1;
+	for (int i=0; i<50; ++i)
+	{
+		Estimate* category = Estimate::create(root.data(), id++,
+			QString("Category %1").arg(i), "", Estimate::Expense,
+			Money(), -1, false);
+		for (int j=0; j<100; ++j)
+		{
+			uint childId = id++;
+			Estimate::create(category, childId, QString("Expense %1").arg(j),
+				"", Estimate::Expense, Money(10, "USD"), -1, false);
+			actuals->record(childId, Money(j % 20, "USD"));
+		}
+	}
+
+	ProjectedBalance estimated, actual, expected;
+	SortedDifferences over, under;
+	BalanceCalculator calculator(root, actuals.data(),
+		&estimated, &actual, &expected, &over, &under);
+
+	int balanceNotifications = 0;
+	int listNotifications = 0;
+
+	QBENCHMARK
+	{
+		QSignalSpy balanceSpy(&estimated, SIGNAL(balanceChanged()));
+		QSignalSpy listSpy(&over, SIGNAL(listChanged()));
+		calculator.calculateBalances();
+		balanceNotifications = balanceSpy.count();
+		listNotifications = listSpy.count();
+	}
+
+	// Previously one per estimate, plus clearing and sorting
+	QCOMPARE(balanceNotifications, 1);
+	QCOMPARE(listNotifications, 1);
+	QCOMPARE(estimated.value(), Money(-50000, "USD"));
 }
 
+}
@@ -51,6 +51,12 @@ private slots:
 	 * Tests the recording of under-budget estimates.
 	 */
 	void underBudgetEstimates();
+
+	/**
+	 * Benchmarks the calculation of balances for a large budget,
+	 * verifying that each result is only notified once.
+	 */
+	void largeBudgetBenchmark();
 };
 
 }
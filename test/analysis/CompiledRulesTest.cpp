@@ -0,0 +1,263 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Qt include(s)
+#include <QtCore>
+#include <QUndoCommand>
+
+// UnderBudget include(s)
+#include "accounting/Money.hpp"
+#include "analysis/CompiledRules.hpp"
+#include "budget/AssignmentRule.hpp"
+#include "budget/AssignmentRules.hpp"
+#include "ledger/Account.hpp"
+#include "ledger/ImportedTransaction.hpp"
+#include "CompiledRulesTest.hpp"
+
+//------------------------------------------------------------------------------
+QTEST_MAIN(ub::CompiledRulesTest)
+
+namespace ub {
+
+//------------------------------------------------------------------------------
+static const uint RULE_1 = 1111;
+static const uint RULE_2 = 2222;
+static const uint RULE_3 = 3333;
+static const uint ESTIMATE_1 = 1234;
+static const uint ESTIMATE_2 = 2234;
+static const uint ESTIMATE_3 = 3234;
+
+//------------------------------------------------------------------------------
+static ImportedTransaction groceries()
+{
+	return ImportedTransaction(1, QDate(2015, 1, 10), Money(25, "USD"),
+		"Grocery Store", "weekly",
+		QSharedPointer<Account>(new Account("bank")),
+		QSharedPointer<Account>(new Account("food")));
+}
+
+//------------------------------------------------------------------------------
+static ImportedTransaction bankFee()
+{
+	return ImportedTransaction(2, QDate(2015, 1, 12), Money(5, "USD"),
+		"Bank Fee", "",
+		QSharedPointer<Account>(new Account("bank")),
+		QSharedPointer<Account>(new Account("fees")));
+}
+
+//------------------------------------------------------------------------------
+void CompiledRulesTest::init()
+{
+	rules = AssignmentRules::create();
+	QList<AssignmentRule::Condition> conds;
+
+	conds << AssignmentRule::Condition(AssignmentRule::Payee,
+		AssignmentRule::Contains, true, "STORE");
+	rule1 = rules->createRule(RULE_1, ESTIMATE_1, conds);
+
+	conds.clear();
+	conds << AssignmentRule::Condition(AssignmentRule::Payee,
+		AssignmentRule::BeginsWith, false, "grocery");
+	conds << AssignmentRule::Condition(AssignmentRule::Date,
+		AssignmentRule::After, false, "2015-01-01");
+	rule2 = rules->createRule(RULE_2, ESTIMATE_2, conds);
+
+	conds.clear();
+	conds << AssignmentRule::Condition(AssignmentRule::Amount,
+		AssignmentRule::GreaterThan, false, "10,USD");
+	rule3 = rules->createRule(RULE_3, ESTIMATE_3, conds);
+}
+
+//------------------------------------------------------------------------------
+void CompiledRulesTest::initialMatch()
+{
+	CompiledRules compiled(rules);
+
+	QCOMPARE(compiled.size(), 3);
+	QCOMPARE(compiled.match(groceries()), 1);
+	QCOMPARE(compiled.ruleId(1), RULE_2);
+	QCOMPARE(compiled.estimateId(1), ESTIMATE_2);
+	QCOMPARE(compiled.match(bankFee()), -1);
+	QCOMPARE(compiled.ruleId(3), 0u);
+}
+
+//------------------------------------------------------------------------------
+void CompiledRulesTest::caseInsensitiveMatch()
+{
+	CompiledRules compiled(rules);
+	CompiledRules::Fields fields(groceries());
+
+	QCOMPARE(compiled.matches(fields, 0), false);
+	QCOMPARE(compiled.matches(fields, 1), true);
+	QCOMPARE(compiled.match(fields, 2), 2);
+}
+
+//------------------------------------------------------------------------------
+void CompiledRulesTest::anchoredKeys()
+{
+	QFETCH(int, op);
+	QFETCH(bool, sensitive);
+	QFETCH(QString, value);
+	QFETCH(QString, payee);
+	QFETCH(int, expected);
+
+	QSharedPointer<AssignmentRules> keyed = AssignmentRules::create();
+	QList<AssignmentRule::Condition> conds;
+	conds << AssignmentRule::Condition(AssignmentRule::Payee,
+		AssignmentRule::Operator(op), sensitive, value);
+	keyed->createRule(RULE_1, ESTIMATE_1, conds);
+
+	conds.clear();
+	conds << AssignmentRule::Condition(AssignmentRule::Memo,
+		AssignmentRule::StringEquals, false, "fallback");
+	keyed->createRule(RULE_2, ESTIMATE_2, conds);
+
+	CompiledRules compiled(keyed);
+	QCOMPARE(compiled.match(ImportedTransaction(1, QDate(2015, 1, 10),
+		Money(25, "USD"), payee, "Fallback",
+		QSharedPointer<Account>(new Account("bank")),
+		QSharedPointer<Account>(new Account("food")))), expected);
+}
+
+//------------------------------------------------------------------------------
+void CompiledRulesTest::anchoredKeys_data()
+{
+	QTest::addColumn<int>("op");
+	QTest::addColumn<bool>("sensitive");
+	QTest::addColumn<QString>("value");
+	QTest::addColumn<QString>("payee");
+	QTest::addColumn<int>("expected");
+
+	QTest::newRow("begins-match") << int(AssignmentRule::BeginsWith)
+		<< true << "Gas" << "Gas Station" << 0;
+	QTest::newRow("begins-mid") << int(AssignmentRule::BeginsWith)
+		<< true << "Gas" << "Big Gas" << 1;
+	QTest::newRow("ends-match") << int(AssignmentRule::EndsWith)
+		<< false << "STATION" << "Gas Station" << 0;
+	QTest::newRow("ends-mid") << int(AssignmentRule::EndsWith)
+		<< false << "gas" << "Gas Station" << 1;
+	QTest::newRow("equals-match") << int(AssignmentRule::StringEquals)
+		<< false << "gas station" << "Gas Station" << 0;
+	QTest::newRow("equals-partial") << int(AssignmentRule::StringEquals)
+		<< false << "gas" << "Gas Station" << 1;
+	QTest::newRow("contains-case") << int(AssignmentRule::Contains)
+		<< true << "station" << "Gas Station" << 1;
+	QTest::newRow("contains-repeated") << int(AssignmentRule::Contains)
+		<< false << "a" << "Banana" << 0;
+	QTest::newRow("empty-value") << int(AssignmentRule::Contains)
+		<< false << "" << "Gas Station" << 0;
+}
+
+//------------------------------------------------------------------------------
+void CompiledRulesTest::ruleAdded()
+{
+	CompiledRules compiled(rules);
+	QUndoCommand* cmd = rules->addRule(ESTIMATE_1);
+
+	cmd->redo();
+	QCOMPARE(compiled.size(), 4);
+	QCOMPARE(compiled.match(bankFee()), 3);
+	QCOMPARE(compiled.match(bankFee()), CompiledRules(rules).match(bankFee()));
+
+	cmd->undo();
+	QCOMPARE(compiled.size(), 3);
+	QCOMPARE(compiled.match(bankFee()), -1);
+}
+
+//------------------------------------------------------------------------------
+void CompiledRulesTest::ruleRemoved()
+{
+	CompiledRules compiled(rules);
+	QUndoCommand* cmd = rules->removeRule(RULE_2);
+
+	cmd->redo();
+	QCOMPARE(compiled.size(), 2);
+	QCOMPARE(compiled.match(groceries()), 1);
+	QCOMPARE(compiled.ruleId(1), RULE_3);
+	QCOMPARE(compiled.match(groceries()), CompiledRules(rules).match(groceries()));
+
+	cmd->undo();
+	QCOMPARE(compiled.size(), 3);
+	QCOMPARE(compiled.match(groceries()), 1);
+	QCOMPARE(compiled.ruleId(1), RULE_2);
+}
+
+//------------------------------------------------------------------------------
+void CompiledRulesTest::ruleMoved()
+{
+	CompiledRules compiled(rules);
+	QUndoCommand* cmd = rules->move(2, 0);
+
+	cmd->redo();
+	QCOMPARE(compiled.match(groceries()), 0);
+	QCOMPARE(compiled.ruleId(0), RULE_3);
+	QCOMPARE(compiled.ruleId(1), RULE_1);
+	QCOMPARE(compiled.ruleId(2), RULE_2);
+
+	cmd->undo();
+	QCOMPARE(compiled.match(groceries()), 1);
+	QCOMPARE(compiled.ruleId(0), RULE_1);
+	QCOMPARE(compiled.ruleId(2), RULE_3);
+}
+
+//------------------------------------------------------------------------------
+void CompiledRulesTest::conditionAdded()
+{
+	CompiledRules compiled(rules);
+	QUndoCommand* cmd = rule2->addCondition();
+
+	// Undefined conditions never qualify
+	cmd->redo();
+	QCOMPARE(compiled.match(groceries()), 2);
+	QCOMPARE(compiled.match(groceries()), CompiledRules(rules).match(groceries()));
+
+	cmd->undo();
+	QCOMPARE(compiled.match(groceries()), 1);
+}
+
+//------------------------------------------------------------------------------
+void CompiledRulesTest::conditionRemoved()
+{
+	CompiledRules compiled(rules);
+	QUndoCommand* cmd = rule1->removeCondition(0);
+
+	// Rules without conditions match all transactions
+	cmd->redo();
+	QCOMPARE(compiled.match(groceries()), 0);
+	QCOMPARE(compiled.match(bankFee()), 0);
+
+	cmd->undo();
+	QCOMPARE(compiled.match(groceries()), 1);
+	QCOMPARE(compiled.match(bankFee()), -1);
+}
+
+//------------------------------------------------------------------------------
+void CompiledRulesTest::conditionUpdated()
+{
+	CompiledRules compiled(rules);
+	QUndoCommand* cmd = rule1->updateCondition(0,
+		AssignmentRule::Condition(AssignmentRule::Payee,
+			AssignmentRule::Contains, false, "STORE"));
+
+	cmd->redo();
+	QCOMPARE(compiled.match(groceries()), 0);
+	QCOMPARE(compiled.match(groceries()), CompiledRules(rules).match(groceries()));
+
+	cmd->undo();
+	QCOMPARE(compiled.match(groceries()), 1);
+}
+
+}
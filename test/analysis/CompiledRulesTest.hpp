@@ -0,0 +1,103 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMPILEDRULESTEST_HPP
+#define COMPILEDRULESTEST_HPP
+
+// Qt include(s)
+#include <QtTest/QtTest>
+
+namespace ub {
+
+// Forward declaration(s)
+class AssignmentRule;
+class AssignmentRules;
+
+/**
+ * Unit tests for the CompiledRules class.
+ */
+class CompiledRulesTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	/**
+	 * Creates a test assignment rules list.
+	 */
+	void init();
+
+	/**
+	 * Tests matching against the initially compiled rules.
+	 */
+	void initialMatch();
+
+	/**
+	 * Tests case-insensitive string conditions.
+	 */
+	void caseInsensitiveMatch();
+
+	/**
+	 * Tests that indexed prefix, suffix, and equality conditions only
+	 * select rules when anchored.
+	 */
+	void anchoredKeys();
+
+	/**
+	 * Test data for anchored key conditions.
+	 */
+	void anchoredKeys_data();
+
+	/**
+	 * Tests re-compilation after a rule is added.
+	 */
+	void ruleAdded();
+
+	/**
+	 * Tests re-compilation after a rule is removed.
+	 */
+	void ruleRemoved();
+
+	/**
+	 * Tests re-compilation after a rule is moved.
+	 */
+	void ruleMoved();
+
+	/**
+	 * Tests re-compilation after a condition is added.
+	 */
+	void conditionAdded();
+
+	/**
+	 * Tests re-compilation after a condition is removed.
+	 */
+	void conditionRemoved();
+
+	/**
+	 * Tests re-compilation after a condition is updated.
+	 */
+	void conditionUpdated();
+
+private:
+	// Test rules list
+	QSharedPointer<AssignmentRules> rules;
+	AssignmentRule* rule1;
+	AssignmentRule* rule2;
+	AssignmentRule* rule3;
+};
+
+}
+
+#endif //COMPILEDRULESTEST_HPP
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ESTIMATEFIXTURE_HPP
+#define ESTIMATEFIXTURE_HPP
+
+// Qt include(s)
+#include <QtTest/QtTest>
+
+// UnderBudget include(s)
+#include "budget/Estimate.hpp"
+
+namespace QTest {
+
+//------------------------------------------------------------------------------
+template<>
+char* toString(const ub::Money& money)
+{
+	QString str = QString("%1 (%2, %3)").arg(money.toString())
+		.arg(QVariant(money.amount()).toString()).arg(money.currency().code());
+	return toString(str);
+}
+
+}
+
+namespace ub {
+
+//------------------------------------------------------------------------------
+static const uint EXPENSES = 111;
+static const uint LIVING = 222;
+static const uint RENT = 333;
+static const uint UTILITIES = 444;
+static const uint FOOD = 555;
+static const uint SALARY = 666;
+static const uint BONUS = 777;
+
+/**
+ * Creates an estimate tree with nested expense categories, incomes, and
+ * finished estimates, shared by the estimate analysis tests.
+ *
+ * @return root of the estimate tree
+ */
+static QSharedPointer<Estimate> createEstimates()
+{
+	QSharedPointer<Estimate> root = Estimate::createRoot();
+	Estimate* expenses = Estimate::create(root.data(),
+		EXPENSES, "Expenses", "", Estimate::Expense, Money(), -1, false);
+	Estimate* living = Estimate::create(expenses,
+		LIVING, "Living", "", Estimate::Expense, Money(), 3, false);
+	Estimate::create(living, RENT, "Rent", "",
+		Estimate::Expense, Money(10, "USD"), 1, true);
+	Estimate::create(living, UTILITIES, "Utilities", "",
+		Estimate::Expense, Money(5, "USD"), -1, false);
+	Estimate::create(expenses, FOOD, "Food", "",
+		Estimate::Expense, Money(50, "USD"), 14, false);
+	Estimate::create(root.data(), SALARY, "Salary", "",
+		Estimate::Income, Money(100, "USD"), -1, false);
+	Estimate::create(root.data(), BONUS, "Bonus", "",
+		Estimate::Income, Money(50, "USD"), -1, true);
+
+	return root;
+}
+
+}
+
+#endif //ESTIMATEFIXTURE_HPP
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Qt include(s)
+#include <QtCore>
+
+// UnderBudget include(s)
+#include "analysis/EstimateRollup.hpp"
+#include "budget/Estimate.hpp"
+#include "EstimateFixture.hpp"
+#include "EstimateRollupTest.hpp"
+
+//------------------------------------------------------------------------------
+QTEST_MAIN(ub::EstimateRollupTest)
+
+namespace ub {
+
+//------------------------------------------------------------------------------
+static QHash<uint,Money> createActuals()
+{
+	QHash<uint,Money> actuals;
+	actuals.insert(RENT, Money(16, "USD"));
+	actuals.insert(FOOD, Money(51, "USD"));
+	actuals.insert(SALARY, Money(97, "USD"));
+	actuals.insert(BONUS, Money(55, "USD"));
+	return actuals;
+}
+
+//------------------------------------------------------------------------------
+void EstimateRollupTest::treeOrder()
+{
+	QSharedPointer<Estimate> root = createEstimates();
+	EstimateRollup rollup;
+	rollup.calculate(root.data(), createActuals());
+
+	QCOMPARE(rollup.size(), 8);
+
+	QList<uint> order;
+	for (int i=0; i<rollup.size(); ++i)
+	{
+		order << rollup.estimateAt(i)->estimateId();
+		QCOMPARE(rollup.positionOf(order.last()), i);
+	}
+
+	QCOMPARE(order, QList<uint>() << 0 << EXPENSES << LIVING << RENT
+		<< UTILITIES << FOOD << SALARY << BONUS);
+}
+
+//------------------------------------------------------------------------------
+void EstimateRollupTest::matchesRecursiveTotals_data()
+{
+	QTest::addColumn<uint>("estimate");
+
+	QTest::newRow("root") << (uint) 0;
+	QTest::newRow("category") << EXPENSES;
+	QTest::newRow("sub-category") << LIVING;
+	QTest::newRow("finished-leaf") << RENT;
+	QTest::newRow("leaf-without-actual") << UTILITIES;
+	QTest::newRow("leaf") << FOOD;
+	QTest::newRow("income") << SALARY;
+	QTest::newRow("finished-income") << BONUS;
+}
+
+//------------------------------------------------------------------------------
+void EstimateRollupTest::matchesRecursiveTotals()
+{
+	QFETCH(uint, estimate);
+
+	QSharedPointer<Estimate> root = createEstimates();
+	QHash<uint,Money> actuals = createActuals();
+	QDate start(2015, 1, 1);
+
+	EstimateRollup rollup;
+	rollup.calculate(root.data(), actuals);
+
+	Estimate* expected = root->find(estimate);
+	int position = rollup.positionOf(estimate);
+	QVERIFY(position >= 0);
+
+	QCOMPARE(rollup.totalEstimated(position),
+		expected->totalEstimatedAmount());
+	QCOMPARE(rollup.totalActual(position),
+		expected->totalActualAmount(actuals));
+
+	Estimate::Progress progress = rollup.progress(position, start);
+	Estimate::Progress expectedProgress = expected->progress(actuals, start);
+	QCOMPARE(progress.estimated, expectedProgress.estimated);
+	QCOMPARE(progress.actual, expectedProgress.actual);
+	QCOMPARE(progress.note, expectedProgress.note);
+	QCOMPARE(progress.isHealthy, expectedProgress.isHealthy);
+
+	Estimate::Impact impact = rollup.impact(position);
+	Estimate::Impact expectedImpact = expected->impact(actuals);
+	QCOMPARE(impact.estimated, expectedImpact.estimated);
+	QCOMPARE(impact.actual, expectedImpact.actual);
+	QCOMPARE(impact.expected, expectedImpact.expected);
+}
+
+//------------------------------------------------------------------------------
+void EstimateRollupTest::outOfBounds()
+{
+	QSharedPointer<Estimate> root = createEstimates();
+	EstimateRollup rollup;
+	rollup.calculate(root.data(), createActuals());
+
+	QCOMPARE(rollup.positionOf(9999), -1);
+	QVERIFY(rollup.estimateAt(-1) == 0);
+	QVERIFY(rollup.estimateAt(rollup.size()) == 0);
+	QCOMPARE(rollup.totalEstimated(-1), Money());
+	QCOMPARE(rollup.progress(-1).isHealthy, true);
+
+	rollup.clear();
+	QCOMPARE(rollup.size(), 0);
+	QCOMPARE(rollup.positionOf(EXPENSES), -1);
+}
+
+}
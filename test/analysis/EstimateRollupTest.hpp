@@ -0,0 +1,57 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ESTIMATEROLLUPTEST_HPP
+#define ESTIMATEROLLUPTEST_HPP
+
+// Qt include(s)
+#include <QtTest/QtTest>
+
+namespace ub {
+
+/**
+ * Unit tests for the EstimateRollup class.
+ */
+class EstimateRollupTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	/**
+	 * Tests that estimates are stored with parents before children.
+	 */
+	void treeOrder();
+
+	/**
+	 * Tests that the rolled-up totals match the recursive totals
+	 * calculated by each estimate.
+	 */
+	void matchesRecursiveTotals();
+
+	/**
+	 * Test data for comparing against recursive totals.
+	 */
+	void matchesRecursiveTotals_data();
+
+	/**
+	 * Tests querying of unknown estimates and positions.
+	 */
+	void outOfBounds();
+};
+
+}
+
+#endif //ESTIMATEROLLUPTEST_HPP
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Qt include(s)
+#include <QUndoCommand>
+
+// UnderBudget include(s)
+#include "analysis/Actuals.hpp"
+#include "analysis/EstimateTotalsCache.hpp"
+#include "budget/Estimate.hpp"
+#include "EstimateFixture.hpp"
+#include "EstimateTotalsCacheTest.hpp"
+
+//------------------------------------------------------------------------------
+QTEST_MAIN(ub::EstimateTotalsCacheTest)
+
+namespace ub {
+
+//------------------------------------------------------------------------------
+enum Modification
+{
+	ChangeLeafAmount,
+	LeafToCategory,
+	AddChild,
+	DeleteLeaf,
+	DeleteCategory,
+	MoveWithinParent,
+	MoveToOtherParent,
+	RecordActual,
+	ClearActuals
+};
+
+//------------------------------------------------------------------------------
+static void recordActuals(Actuals* actuals)
+{
+	actuals->record(RENT, Money(16, "USD"));
+	actuals->record(FOOD, Money(51, "USD"));
+	actuals->record(SALARY, Money(97, "USD"));
+	actuals->record(BONUS, Money(55, "USD"));
+}
+
+//------------------------------------------------------------------------------
+static void compareAll(const EstimateTotalsCache& cache, const Estimate* estimate,
+	const QHash<uint,Money>& actuals)
+{
+	QCOMPARE(cache.totalEstimated(estimate), estimate->totalEstimatedAmount());
+	QCOMPARE(cache.totalActual(estimate), estimate->totalActualAmount(actuals));
+
+	Estimate::Progress progress = cache.progress(estimate);
+	Estimate::Progress expected = estimate->progress(actuals);
+	QCOMPARE(progress.estimated, expected.estimated);
+	QCOMPARE(progress.actual, expected.actual);
+	QCOMPARE(progress.isHealthy, expected.isHealthy);
+
+	for (int i=0; i<estimate->childCount(); ++i)
+	{
+		compareAll(cache, estimate->childAt(i), actuals);
+	}
+}
+
+//------------------------------------------------------------------------------
+void EstimateTotalsCacheTest::matchesRecursiveTotals()
+{
+	QSharedPointer<Estimate> root = createEstimates();
+	Actuals actuals;
+	recordActuals(&actuals);
+
+	EstimateTotalsCache cache(root, &actuals);
+	compareAll(cache, root.data(), actuals.map());
+	// Again, using the memoized totals
+	compareAll(cache, root.data(), actuals.map());
+
+	QCOMPARE(cache.totalEstimated(root.data()), Money(215, "USD"));
+	QCOMPARE(cache.totalActual(root->find(EXPENSES)), Money(67, "USD"));
+}
+
+//------------------------------------------------------------------------------
+void EstimateTotalsCacheTest::modifications_data()
+{
+	QTest::addColumn<int>("modification");
+
+	QTest::newRow("change-leaf-amount") << (int) ChangeLeafAmount;
+	QTest::newRow("leaf-to-category") << (int) LeafToCategory;
+	QTest::newRow("add-child") << (int) AddChild;
+	QTest::newRow("delete-leaf") << (int) DeleteLeaf;
+	QTest::newRow("delete-category") << (int) DeleteCategory;
+	QTest::newRow("move-within-parent") << (int) MoveWithinParent;
+	QTest::newRow("move-to-other-parent") << (int) MoveToOtherParent;
+	QTest::newRow("record-actual") << (int) RecordActual;
+	QTest::newRow("clear-actuals") << (int) ClearActuals;
+}
+
+//------------------------------------------------------------------------------
+void EstimateTotalsCacheTest::modifications()
+{
+	QFETCH(int, modification);
+
+	QSharedPointer<Estimate> root = createEstimates();
+	Actuals actuals;
+	recordActuals(&actuals);
+
+	EstimateTotalsCache cache(root, &actuals);
+	// Populate the cache before modifying anything
+	compareAll(cache, root.data(), actuals.map());
+
+	QUndoCommand* cmd = 0;
+	switch (modification)
+	{
+	case ChangeLeafAmount:
+		cmd = root->find(UTILITIES)->changeAmount(Money(25, "USD"));
+		break;
+	case LeafToCategory:
+		// Actuals of categories are those of their children
+		cmd = root->find(FOOD)->addChild();
+		break;
+	case AddChild:
+		cmd = root->find(LIVING)->addChild();
+		break;
+	case DeleteLeaf:
+		cmd = root->find(RENT)->deleteEstimate();
+		break;
+	case DeleteCategory:
+		cmd = root->find(LIVING)->deleteEstimate();
+		break;
+	case MoveWithinParent:
+		cmd = root->find(BONUS)->moveTo(root.data(), 0);
+		break;
+	case MoveToOtherParent:
+		cmd = root->find(FOOD)->moveTo(root->find(LIVING), 0);
+		break;
+	case RecordActual:
+		actuals.record(UTILITIES, Money(7, "USD"));
+		break;
+	case ClearActuals:
+		actuals.clear();
+		break;
+	default:
+		QFAIL("Unknown modification");
+	}
+
+	if (cmd)
+	{
+		cmd->redo();
+	}
+	compareAll(cache, root.data(), actuals.map());
+
+	if (cmd)
+	{
+		cmd->undo();
+		compareAll(cache, root.data(), actuals.map());
+		cmd->redo();
+		compareAll(cache, root.data(), actuals.map());
+		delete cmd;
+	}
+}
+
+}
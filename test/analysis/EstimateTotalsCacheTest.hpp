@@ -0,0 +1,53 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ESTIMATETOTALSCACHETEST_HPP
+#define ESTIMATETOTALSCACHETEST_HPP
+
+// Qt include(s)
+#include <QtTest/QtTest>
+
+namespace ub {
+
+/**
+ * Unit tests for the EstimateTotalsCache class.
+ */
+class EstimateTotalsCacheTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	/**
+	 * Tests that the cached totals match the recursive totals
+	 * calculated by each estimate.
+	 */
+	void matchesRecursiveTotals();
+
+	/**
+	 * Tests that the cached totals are updated after modifications
+	 * to the estimates or actuals, and after undoing them.
+	 */
+	void modifications();
+
+	/**
+	 * Test data for modifications.
+	 */
+	void modifications_data();
+};
+
+}
+
+#endif //ESTIMATETOTALSCACHETEST_HPP
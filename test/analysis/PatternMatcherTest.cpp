@@ -0,0 +1,104 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Qt include(s)
+#include <QtCore>
+
+// UnderBudget include(s)
+#include "analysis/PatternMatcher.hpp"
+#include "PatternMatcherTest.hpp"
+
+//------------------------------------------------------------------------------
+QTEST_MAIN(ub::PatternMatcherTest)
+
+namespace ub {
+
+//------------------------------------------------------------------------------
+static QString format(const QVector<PatternMatcher::Hit>& hits)
+{
+	QStringList list;
+	for (int i=0; i<hits.size(); ++i)
+	{
+		list << QString("%1@%2").arg(hits.at(i).id).arg(hits.at(i).end);
+	}
+	list.sort();
+	return list.join(" ");
+}
+
+//------------------------------------------------------------------------------
+void PatternMatcherTest::search()
+{
+	PatternMatcher matcher;
+	matcher.add("he", 0);
+	matcher.add("she", 1);
+	matcher.add("his", 2);
+	matcher.add("hers", 3);
+	matcher.add("", 4);
+	matcher.build();
+
+	QFETCH(QString, text);
+	QFETCH(QString, expected);
+
+	QVector<PatternMatcher::Hit> hits;
+	matcher.search(text, hits);
+	QCOMPARE(format(hits), expected);
+}
+
+//------------------------------------------------------------------------------
+void PatternMatcherTest::search_data()
+{
+	QTest::addColumn<QString>("text");
+	QTest::addColumn<QString>("expected");
+
+	QTest::newRow("no-match") << "abc" << "";
+	QTest::newRow("empty-text") << "" << "";
+	QTest::newRow("overlapping") << "ushers" << "0@4 1@4 3@6";
+	QTest::newRow("failure-links") << "hishe" << "0@5 1@5 2@3";
+	QTest::newRow("exact") << "he" << "0@2";
+	QTest::newRow("case-sensitive") << "SHE" << "";
+}
+
+//------------------------------------------------------------------------------
+void PatternMatcherTest::duplicatePatterns()
+{
+	PatternMatcher matcher;
+	matcher.add("store", 7);
+	matcher.add("store", 3);
+	matcher.build();
+
+	QVector<PatternMatcher::Hit> hits;
+	matcher.search("grocery store", hits);
+	QCOMPARE(format(hits), QString("3@13 7@13"));
+}
+
+//------------------------------------------------------------------------------
+void PatternMatcherTest::emptyMatcher()
+{
+	PatternMatcher matcher;
+	QCOMPARE(matcher.isEmpty(), true);
+	matcher.build();
+
+	QVector<PatternMatcher::Hit> hits;
+	matcher.search("anything", hits);
+	QCOMPARE(hits.size(), 0);
+
+	matcher.add("any", 1);
+	QCOMPARE(matcher.isEmpty(), false);
+	matcher.clear();
+	QCOMPARE(matcher.isEmpty(), true);
+}
+
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATTERNMATCHERTEST_HPP
+#define PATTERNMATCHERTEST_HPP
+
+// Qt include(s)
+#include <QtTest/QtTest>
+
+namespace ub {
+
+/**
+ * Unit tests for the PatternMatcher class.
+ */
+class PatternMatcherTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	/**
+	 * Tests that all occurrences of all patterns are found.
+	 */
+	void search();
+
+	/**
+	 * Test data for pattern searching.
+	 */
+	void search_data();
+
+	/**
+	 * Tests that a pattern added more than once reports every ID.
+	 */
+	void duplicatePatterns();
+
+	/**
+	 * Tests that an empty matcher finds nothing.
+	 */
+	void emptyMatcher();
+};
+
+}
+
+#endif //PATTERNMATCHERTEST_HPP
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+// Qt include(s)
+#include <QUndoCommand>
+
 // UnderBudget include(s)
 #include "accounting/Money.hpp"
 #include "analysis/Actuals.hpp"
@@ -260,5 +263,319 @@ void TransactionAssignerTest::ruleAssociation()
 	QCOMPARE(assignments->rule(transaction), rule);
 }
 
+//------------------------------------------------------------------------------
+QList<ImportedTransaction> createManyTransactions(int copies)
+{
+	QList<ImportedTransaction> original = createTransactions();
+	QList<ImportedTransaction> transactions;
+
+	for (int c=0; c<copies; ++c)
+	{
+		for (int i=0; i<original.size(); ++i)
+		{
+			const ImportedTransaction& trn = original.at(i);
+			transactions << ImportedTransaction(
+				trn.transactionId() * 1000 + c, trn.date(),
+				Money(trn.amount().amount(), "USD"), trn.payee(), trn.memo(),
+				account(trn.withdrawalAccount()), account(trn.depositAccount()));
+		}
+	}
+
+	return transactions;
+}
+
+//------------------------------------------------------------------------------
+void TransactionAssignerTest::parallelMatchesSerial()
+{
+	QSharedPointer<AssignmentRules> rules = createRules();
+	QList<ImportedTransaction> transactions = createManyTransactions(500);
+
+	Actuals* serialActuals = new Actuals(this);
+	Assignments* serialAssignments = new Assignments(this);
+	TransactionAssigner serial(rules, serialAssignments, serialActuals);
+	serial.setParallel(false);
+	serial.assign(transactions);
+
+	Actuals* parallelActuals = new Actuals(this);
+	Assignments* parallelAssignments = new Assignments(this);
+	TransactionAssigner parallel(rules, parallelAssignments, parallelActuals);
+	parallel.assign(transactions);
+
+	QCOMPARE(parallelAssignments->numberOfAssignments(),
+		serialAssignments->numberOfAssignments());
+	QCOMPARE(parallelActuals->map(), serialActuals->map());
+
+	for (int i=0; i<transactions.size(); ++i)
+	{
+		uint trnId = transactions.at(i).transactionId();
+		QCOMPARE(parallelAssignments->estimate(trnId),
+			serialAssignments->estimate(trnId));
+		QCOMPARE(parallelAssignments->rule(trnId),
+			serialAssignments->rule(trnId));
+	}
+}
+
+//------------------------------------------------------------------------------
+void TransactionAssignerTest::progressReported()
+{
+	Actuals* actuals = new Actuals(this);
+	Assignments* assignments = new Assignments(this);
+	TransactionAssigner assigner(createRules(), assignments, actuals);
+
+	QSignalSpy progressSpy(&assigner, SIGNAL(progress(int)));
+	QSignalSpy actualsSpy(actuals, SIGNAL(actualsChanged()));
+	assigner.assign(createManyTransactions(500));
+
+	QVERIFY(progressSpy.count() >= 2);
+	QCOMPARE(progressSpy.first().at(0).toInt(), 0);
+	QCOMPARE(progressSpy.last().at(0).toInt(), 100);
+
+	for (int i=1; i<progressSpy.count(); ++i)
+	{
+		QVERIFY(progressSpy.at(i).at(0).toInt()
+			>= progressSpy.at(i - 1).at(0).toInt());
+	}
+
+	// Actuals are replaced with a single notification
+	QCOMPARE(actualsSpy.count(), 1);
 }
 
+//------------------------------------------------------------------------------
+void TransactionAssignerTest::batchedAssignment()
+{
+	QSharedPointer<AssignmentRules> rules = createRules();
+	QList<ImportedTransaction> transactions = createManyTransactions(50);
+
+	Actuals* expectedActuals = new Actuals(this);
+	Assignments* expectedAssignments = new Assignments(this);
+	TransactionAssigner expected(rules, expectedAssignments, expectedActuals);
+	expected.assign(transactions);
+
+	// Start with previous results, to make sure they are kept until
+	// the staged transactions are committed
+	Actuals* actuals = new Actuals(this);
+	Assignments* assignments = new Assignments(this);
+	TransactionAssigner assigner(rules, assignments, actuals);
+	assigner.assign(createTransactions());
+	int previousAssignments = assignments->numberOfAssignments();
+	QHash<uint, Money> previousActuals = actuals->map();
+
+	QSignalSpy finishedSpy(&assigner, SIGNAL(finished()));
+	for (int begin=0; begin<transactions.size(); begin+=7)
+	{
+		assigner.stage(transactions.mid(begin, 7));
+	}
+	QCOMPARE(finishedSpy.count(), 0);
+	QCOMPARE(assignments->numberOfAssignments(), previousAssignments);
+	QCOMPARE(actuals->map(), previousActuals);
+
+	// Discarded transactions leave the previous results in place
+	assigner.discardStaged();
+	QCOMPARE(assignments->numberOfAssignments(), previousAssignments);
+	QCOMPARE(actuals->map(), previousActuals);
+
+	// Committing nothing replaces the previous results, as from an empty import
+	assigner.commitStaged();
+	QCOMPARE(assignments->numberOfAssignments(), 0);
+	QCOMPARE(actuals->map().size(), 0);
+	QCOMPARE(finishedSpy.count(), 1);
+
+	assigner.assign(createTransactions());
+	for (int begin=0; begin<transactions.size(); begin+=7)
+	{
+		assigner.stage(transactions.mid(begin, 7));
+	}
+	assigner.commitStaged();
+
+	QCOMPARE(assignments->numberOfAssignments(),
+		expectedAssignments->numberOfAssignments());
+	QCOMPARE(actuals->map(), expectedActuals->map());
+
+	for (int i=0; i<transactions.size(); ++i)
+	{
+		uint trnId = transactions.at(i).transactionId();
+		QCOMPARE(assignments->estimate(trnId),
+			expectedAssignments->estimate(trnId));
+		QCOMPARE(assignments->rule(trnId), expectedAssignments->rule(trnId));
+	}
+}
+
+//------------------------------------------------------------------------------
+void TransactionAssignerTest::incrementalReassignment_data()
+{
+	QTest::addColumn<QString>("edit");
+
+	QTest::newRow("add-rule") << "add-rule";
+	QTest::newRow("remove-rule") << "remove-rule";
+	QTest::newRow("move-up") << "move-up";
+	QTest::newRow("move-down") << "move-down";
+	QTest::newRow("add-condition") << "add-condition";
+	QTest::newRow("remove-condition") << "remove-condition";
+	QTest::newRow("update-condition") << "update-condition";
+}
+
+//------------------------------------------------------------------------------
+void TransactionAssignerTest::incrementalReassignment()
+{
+	QFETCH(QString, edit);
+
+	QSharedPointer<AssignmentRules> rules = createRules();
+	QList<ImportedTransaction> transactions = createTransactions();
+
+	Actuals* actuals = new Actuals(this);
+	Assignments* assignments = new Assignments(this);
+	TransactionAssigner assigner(rules, assignments, actuals);
+	assigner.assign(transactions);
+
+	QUndoCommand* cmd = 0;
+	if (edit == "add-rule")
+		cmd = rules->addRule(NO_MATCH_EST);
+	else if (edit == "remove-rule")
+		cmd = rules->removeRule(MEMO_RULE);
+	else if (edit == "move-up")
+		cmd = rules->move(8, 1);
+	else if (edit == "move-down")
+		cmd = rules->move(1, 6);
+	else if (edit == "add-condition")
+		cmd = rules->find(PAYEE_RULE)->addCondition();
+	else if (edit == "remove-condition")
+		cmd = rules->find(MULTI_COND_RULE)->removeCondition(2);
+	else if (edit == "update-condition")
+		cmd = rules->find(PAYEE_RULE)->updateCondition(0,
+			AssignmentRule::Condition(AssignmentRule::Payee,
+				AssignmentRule::EndsWith, false, "store"));
+	QVERIFY(cmd != 0);
+
+	for (int pass=0; pass<2; ++pass)
+	{
+		if (pass == 0)
+			cmd->redo();
+		else
+			cmd->undo();
+
+		Actuals* expectedActuals = new Actuals(this);
+		Assignments* expectedAssignments = new Assignments(this);
+		TransactionAssigner expected(rules, expectedAssignments,
+			expectedActuals);
+		expected.assign(transactions);
+
+		QCOMPARE(assignments->numberOfAssignments(),
+			expectedAssignments->numberOfAssignments());
+		for (int i=0; i<transactions.size(); ++i)
+		{
+			uint trnId = transactions.at(i).transactionId();
+			QCOMPARE(assignments->estimate(trnId),
+				expectedAssignments->estimate(trnId));
+			QCOMPARE(assignments->rule(trnId),
+				expectedAssignments->rule(trnId));
+		}
+
+		QList<uint> estimates;
+		estimates << NO_MATCH_EST << SPECIFIC_EST << GENERIC_EST << DATE_EST
+			<< AMT_EST << PAYEE_EST << MEMO_EST << DEPOSIT_EST << WITHDRAW_EST;
+		for (int i=0; i<estimates.size(); ++i)
+		{
+			QCOMPARE(actuals->forEstimate(estimates.at(i)).amount(),
+				expectedActuals->forEstimate(estimates.at(i)).amount());
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+void TransactionAssignerTest::incrementalUpdate_data()
+{
+	QTest::addColumn<QString>("change");
+
+	QTest::newRow("unchanged") << "unchanged";
+	QTest::newRow("added") << "added";
+	QTest::newRow("removed") << "removed";
+	QTest::newRow("modified") << "modified";
+	QTest::newRow("replaced") << "replaced";
+}
+
+//------------------------------------------------------------------------------
+void TransactionAssignerTest::incrementalUpdate()
+{
+	QFETCH(QString, change);
+
+	QSharedPointer<AssignmentRules> rules = createRules();
+	QList<ImportedTransaction> transactions = createManyTransactions(3);
+
+	Actuals* actuals = new Actuals(this);
+	Assignments* assignments = new Assignments(this);
+	TransactionAssigner assigner(rules, assignments, actuals);
+	assigner.assign(transactions);
+
+	QList<ImportedTransaction> updated = transactions;
+	if (change == "added")
+	{
+		updated += createManyTransactions(5).mid(transactions.size());
+	}
+	else if (change == "removed")
+	{
+		updated.removeAt(20);
+		updated.removeAt(7);
+		updated.removeAt(0);
+	}
+	else if (change == "modified")
+	{
+		// Keep the ID, but change the amount and the matched rule
+		for (int i=1; i<updated.size(); i+=5)
+		{
+			const ImportedTransaction& trn = updated.at(i);
+			const ImportedTransaction& other = updated.at(i - 1);
+			updated[i] = ImportedTransaction(trn.transactionId(), trn.date(),
+				trn.amount() + Money(5.0, "USD"), other.payee(), other.memo(),
+				account(other.withdrawalAccount()),
+				account(other.depositAccount()));
+		}
+	}
+	else if (change == "replaced")
+	{
+		updated = createTransactions();
+	}
+
+	QSignalSpy startedSpy(&assigner, SIGNAL(started()));
+	QSignalSpy finishedSpy(&assigner, SIGNAL(finished()));
+	assigner.update(updated);
+	QCOMPARE(startedSpy.count(), 1);
+	QCOMPARE(finishedSpy.count(), 1);
+
+	Actuals* expectedActuals = new Actuals(this);
+	Assignments* expectedAssignments = new Assignments(this);
+	TransactionAssigner expected(rules, expectedAssignments, expectedActuals);
+	expected.assign(updated);
+
+	QCOMPARE(assignments->numberOfAssignments(),
+		expectedAssignments->numberOfAssignments());
+	for (int i=0; i<updated.size(); ++i)
+	{
+		uint trnId = updated.at(i).transactionId();
+		QCOMPARE(assignments->estimate(trnId),
+			expectedAssignments->estimate(trnId));
+		QCOMPARE(assignments->rule(trnId), expectedAssignments->rule(trnId));
+	}
+
+	// Actuals of estimates that lost all of their transactions are
+	// adjusted to zero rather than being removed
+	QList<uint> estimates;
+	estimates << NO_MATCH_EST << SPECIFIC_EST << GENERIC_EST << DATE_EST
+		<< AMT_EST << PAYEE_EST << MEMO_EST << DEPOSIT_EST << WITHDRAW_EST;
+	for (int i=0; i<estimates.size(); ++i)
+	{
+		QCOMPARE(actuals->forEstimate(estimates.at(i)).amount(),
+			expectedActuals->forEstimate(estimates.at(i)).amount());
+	}
+
+	// Rule modifications are applied to the updated transactions
+	QUndoCommand* cmd = rules->removeRule(MEMO_RULE);
+	cmd->redo();
+	for (int i=0; i<updated.size(); ++i)
+	{
+		uint trnId = updated.at(i).transactionId();
+		QCOMPARE(assignments->estimate(trnId),
+			expectedAssignments->estimate(trnId));
+	}
+}
+
+}
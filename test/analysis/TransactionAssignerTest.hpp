@@ -62,6 +62,46 @@ private slots:
 	 * Test data for testing rule association.
 	 */
 	void ruleAssociation_data();
+
+	/**
+	 * Tests that parallel assignment produces the same results
+	 * as serial assignment.
+	 */
+	void parallelMatchesSerial();
+
+	/**
+	 * Tests the progress reported during assignment.
+	 */
+	void progressReported();
+
+	/**
+	 * Tests that assigning transactions in staged batches produces the
+	 * same results as a single assignment, and that the previous results
+	 * are kept until the staged batches are committed.
+	 */
+	void batchedAssignment();
+
+	/**
+	 * Tests that re-assignment after a rule modification produces
+	 * the same results as a full assignment.
+	 */
+	void incrementalReassignment();
+
+	/**
+	 * Test data for incremental re-assignment.
+	 */
+	void incrementalReassignment_data();
+
+	/**
+	 * Tests that updating the assigned transactions with a new set of
+	 * transactions produces the same results as a full assignment.
+	 */
+	void incrementalUpdate();
+
+	/**
+	 * Test data for incremental updates.
+	 */
+	void incrementalUpdate_data();
 };
 
 }
@@ -160,6 +160,89 @@ void EstimateTest::find()
 	QCOMPARE(root->find(9) == 0, true);
 }
 
+//------------------------------------------------------------------------------
+void EstimateTest::findInLargeTree()
+{
+	QSharedPointer<Estimate> largeRoot = Estimate::createRoot();
+	QList<Estimate*> estimates;
+	for (uint p=0; p<50; ++p)
+	{
+		Estimate* parent = Estimate::create(largeRoot.data(), 100000 + p,
+			"Parent", "", Estimate::Expense, Money(), -1, false);
+		estimates << parent;
+		for (uint c=0; c<50; ++c)
+		{
+			// Every third child is inserted in front of its siblings
+			estimates << Estimate::create(parent, 200000 + p * 100 + c,
+				"Child", "", Estimate::Expense, Money(), -1, false,
+				(c % 3 == 0) ? 0 : -1);
+		}
+	}
+
+	// A parent inserted in front of the others shifts every path
+	Estimate* first = Estimate::create(largeRoot.data(), 300000,
+		"First", "", Estimate::Expense, Money(), -1, false, 0);
+	estimates << first;
+	estimates << Estimate::create(first, 300001,
+		"Child", "", Estimate::Expense, Money(), -1, false);
+
+	for (int i=0; i<estimates.size(); ++i)
+	{
+		QCOMPARE(largeRoot->find(estimates.at(i)->estimateId()),
+			estimates.at(i));
+	}
+}
+
+//------------------------------------------------------------------------------
+void EstimateTest::findAfterModification()
+{
+	// Moved estimates are found without any change to the index
+	QUndoCommand* move = water->moveTo(incomes, 0);
+	move->redo();
+	QCOMPARE(root->find(WATER), water);
+	QCOMPARE(root->find(WATER)->parentEstimate(), incomes);
+	move->undo();
+	QCOMPARE(root->find(WATER), water);
+	QCOMPARE(root->find(WATER)->parentEstimate(), utilities);
+
+	// Deleted estimates, and all of their children, are no longer found
+	QUndoCommand* del = utilities->deleteEstimate();
+	del->redo();
+	QCOMPARE(root->find(UTILITIES) == 0, true);
+	QCOMPARE(root->find(RENT) == 0, true);
+	QCOMPARE(root->find(WATER) == 0, true);
+	QCOMPARE(root->find(FOOD), food);
+
+	// Restored estimates are found again
+	del->undo();
+	Estimate* reUtilities = root->find(UTILITIES);
+	QCOMPARE(reUtilities == 0, false);
+	QCOMPARE(reUtilities->parentEstimate(), expenses);
+	QCOMPARE(root->find(RENT) == 0, false);
+	QCOMPARE(root->find(RENT)->parentEstimate(), reUtilities);
+	QCOMPARE(root->find(WATER) == 0, false);
+	QCOMPARE(root->find(WATER)->parentEstimate(), reUtilities);
+}
+
+//------------------------------------------------------------------------------
+void EstimateTest::createBenchmark()
+{
+	QBENCHMARK
+	{
+		QSharedPointer<Estimate> largeRoot = Estimate::createRoot();
+		for (uint p=0; p<100; ++p)
+		{
+			Estimate* parent = Estimate::create(largeRoot.data(), 100000 + p,
+				"Parent", "", Estimate::Expense, Money(), -1, false);
+			for (uint c=0; c<99; ++c)
+			{
+				Estimate::create(parent, 200000 + p * 100 + c,
+					"Child", "", Estimate::Expense, Money(25.0), -1, false);
+			}
+		}
+	}
+}
+
 //------------------------------------------------------------------------------
 void EstimateTest::changeName_data()
 {
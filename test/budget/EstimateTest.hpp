@@ -69,6 +69,23 @@ private slots:
 	 */
 	void find();
 
+	/**
+	 * Tests ID-based retrieval of estimates in a large tree, built by
+	 * both appending and inserting children.
+	 */
+	void findInLargeTree();
+
+	/**
+	 * Tests ID-based retrieval of estimates after they have been
+	 * moved, deleted, and restored.
+	 */
+	void findAfterModification();
+
+	/**
+	 * Benchmarks construction of a 10,000 estimate tree.
+	 */
+	void createBenchmark();
+
 	/**
 	 * Tests changing the name of an estimate.
 	 */
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BUDGETFIXTURE_HPP
+#define BUDGETFIXTURE_HPP
+
+// Qt include(s)
+#include <QtCore>
+
+// UnderBudget include(s)
+#include "budget/AssignmentRule.hpp"
+#include "budget/AssignmentRules.hpp"
+#include "budget/Balance.hpp"
+#include "budget/Budget.hpp"
+#include "budget/Estimate.hpp"
+#include "budget/UIPrefs.hpp"
+#include "budget/storage/XmlBudgetWriter.hpp"
+
+namespace ub {
+
+/**
+ * Serializes the given budget as XML, so that budgets can be compared.
+ *
+ * @param[in] budget budget to be serialized
+ * @return XML representation of the budget
+ */
+static QByteArray toXml(QSharedPointer<Budget> budget)
+{
+	QBuffer buffer;
+	buffer.open(QBuffer::WriteOnly);
+	XmlBudgetWriter::write(&buffer, budget);
+	return buffer.data();
+}
+
+/**
+ * Creates a full budget definition, with every kind of budget element.
+ *
+ * @return budget definition
+ */
+static QSharedPointer<Budget> createBudget()
+{
+	// Create estimate tree
+	QSharedPointer<Estimate> root = Estimate::createRoot();
+	Estimate* income = Estimate::create(root.data(), 10000, "Income Estimates",
+		"estimates for incomes", Estimate::Income, Money(), -1, false);
+	Estimate::create(income, 11000, "Someone's Salary",
+		"", Estimate::Income, Money(5623, "USD"), -1, false);
+	Estimate* expense = Estimate::create(root.data(), 20000, "Expense Estimates",
+		"", Estimate::Expense, Money(), -1, false);
+	Estimate* bills = Estimate::create(expense, 21000, "Bills",
+		"recurring expenses", Estimate::Expense, Money(), -1, false);
+	Estimate::create(bills, 21100, "Rent",
+		"for the apt.", Estimate::Expense, Money(452.23, "USD"), 27, false);
+	Estimate::create(bills, 21200, "Utilities",
+		"elec, gas, etc.", Estimate::Expense, Money(500, "USD"), -1, true);
+	Estimate::create(expense, 22000, "Foreign Expenses",
+		"while in Europe", Estimate::Expense, Money(2000, "EUR"), -1, false);
+	Estimate::create(root.data(), 30000, "Credit Card",
+		"", Estimate::Transfer, Money(1400, "USD"), 20, true);
+
+	// Create assignment rules
+	QSharedPointer<AssignmentRules> rules = AssignmentRules::create();
+	QList<AssignmentRule::Condition> conditions;
+	conditions << AssignmentRule::Condition(AssignmentRule::Payee,
+		AssignmentRule::BeginsWith, false, "payee begins with");
+	rules->createRule(100, 30000, conditions);
+	conditions << AssignmentRule::Condition(AssignmentRule::Memo,
+		AssignmentRule::EndsWith, true, "memo Ends With");
+	rules->createRule(101, 21200, conditions);
+	conditions.clear();
+	rules->createRule(102, 21100, conditions);
+	conditions << AssignmentRule::Condition(AssignmentRule::Date,
+		AssignmentRule::After, false, "2013-05-06");
+	conditions << AssignmentRule::Condition(AssignmentRule::Amount,
+		AssignmentRule::LessThan, false, "3400");
+	rules->createRule(103, 22000, conditions);
+
+	// Create initial balance
+	QList<Balance::Contributor> contributors;
+	contributors << Balance::Contributor("Have", Money(10000, "USD"), true);
+	contributors << Balance::Contributor("Owe", Money(200, "USD"), false);
+	QSharedPointer<Balance> initial = Balance::create(contributors);
+
+	// Create budgeting period
+	BudgetingPeriod::Parameters params;
+	params.type = BudgetingPeriod::CustomDateRange;
+	params.param1 = QDate(2013, 8, 3);
+	params.param2 = QDate(2013, 9, 14);
+	QSharedPointer<BudgetingPeriod> period(new BudgetingPeriod(params));
+
+	// Create UI preferences
+	QSharedPointer<UIPrefs> uiPrefs = UIPrefs::create();
+	uiPrefs->setValue("columns", QStringList() << "name" << "amount");
+	uiPrefs->setValue("width", 240);
+
+	return QSharedPointer<Budget>(new Budget("Stored Budget", period,
+		initial, root, rules, uiPrefs));
+}
+
+}
+
+#endif //BUDGETFIXTURE_HPP
@@ -0,0 +1,228 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Qt include(s)
+#include <QtCore>
+#include <QUndoCommand>
+
+// UnderBudget include(s)
+#include "BudgetFixture.hpp"
+#include "SqlBudgetFileTest.hpp"
+#include "budget/storage/SqlBudgetFile.hpp"
+
+//------------------------------------------------------------------------------
+QTEST_MAIN(ub::SqlBudgetFileTest)
+
+namespace ub {
+
+//------------------------------------------------------------------------------
+void SqlBudgetFileTest::roundTrip()
+{
+	QTemporaryDir dir;
+	QString fileName = dir.path() + "/budget.sqlite";
+	QSharedPointer<Budget> budget = createBudget();
+
+	{
+		SqlBudgetFile file(fileName);
+		QVERIFY(file.store(budget));
+		QCOMPARE(file.error(), QString());
+	}
+
+	SqlBudgetFile file(fileName);
+	QSharedPointer<Budget> retrieved = file.retrieve();
+	QVERIFY( ! retrieved.isNull());
+	QCOMPARE(file.error(), QString());
+	QCOMPARE(toXml(retrieved), toXml(budget));
+
+	BudgetingPeriod::Parameters params =
+		retrieved->budgetingPeriod()->parameters();
+	QCOMPARE(params.type, BudgetingPeriod::CustomDateRange);
+	QCOMPARE(params.param1.toDate(), QDate(2013, 8, 3));
+	QCOMPARE(params.param2.toDate(), QDate(2013, 9, 14));
+
+	QSharedPointer<UIPrefs> uiPrefs = retrieved->uiPreferences();
+	QCOMPARE(uiPrefs->value("columns").toStringList(),
+		QStringList() << "name" << "amount");
+	QCOMPARE(uiPrefs->value("width").toInt(), 240);
+
+	// Storing to an existing file replaces its contents
+	QSharedPointer<Budget> other(new Budget);
+	SqlBudgetFile otherFile(fileName);
+	QVERIFY(otherFile.store(other));
+	QCOMPARE(toXml(SqlBudgetFile(fileName).retrieve()), toXml(other));
+}
+
+//------------------------------------------------------------------------------
+void SqlBudgetFileTest::largeAmounts()
+{
+	QTemporaryDir dir;
+	QString fileName = dir.path() + "/budget.sqlite";
+
+	// Beyond 2^53 scaled units, doubles can no longer hold every amount
+	const qint64 large = Q_INT64_C(123456789012345678);
+
+	QSharedPointer<Estimate> root = Estimate::createRoot();
+	Estimate::create(root.data(), 10000, "Large", "", Estimate::Income,
+		Money::fromScaled(large, "USD"), -1, false);
+	QList<Balance::Contributor> contributors;
+	contributors << Balance::Contributor("Large",
+		Money::fromScaled(-large - 1, "USD"), true);
+	QSharedPointer<Budget> budget(new Budget("Large Budget",
+		QSharedPointer<BudgetingPeriod>(new BudgetingPeriod),
+		Balance::create(contributors), root, AssignmentRules::create(),
+		UIPrefs::create()));
+
+	QVERIFY(SqlBudgetFile(fileName).store(budget));
+
+	QSharedPointer<Budget> retrieved = SqlBudgetFile(fileName).retrieve();
+	QVERIFY( ! retrieved.isNull());
+	Money estimated = retrieved->estimates()->find(10000)->estimatedAmount();
+	QCOMPARE(estimated.scaled(), large);
+	QCOMPARE(estimated.currency().code(), QString("USD"));
+	QCOMPARE(retrieved->initialBalance()->contributorAt(0).amount.scaled(),
+		-large - 1);
+}
+
+//------------------------------------------------------------------------------
+void SqlBudgetFileTest::retrieveInvalidFile()
+{
+	QTemporaryDir dir;
+
+	SqlBudgetFile missing(dir.path() + "/missing.sqlite");
+	QVERIFY(missing.retrieve().isNull());
+	QVERIFY( ! missing.error().isEmpty());
+	QVERIFY( ! QFile::exists(missing.location()));
+
+	QFile text(dir.path() + "/text.sqlite");
+	QVERIFY(text.open(QIODevice::WriteOnly));
+	text.write("not a database");
+	text.close();
+
+	SqlBudgetFile invalid(text.fileName());
+	QVERIFY(invalid.retrieve().isNull());
+	QVERIFY( ! invalid.error().isEmpty());
+}
+
+//------------------------------------------------------------------------------
+void SqlBudgetFileTest::incrementalStore_data()
+{
+	QTest::addColumn<QString>("edit");
+	QTest::addColumn<bool>("undo");
+
+	QStringList edits;
+	edits << "name" << "period" << "balance" << "estimate-amount"
+		<< "add-estimate" << "delete-estimate" << "move-estimate"
+		<< "add-rule" << "remove-rule" << "move-rule" << "add-condition"
+		<< "remove-condition";
+	for (int i=0; i<edits.size(); ++i)
+	{
+		QTest::newRow(qPrintable(edits.at(i))) << edits.at(i) << false;
+		QTest::newRow(qPrintable(edits.at(i) + "-undone"))
+			<< edits.at(i) << true;
+	}
+}
+
+//------------------------------------------------------------------------------
+void SqlBudgetFileTest::incrementalStore()
+{
+	QFETCH(QString, edit);
+	QFETCH(bool, undo);
+
+	QTemporaryDir dir;
+	QString fileName = dir.path() + "/budget.sqlite";
+	QSharedPointer<Budget> budget = createBudget();
+	QSharedPointer<Estimate> root = budget->estimates();
+
+	SqlBudgetFile file(fileName);
+	QVERIFY(file.store(budget));
+
+	QUndoCommand* cmd = 0;
+	if (edit == "name")
+	{
+		cmd = budget->changeName("Renamed Budget");
+	}
+	else if (edit == "period")
+	{
+		BudgetingPeriod::Parameters params;
+		params.type = BudgetingPeriod::CalendarYear;
+		params.param1 = 2015;
+		cmd = budget->budgetingPeriod()->update(params);
+	}
+	else if (edit == "balance")
+	{
+		cmd = budget->initialBalance()->updateContributor(1,
+			Balance::Contributor("Owe", Money(350, "USD"), false));
+	}
+	else if (edit == "estimate-amount")
+	{
+		cmd = root->find(21100)->changeAmount(Money(470, "USD"));
+	}
+	else if (edit == "add-estimate")
+	{
+		cmd = root->find(21000)->addChild();
+	}
+	else if (edit == "delete-estimate")
+	{
+		cmd = root->find(21000)->deleteEstimate();
+	}
+	else if (edit == "move-estimate")
+	{
+		cmd = root->find(22000)->moveTo(root.data(), 0);
+	}
+	else if (edit == "add-rule")
+	{
+		cmd = budget->rules()->addRule(21200);
+	}
+	else if (edit == "remove-rule")
+	{
+		cmd = budget->rules()->removeRule(101);
+	}
+	else if (edit == "move-rule")
+	{
+		cmd = budget->rules()->move(3, 0);
+	}
+	else if (edit == "add-condition")
+	{
+		cmd = budget->rules()->find(102)->addCondition();
+	}
+	else if (edit == "remove-condition")
+	{
+		cmd = budget->rules()->find(101)->removeCondition(0);
+	}
+	QVERIFY(cmd != 0);
+
+	cmd->redo();
+	QVERIFY(file.store(budget));
+	if (undo)
+	{
+		cmd->undo();
+		QVERIFY(file.store(budget));
+	}
+
+	SqlBudgetFile reopened(fileName);
+	QSharedPointer<Budget> retrieved = reopened.retrieve();
+	QVERIFY( ! retrieved.isNull());
+	QCOMPARE(toXml(retrieved), toXml(budget));
+
+	// Modifications to a retrieved budget are stored as well
+	cmd = retrieved->estimates()->find(11000)->changeName("Salary");
+	cmd->redo();
+	QVERIFY(reopened.store(retrieved));
+	QCOMPARE(toXml(SqlBudgetFile(fileName).retrieve()), toXml(retrieved));
+}
+
+}
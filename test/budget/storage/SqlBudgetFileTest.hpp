@@ -0,0 +1,63 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SQLBUDGETFILETEST_HPP
+#define SQLBUDGETFILETEST_HPP
+
+// Qt include(s)
+#include <QtTest/QtTest>
+
+namespace ub {
+
+/**
+ * Unit test for the SqlBudgetFile class.
+ */
+class SqlBudgetFileTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	/**
+	 * Tests storing and retrieving a full budget.
+	 */
+	void roundTrip();
+
+	/**
+	 * Tests storing and retrieving amounts too large to be exactly
+	 * represented as floating point values.
+	 */
+	void largeAmounts();
+
+	/**
+	 * Tests retrieving from files that are not budgets.
+	 */
+	void retrieveInvalidFile();
+
+	/**
+	 * Tests storing only the modifications to a previously stored budget.
+	 */
+	void incrementalStore();
+
+	/**
+	 * Test data for storing modifications.
+	 */
+	void incrementalStore_data();
+};
+
+}
+
+#endif //SQLBUDGETFILETEST_HPP
@@ -0,0 +1,189 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Qt include(s)
+#include <QtCore>
+
+// UnderBudget include(s)
+#include "BudgetFixture.hpp"
+#include "XmlBudgetFileTest.hpp"
+#include "budget/storage/XmlBudgetFile.hpp"
+#include "gzip/GZipFile.hpp"
+
+//------------------------------------------------------------------------------
+QTEST_MAIN(ub::XmlBudgetFileTest)
+
+namespace ub {
+
+//------------------------------------------------------------------------------
+static bool isGZip(const QString& fileName)
+{
+	QFile file(fileName);
+	file.open(QIODevice::ReadOnly);
+	return GZipFile::isGZip(file);
+}
+
+//------------------------------------------------------------------------------
+static QSharedPointer<Budget> createLargeBudget()
+{
+	// Add enough estimates to the full budget to be worth compressing
+	QSharedPointer<Budget> budget = createBudget();
+	Estimate* root = budget->estimates().data();
+	for (int p=0; p<10; ++p)
+	{
+		Estimate* parent = Estimate::create(root, 40000 + p,
+			QString("Parent %1").arg(p), "", Estimate::Expense, Money(),
+			-1, false);
+		for (int c=0; c<20; ++c)
+		{
+			Estimate::create(parent, 50000 + p * 100 + c,
+				QString("Child %1").arg(c), "child estimate", Estimate::Expense,
+				Money(25 + c, "USD"), c, false);
+		}
+	}
+	return budget;
+}
+
+//------------------------------------------------------------------------------
+void XmlBudgetFileTest::roundTrip_data()
+{
+	QTest::addColumn<QString>("name");
+	QTest::addColumn<bool>("enableCompression");
+	QTest::addColumn<bool>("compressed");
+
+	QTest::newRow("plain") << "budget.xml" << false << false;
+	QTest::newRow("gz-extension") << "budget.xml.gz" << false << true;
+	QTest::newRow("enabled") << "budget.budget" << true << true;
+}
+
+//------------------------------------------------------------------------------
+void XmlBudgetFileTest::roundTrip()
+{
+	QFETCH(QString, name);
+	QFETCH(bool, enableCompression);
+	QFETCH(bool, compressed);
+
+	QTemporaryDir dir;
+	QString fileName = dir.path() + "/" + name;
+	QSharedPointer<Budget> budget = createLargeBudget();
+
+	{
+		XmlBudgetFile file(fileName);
+		if (enableCompression)
+		{
+			file.setCompressed(true);
+		}
+		QCOMPARE(file.isCompressed(), compressed);
+		QVERIFY(file.store(budget));
+	}
+
+	QCOMPARE(isGZip(fileName), compressed);
+
+	// Compression is detected by content, regardless of file name
+	XmlBudgetFile file(fileName);
+	file.setCompressed( ! compressed);
+	QSharedPointer<Budget> retrieved = file.retrieve();
+	QVERIFY( ! retrieved.isNull());
+	QCOMPARE(file.error(), QString());
+	QCOMPARE(file.isCompressed(), compressed);
+	QCOMPARE(toXml(retrieved), toXml(budget));
+}
+
+//------------------------------------------------------------------------------
+void XmlBudgetFileTest::retainFormat()
+{
+	QTemporaryDir dir;
+	QString plainName = dir.path() + "/plain.budget";
+	QString compressedName = dir.path() + "/compressed.budget";
+	QSharedPointer<Budget> budget = createLargeBudget();
+
+	XmlBudgetFile plain(plainName);
+	QVERIFY(plain.store(budget));
+
+	XmlBudgetFile compressed(compressedName);
+	compressed.setCompressed(true);
+	QVERIFY(compressed.store(budget));
+
+	// Re-opened files are stored in the same format as they were read
+	XmlBudgetFile plainAgain(plainName);
+	plainAgain.setCompressed(true);
+	QVERIFY( ! plainAgain.retrieve().isNull());
+	QVERIFY(plainAgain.store(budget));
+	QCOMPARE(isGZip(plainName), false);
+
+	XmlBudgetFile compressedAgain(compressedName);
+	QVERIFY( ! compressedAgain.retrieve().isNull());
+	QVERIFY(compressedAgain.store(budget));
+	QCOMPARE(isGZip(compressedName), true);
+}
+
+//------------------------------------------------------------------------------
+void XmlBudgetFileTest::compressionLevel()
+{
+	QTemporaryDir dir;
+	QSharedPointer<Budget> budget = createLargeBudget();
+
+	XmlBudgetFile plain(dir.path() + "/plain.budget");
+	QVERIFY(plain.store(budget));
+
+	XmlBudgetFile fastest(dir.path() + "/fastest.budget");
+	fastest.setCompressed(true);
+	fastest.setCompressionLevel(1);
+	QVERIFY(fastest.store(budget));
+
+	XmlBudgetFile smallest(dir.path() + "/smallest.budget");
+	smallest.setCompressed(true);
+	smallest.setCompressionLevel(9);
+	QVERIFY(smallest.store(budget));
+
+	qint64 plainSize = QFileInfo(plain.location()).size();
+	qint64 fastestSize = QFileInfo(fastest.location()).size();
+	qint64 smallestSize = QFileInfo(smallest.location()).size();
+	QVERIFY(fastestSize < plainSize);
+	QVERIFY(smallestSize <= fastestSize);
+
+	// All levels are read back the same
+	QCOMPARE(toXml(XmlBudgetFile(smallest.location()).retrieve()), toXml(budget));
+	QCOMPARE(toXml(XmlBudgetFile(fastest.location()).retrieve()), toXml(budget));
+}
+
+//------------------------------------------------------------------------------
+void XmlBudgetFileTest::failedWrite_data()
+{
+	QTest::addColumn<bool>("compressed");
+
+	QTest::newRow("plain") << false;
+	QTest::newRow("compressed") << true;
+}
+
+//------------------------------------------------------------------------------
+void XmlBudgetFileTest::failedWrite()
+{
+	QFETCH(bool, compressed);
+
+	// Every write to this device fails as if the disk were full, while
+	// a small budget fits entirely in the write buffers until closed
+	if ( ! QFile::exists("/dev/full"))
+		QSKIP("No always-full device to write to");
+
+	QSharedPointer<Budget> budget(new Budget);
+	XmlBudgetFile file("/dev/full");
+	file.setCompressed(compressed);
+	QVERIFY( ! file.store(budget));
+	QVERIFY( ! file.error().isEmpty());
+}
+
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef XMLBUDGETFILETEST_HPP
+#define XMLBUDGETFILETEST_HPP
+
+// Qt include(s)
+#include <QtTest/QtTest>
+
+namespace ub {
+
+/**
+ * Unit test for the XmlBudgetFile class.
+ */
+class XmlBudgetFileTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	/**
+	 * Tests storing and retrieving a budget, with and without compression.
+	 */
+	void roundTrip();
+
+	/**
+	 * Test data for storing and retrieving a budget.
+	 */
+	void roundTrip_data();
+
+	/**
+	 * Tests that the format of an existing file is retained when the
+	 * budget is stored again.
+	 */
+	void retainFormat();
+
+	/**
+	 * Tests storing with different compression levels.
+	 */
+	void compressionLevel();
+
+	/**
+	 * Tests that a failure to write the end of the file is reported.
+	 */
+	void failedWrite();
+
+	/**
+	 * Test data for failing to write the end of the file.
+	 */
+	void failedWrite_data();
+};
+
+}
+
+#endif //XMLBUDGETFILETEST_HPP
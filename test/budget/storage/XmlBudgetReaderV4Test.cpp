@@ -385,5 +385,80 @@ void XmlBudgetReaderV4Test::readRuleConditions()
 	COMPARE_CONDITION(rule->conditionAt(0), field, oper, sensitive, value);
 }
 
+//------------------------------------------------------------------------------
+void XmlBudgetReaderV4Test::loadBenchmark_data()
+{
+	QTest::addColumn<int>("parents");
+
+	QTest::newRow("1k-estimates") << 10;
+	QTest::newRow("10k-estimates") << 100;
+
+	// Generating the large budget is too slow for every unit test run
+	if ( ! qgetenv("UNDERBUDGET_FILE_BENCHMARKS").isEmpty())
+	{
+		QTest::newRow("100k-estimates") << 1000;
+	}
+}
+
+//------------------------------------------------------------------------------
+void XmlBudgetReaderV4Test::loadBenchmark()
+{
+	QFETCH(int, parents);
+
+	// Each parent estimate has 99 child estimates
+	QByteArray xml("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>"
+		"<budget version=\"4.0\">\n"
+		" <name>Large Budget</name>\n"
+		" <period type=\"custom\">\n"
+		"  <start-date><day>1</day><month>6</month><year>2013</year></start-date>\n"
+		"  <end-date><day>1</day><month>7</month><year>2013</year></end-date>\n"
+		" </period>\n"
+		" <estimate id=\"0\" version=\"1.1\" uid=\"0\">\n"
+		"  <name>Root</name>\n"
+		"  <estimates>\n");
+	for (int p=0; p<parents; ++p)
+	{
+		xml += QString("   <estimate id=\"%1\" version=\"1.1\" uid=\"%1\">\n"
+			"    <name>Parent %1</name>\n"
+			"    <amount currency=\"USD\">0.00</amount>\n"
+			"    <type>CATEGORY</type>\n"
+			"    <complete>false</complete>\n"
+			"    <estimates>\n").arg(100000 + p).toUtf8();
+		for (int c=0; c<99; ++c)
+		{
+			xml += QString("     <estimate id=\"%1\" version=\"1.1\" uid=\"%1\">\n"
+				"      <name>Child %1</name>\n"
+				"      <amount currency=\"USD\">25.50</amount>\n"
+				"      <type>EXPENSE</type>\n"
+				"      <due-date><day>%2</day><month>6</month><year>2013</year></due-date>\n"
+				"      <complete>false</complete>\n"
+				"      <estimates/>\n"
+				"     </estimate>\n").arg(1000000 + p * 100 + c).arg(c % 28 + 1)
+				.toUtf8();
+		}
+		xml += "    </estimates>\n"
+			"   </estimate>\n";
+	}
+	xml += "  </estimates>\n </estimate>\n</budget>\n";
+
+	XmlBudgetReader reader;
+	QBENCHMARK
+	{
+		QBuffer buffer(&xml);
+		buffer.open(QBuffer::ReadOnly);
+		QVERIFY(reader.read(&buffer));
+	}
+
+	QSharedPointer<Estimate> root = reader.lastReadBudget()->estimates();
+	QCOMPARE(root->childCount(), parents);
+
+	Estimate* last = root->find(1000000 + (parents - 1) * 100 + 98);
+	QVERIFY(last != 0);
+	QCOMPARE(last->estimateName(),
+		QString("Child %1").arg(1000000 + (parents - 1) * 100 + 98));
+	QCOMPARE(last->estimatedAmount(), Money(25.50, "USD"));
+	QCOMPARE(last->activityDueDateOffset(), 98 % 28);
+}
+
 }
 
@@ -77,6 +77,18 @@ private slots:
 	 */
 	void readRuleConditions_data();
 
+	/**
+	 * Benchmarks reading of generated budgets of various sizes. The
+	 * largest budget is only read when the `UNDERBUDGET_FILE_BENCHMARKS`
+	 * environment variable is set.
+	 */
+	void loadBenchmark();
+
+	/**
+	 * Test data for benchmarking of budget reading.
+	 */
+	void loadBenchmark_data();
+
 private:
 	/** Well-formed version 4.0 XML budget */
 	QIODevice* fullBudget;
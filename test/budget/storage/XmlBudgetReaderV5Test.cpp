@@ -486,5 +486,68 @@ void XmlBudgetReaderV5Test::readRuleConditions()
 	}
 }
 
+//------------------------------------------------------------------------------
+void XmlBudgetReaderV5Test::loadBenchmark_data()
+{
+	QTest::addColumn<int>("parents");
+
+	QTest::newRow("1k-estimates") << 10;
+	QTest::newRow("10k-estimates") << 100;
+
+	// Generating the large budget is too slow for every unit test run
+	if ( ! qgetenv("UNDERBUDGET_FILE_BENCHMARKS").isEmpty())
+	{
+		QTest::newRow("100k-estimates") << 1000;
+	}
 }
 
+//------------------------------------------------------------------------------
+void XmlBudgetReaderV5Test::loadBenchmark()
+{
+	QFETCH(int, parents);
+
+	// Each parent estimate has 99 child estimates
+	QByteArray xml("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n"
+		"<ub:budget xmlns:ub=\"http://underbudget.vimofthevine.com/ub\""
+		"  xmlns:estimate=\"http://underbudget.vimofthevine.com/estimate\""
+		"  version=\"5.0\">\n"
+		" <ub:name>Large Budget</ub:name>\n"
+		" <estimate:estimate id=\"0\">\n");
+	for (int p=0; p<parents; ++p)
+	{
+		xml += QString("  <estimate:estimate id=\"%1\">\n"
+			"   <estimate:name>Parent %1</estimate:name>\n"
+			"   <estimate:type>expense</estimate:type>\n").arg(100000 + p).toUtf8();
+		for (int c=0; c<99; ++c)
+		{
+			xml += QString("   <estimate:estimate id=\"%1\">\n"
+				"    <estimate:name>Child %1</estimate:name>\n"
+				"    <estimate:amount currency=\"USD\">25.50</estimate:amount>\n"
+				"    <estimate:due-date-offset>%2</estimate:due-date-offset>\n"
+				"   </estimate:estimate>\n").arg(1000000 + p * 100 + c).arg(c % 28)
+				.toUtf8();
+		}
+		xml += "  </estimate:estimate>\n";
+	}
+	xml += " </estimate:estimate>\n</ub:budget>\n";
+
+	XmlBudgetReader reader;
+	QBENCHMARK
+	{
+		QBuffer buffer(&xml);
+		buffer.open(QBuffer::ReadOnly);
+		QVERIFY(reader.read(&buffer));
+	}
+
+	QSharedPointer<Estimate> root = reader.lastReadBudget()->estimates();
+	QCOMPARE(root->childCount(), parents);
+
+	Estimate* last = root->find(1000000 + (parents - 1) * 100 + 98);
+	QVERIFY(last != 0);
+	QCOMPARE(last->estimateName(),
+		QString("Child %1").arg(1000000 + (parents - 1) * 100 + 98));
+	QCOMPARE(last->estimatedAmount(), Money(25.50, "USD"));
+	QCOMPARE(last->activityDueDateOffset(), 98 % 28);
+}
+
+}
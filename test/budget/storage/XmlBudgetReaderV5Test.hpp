@@ -59,6 +59,18 @@ private slots:
 	 * Test data for reading of rule conditions.
 	 */
 	void readRuleConditions_data();
+
+	/**
+	 * Benchmarks reading of generated budgets of various sizes. The
+	 * largest budget is only read when the `UNDERBUDGET_FILE_BENCHMARKS`
+	 * environment variable is set.
+	 */
+	void loadBenchmark();
+
+	/**
+	 * Test data for benchmarking of budget reading.
+	 */
+	void loadBenchmark_data();
 };
 
 }
@@ -61,6 +61,11 @@ void AccountTest::fullName()
 	Account child(cName, QSharedPointer<Account>(parent));
 
 	QCOMPARE(child.fullName(delim), fullName);
+	QCOMPARE(child.foldedFullName(), child.fullName(":").toCaseFolded());
+
+	// Copies keep the full name built for the original
+	Account copy(child);
+	QCOMPARE(copy.fullName(delim), fullName);
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,224 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Qt include(s)
+#include <QtCore>
+
+// UnderBudget include(s)
+#include "ledger/Account.hpp"
+#include "ledger/TransactionStore.hpp"
+#include "TransactionStoreTest.hpp"
+
+//------------------------------------------------------------------------------
+QTEST_MAIN(ub::TransactionStoreTest)
+
+namespace ub {
+
+//------------------------------------------------------------------------------
+static QList<ImportedTransaction> createTransactions(int count)
+{
+	QSharedPointer<Account> root(new Account);
+	QSharedPointer<Account> assets(new Account("Assets", root));
+	QSharedPointer<Account> expenses(new Account("Expenses", root));
+	QList<QSharedPointer<Account> > accounts;
+	accounts << QSharedPointer<Account>(new Account("Checking", assets))
+		<< QSharedPointer<Account>(new Account("Savings", assets))
+		<< QSharedPointer<Account>(new Account("Food", expenses))
+		<< QSharedPointer<Account>(new Account("Rent", expenses))
+		<< QSharedPointer<Account>(new Account("Fuel", expenses));
+
+	QStringList payees;
+	payees << "Grocer" << "Landlord" << "Gas Station" << "Bank" << "grocer";
+
+	// Deterministic mix of values, with plenty of ties on every field
+	QList<ImportedTransaction> transactions;
+	QDate start(2014, 1, 1);
+	for (int i=0; i<count; ++i)
+	{
+		transactions << ImportedTransaction(1000 + i,
+			start.addDays((i * 7) % 31),
+			Money(((i * 13) % 17) - 8.25, "USD"),
+			payees.at((i * 3) % payees.size()),
+			QString("Memo %1").arg(i % 4),
+			accounts.at(i % 2), accounts.at(2 + (i % 3)));
+	}
+	return transactions;
+}
+
+//------------------------------------------------------------------------------
+static void compare(const ImportedTransaction& actual,
+	const ImportedTransaction& expected)
+{
+	QCOMPARE(actual.transactionId(), expected.transactionId());
+	QCOMPARE(actual.date(), expected.date());
+	QCOMPARE(actual.amount(), expected.amount());
+	QCOMPARE(actual.payee(), expected.payee());
+	QCOMPARE(actual.memo(), expected.memo());
+	QCOMPARE(actual.withdrawalAccount(), expected.withdrawalAccount());
+	QCOMPARE(actual.depositAccount(), expected.depositAccount());
+}
+
+//------------------------------------------------------------------------------
+void TransactionStoreTest::roundTrip()
+{
+	QList<ImportedTransaction> transactions = createTransactions(100);
+	TransactionStore store(transactions.mid(0, 60));
+	store.append(transactions.mid(60));
+	QCOMPARE(store.size(), transactions.size());
+
+	QList<ImportedTransaction> list = store.toList();
+	for (int i=0; i<transactions.size(); ++i)
+	{
+		compare(list.at(i), transactions.at(i));
+		QCOMPARE(store.payee(i), transactions.at(i).payee());
+		QCOMPARE(store.depositAccount(i), transactions.at(i).depositAccount());
+	}
+
+	store.clear();
+	QVERIFY(store.isEmpty());
+}
+
+//------------------------------------------------------------------------------
+void TransactionStoreTest::interning()
+{
+	TransactionStore store(createTransactions(100));
+
+	for (int i=0; i<store.size(); ++i)
+	{
+		for (int j=i+1; j<store.size(); ++j)
+		{
+			QCOMPARE(store.payeeId(i) == store.payeeId(j),
+				store.payee(i) == store.payee(j));
+			QCOMPARE(store.depositAccountId(i) == store.depositAccountId(j),
+				store.depositAccount(i) == store.depositAccount(j));
+		}
+
+		QCOMPARE(store.foldedString(store.payeeId(i)),
+			store.payee(i).toCaseFolded());
+	}
+
+	// Payees differing only by case are distinct, but fold the same
+	QVERIFY(store.payeeId(0) != store.payeeId(3));
+	QCOMPARE(store.foldedString(store.payeeId(0)),
+		store.foldedString(store.payeeId(3)));
+}
+
+//------------------------------------------------------------------------------
+void TransactionStoreTest::sortMatchesOperator()
+{
+	QList<ImportedTransaction> expected = createTransactions(500);
+	TransactionStore store(expected);
+	qSort(expected);
+	store.sort();
+
+	QCOMPARE(store.size(), expected.size());
+	for (int i=0; i<expected.size(); ++i)
+	{
+		ImportedTransaction actual = store.at(i);
+
+		// Ties are allowed in any order, as long as they are ties
+		QVERIFY( ! (actual < expected.at(i)));
+		QVERIFY( ! (expected.at(i) < actual));
+	}
+}
+
+//------------------------------------------------------------------------------
+void TransactionStoreTest::sortWithoutPackedKey()
+{
+	QList<ImportedTransaction> unique = createTransactions(5000);
+	QList<ImportedTransaction> expected;
+
+	// Unique payees, memos, dates and amounts need more than 64 bits
+	for (int i=0; i<unique.size(); ++i)
+	{
+		const ImportedTransaction& trn = unique.at(i);
+		expected << ImportedTransaction(trn.transactionId(),
+			trn.date().addDays((i * 7919) % 4096),
+			Money(trn.amount().amount() + i, "USD"),
+			QString("Payee %1").arg((i * 31) % 5000),
+			QString("Memo %1").arg((i * 17) % 5000),
+			QSharedPointer<Account>(new Account(trn.withdrawalAccount())),
+			QSharedPointer<Account>(new Account(trn.depositAccount())));
+	}
+
+	QList<ImportedTransaction> transactions = expected;
+	qSort(expected);
+	TransactionStore::sort(transactions);
+
+	QCOMPARE(transactions.size(), expected.size());
+	for (int i=0; i<expected.size(); ++i)
+	{
+		QVERIFY( ! (transactions.at(i) < expected.at(i)));
+		QVERIFY( ! (expected.at(i) < transactions.at(i)));
+	}
+}
+
+//------------------------------------------------------------------------------
+void TransactionStoreTest::sortList()
+{
+	QList<ImportedTransaction> expected = createTransactions(500);
+	QList<ImportedTransaction> transactions = expected;
+	qSort(expected);
+	TransactionStore::sort(transactions);
+
+	QCOMPARE(transactions.size(), expected.size());
+	for (int i=0; i<expected.size(); ++i)
+	{
+		QVERIFY( ! (transactions.at(i) < expected.at(i)));
+		QVERIFY( ! (expected.at(i) < transactions.at(i)));
+
+		// Equivalent transactions keep their original order
+		if (i > 0 && ! (transactions.at(i - 1) < transactions.at(i)))
+		{
+			QVERIFY(transactions.at(i - 1).transactionId()
+				< transactions.at(i).transactionId());
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+void TransactionStoreTest::scanBenchmark_data()
+{
+	QTest::addColumn<int>("count");
+
+	QTest::newRow("10k-transactions") << 10000;
+
+	// Creating the large store is too slow for every unit test run
+	if ( ! qgetenv("UNDERBUDGET_FILE_BENCHMARKS").isEmpty())
+	{
+		QTest::newRow("100k-transactions") << 100000;
+	}
+}
+
+//------------------------------------------------------------------------------
+void TransactionStoreTest::scanBenchmark()
+{
+	QFETCH(int, count);
+	TransactionStore store(createTransactions(count));
+	Money total;
+
+	QBENCHMARK {
+		total = Money(0.0, "USD");
+		for (int i=0; i<store.size(); ++i)
+		{
+			total += store.amount(i);
+		}
+	}
+
+	QVERIFY( ! total.isZero());
+}
+
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2015 Kyle Treubig
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRANSACTIONSTORETEST_HPP
+#define TRANSACTIONSTORETEST_HPP
+
+// Qt include(s)
+#include <QtTest/QtTest>
+
+namespace ub {
+
+/**
+ * Unit tests for the TransactionStore class.
+ */
+class TransactionStoreTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	/**
+	 * Tests that stored transactions are re-created unchanged.
+	 */
+	void roundTrip();
+
+	/**
+	 * Tests that repeated strings and accounts are interned.
+	 */
+	void interning();
+
+	/**
+	 * Tests that sorting produces the same order as the transaction
+	 * less-than operator.
+	 */
+	void sortMatchesOperator();
+
+	/**
+	 * Tests sorting transactions whose ranks do not fit in a packed key.
+	 */
+	void sortWithoutPackedKey();
+
+	/**
+	 * Tests sorting a list of transactions.
+	 */
+	void sortList();
+
+	/**
+	 * Benchmarks scanning the amounts of many stored transactions. The
+	 * largest store is only scanned when the `UNDERBUDGET_FILE_BENCHMARKS`
+	 * environment variable is set.
+	 */
+	void scanBenchmark();
+
+	/**
+	 * Test data for the scanning benchmark.
+	 */
+	void scanBenchmark_data();
+};
+
+}
+
+#endif //TRANSACTIONSTORETEST_HPP
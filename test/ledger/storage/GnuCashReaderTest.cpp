@@ -20,6 +20,7 @@
 // UnderBudget include(s)
 #include "GnuCashReaderTest.hpp"
 #include "gnucash_testdata.hpp"
+#include "gzip/GZipFile.hpp"
 #include "ledger/storage/GnuCashReader.hpp"
 
 //------------------------------------------------------------------------------
@@ -223,6 +224,349 @@ void GnuCashReaderTest::withDateFilters()
 	QCOMPARE(transaction.date(), end);
 }
 
+//------------------------------------------------------------------------------
+void GnuCashReaderTest::sortOrder()
+{
+	QBuffer buffer;
+	buffer.open(QBuffer::ReadWrite);
+	buffer.write((GnuCashTest::Header + GnuCashTest::FullAccountsList
+		+ GnuCashTest::AllTransactions + GnuCashTest::Footer).toUtf8());
+	buffer.seek(0);
+
+	GnuCashReader reader;
+	QList<ImportedTransaction> transactions;
+	QCOMPARE(reader.read(&buffer, transactions), true);
+
+	QList<ImportedTransaction> expected = transactions;
+	qSort(expected);
+
+	QCOMPARE(transactions.size(), expected.size());
+	for (int i=0; i<expected.size(); ++i)
+	{
+		QVERIFY( ! (transactions.at(i) < expected.at(i)));
+		QVERIFY( ! (expected.at(i) < transactions.at(i)));
+		if (i > 0)
+		{
+			QVERIFY( ! (transactions.at(i) < transactions.at(i - 1)));
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+void GnuCashReaderTest::cancellation()
+{
+	qRegisterMetaType<ImportedTransactionSource::Result>("ImportedTransactionSource::Result");
+	qRegisterMetaType<QList<ImportedTransaction> >("QList<ImportedTransaction>");
+
+	QBuffer buffer;
+	buffer.open(QBuffer::ReadWrite);
+	buffer.write((GnuCashTest::Header + GnuCashTest::FullAccountsList
+		+ GnuCashTest::AllTransactions + GnuCashTest::Footer).toUtf8());
+	buffer.seek(0);
+
+	// Cancel as soon as the import reports any progress
+	GnuCashReader reader;
+	connect(&reader, SIGNAL(progress(int)), &reader, SLOT(cancel()));
+	QSignalSpy finishedSpy(&reader,
+		SIGNAL(finished(ImportedTransactionSource::Result, QString)));
+	QSignalSpy importedSpy(&reader, SIGNAL(imported(QList<ImportedTransaction>)));
+
+	QList<ImportedTransaction> transactions;
+	QCOMPARE(reader.read(&buffer, transactions), false);
+	QCOMPARE(transactions.size(), 0);
+	QCOMPARE(importedSpy.count(), 0);
+	QCOMPARE(finishedSpy.count(), 1);
+	QCOMPARE(finishedSpy.at(0).at(0).value<ImportedTransactionSource::Result>(),
+		ImportedTransactionSource::Cancelled);
+
+	// A cancellation does not carry over to the next import
+	disconnect(&reader, SIGNAL(progress(int)), &reader, SLOT(cancel()));
+	buffer.seek(0);
+	QCOMPARE(reader.read(&buffer, transactions), true);
+	QVERIFY(transactions.size() > 0);
+
+	// A cancellation requested before the import starts is not lost
+	reader.cancel();
+	buffer.seek(0);
+	QCOMPARE(reader.read(&buffer, transactions), false);
+	QCOMPARE(finishedSpy.last().at(0).value<ImportedTransactionSource::Result>(),
+		ImportedTransactionSource::Cancelled);
+
+	// Unless it is withdrawn before the import is requested
+	reader.cancel();
+	reader.resetCancel();
+	buffer.seek(0);
+	QCOMPARE(reader.read(&buffer, transactions), true);
+}
+
+//------------------------------------------------------------------------------
+void GnuCashReaderTest::batches_data()
+{
+	QTest::addColumn<int>("size");
+
+	QTest::newRow("one-per-batch") << 1;
+	QTest::newRow("two-per-batch") << 2;
+	QTest::newRow("three-per-batch") << 3;
+	QTest::newRow("all-in-one-batch") << 1000;
+}
+
+//------------------------------------------------------------------------------
+void GnuCashReaderTest::batches()
+{
+	QFETCH(int, size);
+	qRegisterMetaType<QList<ImportedTransaction> >("QList<ImportedTransaction>");
+
+	QByteArray xml = (GnuCashTest::Header + GnuCashTest::FullAccountsList
+		+ GnuCashTest::AllTransactions + GnuCashTest::Footer).toUtf8();
+
+	// Read all transactions at once, for comparison
+	QBuffer buffer(&xml);
+	buffer.open(QBuffer::ReadOnly);
+	QList<ImportedTransaction> expected;
+	GnuCashReader reader;
+	QCOMPARE(reader.read(&buffer, expected), true);
+	buffer.close();
+
+	buffer.open(QBuffer::ReadOnly);
+	QSignalSpy batchSpy(&reader, SIGNAL(importedBatch(QList<ImportedTransaction>)));
+	QSignalSpy importedSpy(&reader, SIGNAL(imported(QList<ImportedTransaction>)));
+	QSignalSpy progressSpy(&reader, SIGNAL(progress(int)));
+	reader.setBatchSize(size);
+
+	// Transactions are only provided via the batches
+	QList<ImportedTransaction> transactions;
+	QCOMPARE(reader.read(&buffer, transactions), true);
+	QCOMPARE(transactions.size(), 0);
+	QCOMPARE(importedSpy.count(), 0);
+	QCOMPARE(batchSpy.count(), (expected.size() + size - 1) / size);
+
+	for (int i=0; i<batchSpy.count(); ++i)
+	{
+		const QList<ImportedTransaction>* batch =
+			static_cast<const QList<ImportedTransaction>*>(
+				batchSpy.at(i).at(0).constData());
+		QVERIFY(batch->size() <= size);
+		QVERIFY( ! batch->isEmpty());
+		transactions += *batch;
+	}
+
+	qSort(transactions);
+	QCOMPARE(transactions.size(), expected.size());
+	for (int i=0; i<expected.size(); ++i)
+	{
+		QCOMPARE(transactions.at(i).transactionId(),
+			expected.at(i).transactionId());
+		QCOMPARE(transactions.at(i).amount(), expected.at(i).amount());
+	}
+
+	// Progress is reported against the size of the device
+	QVERIFY(progressSpy.count() > 0);
+	QCOMPARE(progressSpy.last().at(0).toInt(), 100);
+}
+
+//------------------------------------------------------------------------------
+void GnuCashReaderTest::emptyBatches()
+{
+	qRegisterMetaType<ImportedTransactionSource::Result>("ImportedTransactionSource::Result");
+	qRegisterMetaType<QList<ImportedTransaction> >("QList<ImportedTransaction>");
+
+	QByteArray xml = (GnuCashTest::Header + GnuCashTest::FullAccountsList
+		+ GnuCashTest::AllTransactions + GnuCashTest::Footer).toUtf8();
+
+	QBuffer buffer(&xml);
+	buffer.open(QBuffer::ReadOnly);
+	GnuCashReader reader;
+	QSignalSpy finishedSpy(&reader,
+		SIGNAL(finished(ImportedTransactionSource::Result, QString)));
+	QSignalSpy batchSpy(&reader, SIGNAL(importedBatch(QList<ImportedTransaction>)));
+	reader.setBatchSize(2);
+
+	// No transactions are in range, but the book is still read successfully
+	QList<ImportedTransaction> transactions;
+	QCOMPARE(reader.read(&buffer, transactions,
+		QDate(2000,1,1), QDate(2000,1,31)), true);
+	QCOMPARE(finishedSpy.count(), 1);
+	QCOMPARE(finishedSpy.at(0).at(0).value<ImportedTransactionSource::Result>(),
+		ImportedTransactionSource::Complete);
+
+	// A single, empty batch replaces any previous results
+	QCOMPARE(batchSpy.count(), 1);
+	const QList<ImportedTransaction>* batch =
+		static_cast<const QList<ImportedTransaction>*>(
+			batchSpy.at(0).at(0).constData());
+	QVERIFY(batch->isEmpty());
+}
+
+//------------------------------------------------------------------------------
+void GnuCashReaderTest::guidFormats_data()
+{
+	QTest::addColumn<QString>("guid");
+
+	// Account GUID used by several of the test transactions
+	QTest::newRow("lower-case") << "a65c38cc7416d30a0c00af945ec61646";
+	QTest::newRow("upper-case") << "A65C38CC7416D30A0C00AF945EC61646";
+	QTest::newRow("with-dashes") << "a65c38cc-7416-d30a-0c00-af945ec61646";
+	QTest::newRow("not-hex") << "account-guid-that-is-not-hex-xyz";
+	QTest::newRow("all-zero") << "00000000000000000000000000000000";
+}
+
+//------------------------------------------------------------------------------
+void GnuCashReaderTest::guidFormats()
+{
+	QFETCH(QString, guid);
+
+	QString xml = GnuCashTest::Header + GnuCashTest::FullAccountsList
+		+ GnuCashTest::AllTransactions + GnuCashTest::Footer;
+
+	QBuffer buffer;
+	buffer.setData(xml.toUtf8());
+	buffer.open(QBuffer::ReadOnly);
+	QList<ImportedTransaction> expected;
+	GnuCashReader reader;
+	QCOMPARE(reader.read(&buffer, expected), true);
+	buffer.close();
+
+	// Replace the account GUID everywhere it is referenced
+	buffer.setData(xml.replace("a65c38cc7416d30a0c00af945ec61646", guid).toUtf8());
+	buffer.open(QBuffer::ReadOnly);
+	QList<ImportedTransaction> transactions;
+	bool success = reader.read(&buffer, transactions);
+	if ( ! success)
+		qDebug() << reader.errorString();
+	QCOMPARE(success, true);
+
+	QCOMPARE(transactions.size(), expected.size());
+	for (int i=0; i<expected.size(); ++i)
+	{
+		QCOMPARE(transactions.at(i).withdrawalAccount(),
+			expected.at(i).withdrawalAccount());
+		QCOMPARE(transactions.at(i).depositAccount(),
+			expected.at(i).depositAccount());
+		QCOMPARE(transactions.at(i).amount(), expected.at(i).amount());
+	}
+}
+
+//------------------------------------------------------------------------------
+static bool writeBook(const QString& fileName, const QByteArray& xml,
+	bool compressed)
+{
+	if (compressed)
+	{
+		GZipFile file(fileName);
+		return file.open(QIODevice::WriteOnly)
+			&& (file.write(xml) == xml.size());
+	}
+	else
+	{
+		QFile file(fileName);
+		return file.open(QIODevice::WriteOnly)
+			&& (file.write(xml) == xml.size());
+	}
+}
+
+//------------------------------------------------------------------------------
+void GnuCashReaderTest::fileFormats_data()
+{
+	QTest::addColumn<bool>("compressed");
+	QTest::addColumn<bool>("mapped");
+
+	QTest::newRow("uncompressed") << false << true;
+	QTest::newRow("uncompressed-buffered") << false << false;
+	QTest::newRow("gzip") << true << true;
+}
+
+//------------------------------------------------------------------------------
+void GnuCashReaderTest::fileFormats()
+{
+	QFETCH(bool, compressed);
+	QFETCH(bool, mapped);
+	qRegisterMetaType<ImportedTransactionSource::Result>("ImportedTransactionSource::Result");
+	qRegisterMetaType<QList<ImportedTransaction> >("QList<ImportedTransaction>");
+
+	QByteArray xml = (GnuCashTest::Header + GnuCashTest::FullAccountsList
+		+ GnuCashTest::AllTransactions + GnuCashTest::Footer).toUtf8();
+
+	QBuffer buffer(&xml);
+	buffer.open(QBuffer::ReadOnly);
+	QList<ImportedTransaction> expected;
+	GnuCashReader bufferReader;
+	QCOMPARE(bufferReader.read(&buffer, expected), true);
+
+	QTemporaryDir dir;
+	QString fileName = dir.path() + "/book.gnucash";
+	QVERIFY(writeBook(fileName, xml, compressed));
+
+	GnuCashReader reader(fileName);
+	reader.setMemoryMapping(mapped);
+	QSignalSpy finishedSpy(&reader,
+		SIGNAL(finished(ImportedTransactionSource::Result, QString)));
+	QSignalSpy importedSpy(&reader, SIGNAL(imported(QList<ImportedTransaction>)));
+	reader.import();
+
+	QCOMPARE(finishedSpy.count(), 1);
+	QCOMPARE(importedSpy.count(), 1);
+
+	const QList<ImportedTransaction>* transactions =
+		static_cast<const QList<ImportedTransaction>*>(
+			importedSpy.at(0).at(0).constData());
+	QCOMPARE(transactions->size(), expected.size());
+	for (int i=0; i<expected.size(); ++i)
+	{
+		QCOMPARE(transactions->at(i).transactionId(),
+			expected.at(i).transactionId());
+		QCOMPARE(transactions->at(i).memo(), expected.at(i).memo());
+		QCOMPARE(transactions->at(i).amount(), expected.at(i).amount());
+	}
+}
+
+//------------------------------------------------------------------------------
+void GnuCashReaderTest::fileBenchmark_data()
+{
+	QTest::addColumn<bool>("compressed");
+
+	QTest::newRow("uncompressed") << false;
+	QTest::newRow("gzip") << true;
+}
+
+//------------------------------------------------------------------------------
+void GnuCashReaderTest::fileBenchmark()
+{
+	// Writing the large book is too slow for every unit test run
+	if (qgetenv("UNDERBUDGET_FILE_BENCHMARKS").isEmpty())
+		QSKIP("Set UNDERBUDGET_FILE_BENCHMARKS to run the large file benchmark");
+
+	QFETCH(bool, compressed);
+	qRegisterMetaType<ImportedTransactionSource::Result>("ImportedTransactionSource::Result");
+
+	// Repeat the test transactions until the book is about 50 MB
+	QByteArray transactions = GnuCashTest::AllTransactions.toUtf8();
+	QByteArray xml = (GnuCashTest::Header + GnuCashTest::FullAccountsList).toUtf8();
+	int copies = (50 * 1024 * 1024) / transactions.size();
+	xml.reserve(xml.size() + transactions.size() * copies + 1024);
+	for (int i=0; i<copies; ++i)
+	{
+		xml += transactions;
+	}
+	xml += GnuCashTest::Footer.toUtf8();
+
+	QTemporaryDir dir;
+	QString fileName = dir.path() + "/book.gnucash";
+	QVERIFY(writeBook(fileName, xml, compressed));
+	xml.clear();
+
+	GnuCashReader reader(fileName);
+	QSignalSpy finishedSpy(&reader,
+		SIGNAL(finished(ImportedTransactionSource::Result, QString)));
+
+	QBENCHMARK_ONCE {
+		reader.import();
+	}
+
+	QCOMPARE(finishedSpy.count(), 1);
+	QCOMPARE(finishedSpy.at(0).at(0).value<ImportedTransactionSource::Result>(),
+		ImportedTransactionSource::Complete);
+}
+
 //------------------------------------------------------------------------------
 void GnuCashReaderTest::errors_data()
 {
@@ -50,6 +50,65 @@ private slots:
 	 */
 	void withDateFilters();
 
+	/**
+	 * Tests that imported transactions are sorted exactly as by the
+	 * transaction less-than operator.
+	 */
+	void sortOrder();
+
+	/**
+	 * Tests cancelling an import that is in progress.
+	 */
+	void cancellation();
+
+	/**
+	 * Tests importing transactions in batches.
+	 */
+	void batches();
+
+	/**
+	 * Test data for importing transactions in batches.
+	 */
+	void batches_data();
+
+	/**
+	 * Tests that a batched import of a book without any transactions
+	 * still emits a batch.
+	 */
+	void emptyBatches();
+
+	/**
+	 * Tests importing with different forms of GUIDs.
+	 */
+	void guidFormats();
+
+	/**
+	 * Test data for importing with different forms of GUIDs.
+	 */
+	void guidFormats_data();
+
+	/**
+	 * Tests importing from compressed and uncompressed files.
+	 */
+	void fileFormats();
+
+	/**
+	 * Test data for importing from compressed and uncompressed files.
+	 */
+	void fileFormats_data();
+
+	/**
+	 * Benchmarks importing from large compressed and uncompressed files.
+	 * This is only run when the `UNDERBUDGET_FILE_BENCHMARKS` environment
+	 * variable is set.
+	 */
+	void fileBenchmark();
+
+	/**
+	 * Test data for the file import benchmark.
+	 */
+	void fileBenchmark_data();
+
 	/**
 	 * Tests reading with errors in the XML.
 	 */